@@ -124,6 +124,10 @@ enum BlockStatus : uint32_t {
      * on a background chainstate. See `doc/design/assumeutxo.md`.
      */
     BLOCK_ASSUMED_VALID      =   256,
+
+    //! Script checks were skipped because the block is chainlocked (-skipchainlockedscripts),
+    //! they are pending the background script audit
+    BLOCK_SCRIPTS_UNVERIFIED =   512,
 };
 
 /** The block chain is a tree shaped structure starting with the
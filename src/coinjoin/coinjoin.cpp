@@ -119,7 +119,48 @@ void CCoinJoinBaseSession::SetNull()
 void CoinJoinQueueManager::SetNull()
 {
     LOCK(cs_vecqueue);
-    vecCoinJoinQueue.clear();
+    m_queues.clear();
+    m_queues_by_outpoint.clear();
+    m_queues_by_time.clear();
+    m_untried_queues.clear();
+}
+
+void CoinJoinQueueManager::AddQueueInternal(CCoinJoinQueue&& dsq)
+{
+    AssertLockHeld(cs_vecqueue);
+    const uint256 queueHash{dsq.GetHash()};
+    const auto [it, inserted] = m_queues.try_emplace(queueHash, std::move(dsq));
+    if (!inserted) return;
+    const auto& queue = it->second;
+    m_queues_by_outpoint.emplace(queue.masternodeOutpoint, queueHash);
+    m_queues_by_time.emplace(queue.nTime, queueHash);
+    if (!queue.fTried) {
+        m_untried_queues.emplace(queue.nTime, queueHash);
+    }
+}
+
+void CoinJoinQueueManager::EraseQueueInternal(const CCoinJoinQueue& dsq, const uint256& queueHash)
+{
+    AssertLockHeld(cs_vecqueue);
+    auto [begin, end] = m_queues_by_outpoint.equal_range(dsq.masternodeOutpoint);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == queueHash) {
+            m_queues_by_outpoint.erase(it);
+            break;
+        }
+    }
+    m_queues_by_time.erase({dsq.nTime, queueHash});
+    m_untried_queues.erase({dsq.nTime, queueHash});
+    m_queues.erase(queueHash);
+}
+
+bool CoinJoinQueueManager::HasQueueFromMasternodeInternal(const COutPoint& outpoint, std::optional<bool> fReady) const
+{
+    AssertLockHeld(cs_vecqueue);
+    auto [begin, end] = m_queues_by_outpoint.equal_range(outpoint);
+    return std::any_of(begin, end, [&](const auto& pair) {
+        return !fReady.has_value() || m_queues.at(pair.second).fReady == *fReady;
+    });
 }
 
 void CoinJoinQueueManager::CheckQueue()
@@ -127,41 +168,46 @@ void CoinJoinQueueManager::CheckQueue()
     TRY_LOCK(cs_vecqueue, lockDS);
     if (!lockDS) return; // it's ok to fail here, we run this quite frequently
 
-    // check mixing queue objects for timeouts
-    auto it = vecCoinJoinQueue.begin();
-    while (it != vecCoinJoinQueue.end()) {
-        if (it->IsTimeOutOfBounds()) {
-            LogPrint(BCLog::COINJOIN, "CoinJoinQueueManager::%s -- Removing a queue (%s)\n", __func__, it->ToString());
-            it = vecCoinJoinQueue.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // check mixing queue objects for timeouts, queues which are too old are at the front and
+    // queues which are too far into the future are at the back of the time index
+    const int64_t current_time{GetAdjustedTime()};
+    const auto remove_if_timed_out = [&](const std::pair<int64_t, uint256>& entry) {
+        const auto queue_hash{entry.second};
+        const auto it = m_queues.find(queue_hash);
+        assert(it != m_queues.end());
+        if (!it->second.IsTimeOutOfBounds(current_time)) return false;
+        LogPrint(BCLog::COINJOIN, "CoinJoinQueueManager::%s -- Removing a queue (%s)\n", __func__, it->second.ToString());
+        EraseQueueInternal(it->second, queue_hash);
+        return true;
+    };
+    while (!m_queues_by_time.empty() && remove_if_timed_out(*m_queues_by_time.begin())) {}
+    while (!m_queues_by_time.empty() && remove_if_timed_out(*m_queues_by_time.rbegin())) {}
 }
 
 std::optional<bool> CoinJoinQueueManager::TryHasQueueFromMasternode(const COutPoint& outpoint) const
 {
     TRY_LOCK(cs_vecqueue, lockDS);
     if (!lockDS) return std::nullopt;
-    return std::ranges::any_of(vecCoinJoinQueue, [&outpoint](const auto& q) { return q.masternodeOutpoint == outpoint; });
+    return HasQueueFromMasternodeInternal(outpoint, std::nullopt);
 }
 
 std::optional<bool> CoinJoinQueueManager::TryCheckDuplicate(const CCoinJoinQueue& dsq) const
 {
     TRY_LOCK(cs_vecqueue, lockDS);
     if (!lockDS) return std::nullopt;
-    for (const auto& q : vecCoinJoinQueue) {
-        if (q == dsq) return true;
-        if (q.fReady == dsq.fReady && q.masternodeOutpoint == dsq.masternodeOutpoint) return true;
-    }
-    return false;
+    // An exact duplicate shares the masternode outpoint, so looking at that masternode's queues covers both cases
+    auto [begin, end] = m_queues_by_outpoint.equal_range(dsq.masternodeOutpoint);
+    return std::any_of(begin, end, [&](const auto& pair) {
+        const auto& q = m_queues.at(pair.second);
+        return q == dsq || q.fReady == dsq.fReady;
+    });
 }
 
 bool CoinJoinQueueManager::TryAddQueue(CCoinJoinQueue dsq)
 {
     TRY_LOCK(cs_vecqueue, lockDS);
     if (!lockDS) return false;
-    vecCoinJoinQueue.push_back(std::move(dsq));
+    AddQueueInternal(std::move(dsq));
     return true;
 }
 
@@ -170,11 +216,18 @@ bool CoinJoinQueueManager::GetQueueItemAndTry(CCoinJoinQueue& dsqRet)
     TRY_LOCK(cs_vecqueue, lockDS);
     if (!lockDS) return false; // it's ok to fail here, we run this quite frequently
 
-    for (auto& dsq : vecCoinJoinQueue) {
+    const int64_t current_time{GetAdjustedTime()};
+    for (auto it = m_untried_queues.begin(); it != m_untried_queues.end(); ++it) {
+        auto& dsq = m_queues.at(it->second);
+        if (dsq.IsTimeOutOfBounds(current_time)) {
+            // everything after a queue from the future is from the future too
+            if (dsq.nTime > current_time) break;
+            continue;
+        }
         // only try each queue once
-        if (dsq.fTried || dsq.IsTimeOutOfBounds()) continue;
         dsq.fTried = true;
         dsqRet = dsq;
+        m_untried_queues.erase(it);
         return true;
     }
 
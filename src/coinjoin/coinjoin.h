@@ -13,14 +13,18 @@
 #include <netaddress.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <saltedhasher.h>
 #include <sync.h>
 #include <timedata.h>
+#include <util/hasher.h>
 #include <util/translation.h>
 #include <version.h>
 
 #include <atomic>
 #include <map>
 #include <optional>
+#include <set>
+#include <unordered_map>
 #include <utility>
 
 #include <univalue.h>
@@ -326,8 +330,19 @@ class CoinJoinQueueManager
 private:
     mutable Mutex cs_vecqueue;
 
-    // The current mixing sessions in progress on the network
-    std::vector<CCoinJoinQueue> vecCoinJoinQueue GUARDED_BY(cs_vecqueue);
+    // The current mixing sessions in progress on the network, indexed by queue hash
+    Uint256HashMap<CCoinJoinQueue> m_queues GUARDED_BY(cs_vecqueue);
+    // Queue hashes by masternode collateral, a masternode has at most one queue per readiness state
+    std::unordered_multimap<COutPoint, uint256, SaltedOutpointHasher> m_queues_by_outpoint GUARDED_BY(cs_vecqueue);
+    // Queue hashes ordered by queue time, timed-out queues are always at either end
+    std::set<std::pair<int64_t, uint256>> m_queues_by_time GUARDED_BY(cs_vecqueue);
+    // Subset of m_queues_by_time which was not handed out by GetQueueItemAndTry yet
+    std::set<std::pair<int64_t, uint256>> m_untried_queues GUARDED_BY(cs_vecqueue);
+
+    void AddQueueInternal(CCoinJoinQueue&& dsq) EXCLUSIVE_LOCKS_REQUIRED(cs_vecqueue);
+    void EraseQueueInternal(const CCoinJoinQueue& dsq, const uint256& queueHash) EXCLUSIVE_LOCKS_REQUIRED(cs_vecqueue);
+    bool HasQueueFromMasternodeInternal(const COutPoint& outpoint, std::optional<bool> fReady) const
+        EXCLUSIVE_LOCKS_REQUIRED(cs_vecqueue);
 
 public:
     void SetNull() EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue);
@@ -335,19 +350,21 @@ public:
     //! Remove timed-out queue entries. Call periodically (e.g. every second).
     void CheckQueue() EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue);
 
-    int GetQueueSize() const EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue) { LOCK(cs_vecqueue); return vecCoinJoinQueue.size(); }
+    int GetQueueSize() const EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue) { LOCK(cs_vecqueue); return m_queues.size(); }
+    //! Hand out the oldest queue which wasn't tried yet and is not timed out, marks it as tried.
     bool GetQueueItemAndTry(CCoinJoinQueue& dsqRet) EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue);
 
     bool HasQueue(const uint256& queueHash) EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue)
     {
         LOCK(cs_vecqueue);
-        return std::any_of(vecCoinJoinQueue.begin(), vecCoinJoinQueue.end(),
-                           [&queueHash](auto q) { return q.GetHash() == queueHash; });
+        return m_queues.count(queueHash) > 0;
     }
     std::optional<CCoinJoinQueue> GetQueueFromHash(const uint256& queueHash) EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue)
     {
         LOCK(cs_vecqueue);
-        return util::find_if_opt(vecCoinJoinQueue, [&queueHash](const auto& q) { return q.GetHash() == queueHash; });
+        const auto it = m_queues.find(queueHash);
+        if (it == m_queues.end()) return std::nullopt;
+        return it->second;
     }
 
     //! True if any queue entry matches the given masternode outpoint and readiness state.
@@ -355,8 +372,7 @@ public:
     bool HasQueueFromMasternode(const COutPoint& outpoint, bool fReady) const EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue)
     {
         LOCK(cs_vecqueue);
-        return std::any_of(vecCoinJoinQueue.begin(), vecCoinJoinQueue.end(),
-                           [&](const auto& q) { return q.masternodeOutpoint == outpoint && q.fReady == fReady; });
+        return HasQueueFromMasternodeInternal(outpoint, fReady);
     }
     //! TRY_LOCK variant: returns nullopt if lock can't be acquired; true if any queue entry has this
     //! outpoint (any readiness).
@@ -365,11 +381,11 @@ public:
     //! an exact duplicate or the masternode is sending too many dsqs with the same readiness.
     [[nodiscard]] std::optional<bool> TryCheckDuplicate(const CCoinJoinQueue& dsq) const EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue);
 
-    //! Append a queue entry (caller must have already checked for duplicates).
+    //! Add a queue entry (caller must have already checked for duplicates).
     void AddQueue(CCoinJoinQueue dsq) EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue)
     {
         LOCK(cs_vecqueue);
-        vecCoinJoinQueue.push_back(std::move(dsq));
+        AddQueueInternal(std::move(dsq));
     }
     //! TRY_LOCK variant of AddQueue: returns false if the lock cannot be acquired.
     bool TryAddQueue(CCoinJoinQueue dsq) EXCLUSIVE_LOCKS_REQUIRED(!cs_vecqueue);
@@ -131,7 +131,7 @@ void CCoinJoinServer::ProcessDSQUEUE(NodeId from, CDataStream& vRecv)
     CCoinJoinQueue dsq;
     vRecv >> dsq;
 
-    WITH_LOCK(cs_main, m_peer_manager->PeerEraseObjectRequest(from, CInv{MSG_DSQ, dsq.GetHash()}));
+    m_peer_manager->PeerEraseObjectRequest(from, CInv{MSG_DSQ, dsq.GetHash()});
 
     // Validate denomination first
     if (!CoinJoin::IsValidDenomination(dsq.nDenom)) {
@@ -251,6 +251,8 @@ void CCoinJoinServer::SetNull()
     AssertLockHeld(cs_coinjoin);
     // MN side
     vecSessionCollaterals.clear();
+    mapFinalTxInputs.clear();
+    nSignedInputs = 0;
 
     CCoinJoinBaseSession::SetNull();
     m_queueman.SetNull();
@@ -296,6 +298,16 @@ void CCoinJoinServer::CreateFinalTransaction()
     LogPrint(BCLog::COINJOIN, "CCoinJoinServer::CreateFinalTransaction -- FINALIZE TRANSACTIONS\n");
 
     LOCK(cs_coinjoin);
+    BuildFinalTransaction();
+
+    // request signatures from clients
+    SetState(POOL_STATE_SIGNING);
+    RelayFinalTransaction(CTransaction(finalMutableTransaction));
+}
+
+void CCoinJoinServer::BuildFinalTransaction()
+{
+    AssertLockHeld(cs_coinjoin);
 
     CMutableTransaction txNew;
 
@@ -313,12 +325,22 @@ void CCoinJoinServer::CreateFinalTransaction()
     sort(txNew.vout.begin(), txNew.vout.end(), CompareOutputBIP69());
 
     finalMutableTransaction = txNew;
-    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::CreateFinalTransaction -- finalMutableTransaction=%s", /* Continued */
-             txNew.ToString());
 
-    // request signatures from clients
-    SetState(POOL_STATE_SIGNING);
-    RelayFinalTransaction(CTransaction(finalMutableTransaction));
+    mapFinalTxInputs.clear();
+    for (size_t i = 0; i < finalMutableTransaction.vin.size(); ++i) {
+        mapFinalTxInputs.emplace(finalMutableTransaction.vin[i].prevout, FinalTxInput{i, 0});
+    }
+    for (size_t i = 0; i < vecEntries.size(); ++i) {
+        for (const auto& txdsin : vecEntries[i].vecTxDSIn) {
+            if (auto it = mapFinalTxInputs.find(txdsin.prevout); it != mapFinalTxInputs.end()) {
+                it->second.nEntryIndex = i;
+            }
+        }
+    }
+    nSignedInputs = 0;
+
+    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::BuildFinalTransaction -- finalMutableTransaction=%s", /* Continued */
+             txNew.ToString());
 }
 
 void CCoinJoinServer::CommitFinalTransaction()
@@ -525,40 +547,25 @@ void CCoinJoinServer::CheckForCompleteQueue()
 bool CCoinJoinServer::IsInputScriptSigValid(const CTxIn& txin) const
 {
     AssertLockHeld(cs_coinjoin);
-    CMutableTransaction txNew;
-    txNew.vin.clear();
-    txNew.vout.clear();
 
-    int nTxInIndex = -1;
-    CScript sigPubKey = CScript();
+    const auto it = mapFinalTxInputs.find(txin.prevout);
+    if (it == mapFinalTxInputs.end()) {
+        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- Failed to find matching input in pool, %s\n", txin.ToString());
+        return false;
+    }
 
-    {
-        int i = 0;
-        for (const auto &entry: vecEntries) {
-            for (const auto &txout: entry.vecTxOut) {
-                txNew.vout.push_back(txout);
-            }
-            for (const auto &txdsin: entry.vecTxDSIn) {
-                txNew.vin.push_back(txdsin);
+    const auto& [nTxInIndex, nEntryIndex] = it->second;
+    const auto& vecTxDSIn = vecEntries.at(nEntryIndex).vecTxDSIn;
+    const auto txdsin = std::ranges::find_if(vecTxDSIn, [&txin](const auto& in) { return in.prevout == txin.prevout; });
+    assert(txdsin != vecTxDSIn.end());
 
-                if (txdsin.prevout == txin.prevout) {
-                    nTxInIndex = i;
-                    sigPubKey = txdsin.prevPubKey;
-                }
-                i++;
-            }
-        }
-    }
-    if (nTxInIndex >= 0) { //might have to do this one input at a time?
-        txNew.vin[nTxInIndex].scriptSig = txin.scriptSig;
-        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- verifying scriptSig %s\n", ScriptToAsmStr(txin.scriptSig).substr(0, 24));
-        // TODO we're using amount=0 here but we should use the correct amount. This works because Dash ignores the amount while signing/verifying (only used in Bitcoin/Segwit)
-        if (!VerifyScript(txNew.vin[nTxInIndex].scriptSig, sigPubKey, SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_STRICTENC, MutableTransactionSignatureChecker(&txNew, nTxInIndex, 0, MissingDataBehavior::ASSERT_FAIL))) {
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- VerifyScript() failed on input %d\n", nTxInIndex);
-            return false;
-        }
-    } else {
-        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- Failed to find matching input in pool, %s\n", txin.ToString());
+    // Signatures commit to the final (BIP69 sorted) transaction, the other inputs' scriptSigs are not part of the
+    // signature hash so there is no need to copy the transaction to verify a single input.
+    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- verifying scriptSig %s\n", ScriptToAsmStr(txin.scriptSig).substr(0, 24));
+    // TODO we're using amount=0 here but we should use the correct amount. This works because Dash ignores the amount while signing/verifying (only used in Bitcoin/Segwit)
+    if (!VerifyScript(txin.scriptSig, txdsin->prevPubKey, SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_STRICTENC,
+                      MutableTransactionSignatureChecker(&finalMutableTransaction, nTxInIndex, 0, MissingDataBehavior::ASSERT_FAIL))) {
+        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- VerifyScript() failed on input %d\n", nTxInIndex);
         return false;
     }
 
@@ -649,17 +656,14 @@ bool CCoinJoinServer::AddScriptSig(const CTxIn& txinNew)
 
     LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- scriptSig=%s new\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
 
-    for (auto& txin : finalMutableTransaction.vin) {
-        if (txin.prevout == txinNew.prevout && txin.nSequence == txinNew.nSequence) {
-            txin.scriptSig = txinNew.scriptSig;
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- adding to finalMutableTransaction, scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
-        }
-    }
-    for (auto& entry : vecEntries) {
-        if (entry.AddScriptSig(txinNew)) {
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- adding to entries, scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
-            return true;
-        }
+    // IsInputScriptSigValid() succeeded, so the input is known
+    const auto& [nTxInIndex, nEntryIndex] = mapFinalTxInputs.at(txinNew.prevout);
+    if (vecEntries[nEntryIndex].AddScriptSig(txinNew)) {
+        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- adding to entries, scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
+        finalMutableTransaction.vin[nTxInIndex].scriptSig = txinNew.scriptSig;
+        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- adding to finalMutableTransaction, scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
+        ++nSignedInputs;
+        return true;
     }
 
     LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- Couldn't set sig!\n");
@@ -672,9 +676,8 @@ bool CCoinJoinServer::IsSignaturesComplete() const
     AssertLockNotHeld(cs_coinjoin);
     LOCK(cs_coinjoin);
 
-    return std::ranges::all_of(vecEntries, [](const auto& entry) {
-        return std::ranges::all_of(entry.vecTxDSIn, [](const auto& txdsin) { return txdsin.fHasSig; });
-    });
+    // every input of the final transaction is tracked in mapFinalTxInputs and counted once when signed
+    return nSignedInputs == finalMutableTransaction.vin.size();
 }
 
 bool CCoinJoinServer::IsAcceptableDSA(const CCoinJoinAccept& dsa, PoolMessage& nMessageIDRet) const
@@ -10,6 +10,9 @@
 #include <net_processing.h>
 #include <net_types.h>
 #include <protocol.h>
+#include <util/hasher.h>
+
+#include <unordered_map>
 
 class CActiveMasternodeManager;
 class CConnman;
@@ -23,10 +26,15 @@ class CTxMemPool;
 
 class UniValue;
 
+namespace coinjoin_server_tests {
+class TestCoinJoinServer;
+} // namespace coinjoin_server_tests
+
 /** Used to keep track of current status of mixing pool
  */
 class CCoinJoinServer : public CCoinJoinBaseSession, public NetHandler
 {
+friend class coinjoin_server_tests::TestCoinJoinServer; // for test access to the signing round
 private:
     CoinJoinQueueManager m_queueman;
 
@@ -44,6 +52,15 @@ private:
     // to behave honestly. If they don't it takes their money.
     std::vector<CTransactionRef> vecSessionCollaterals;
 
+    struct FinalTxInput {
+        size_t nTxIndex; // position in finalMutableTransaction.vin
+        size_t nEntryIndex; // position in vecEntries
+    };
+    // Built once per signing round so that incoming signatures can be checked
+    // against the final transaction without rebuilding it for every input
+    std::unordered_map<COutPoint, FinalTxInput, SaltedOutpointHasher> mapFinalTxInputs GUARDED_BY(cs_coinjoin);
+    size_t nSignedInputs GUARDED_BY(cs_coinjoin){0};
+
     bool fUnitTest;
 
     /// Add a clients entry to the pool
@@ -62,6 +79,8 @@ private:
     void CheckPool();
 
     void CreateFinalTransaction() EXCLUSIVE_LOCKS_REQUIRED(!cs_coinjoin);
+    /// Build finalMutableTransaction and the input lookup used to verify signatures for it
+    void BuildFinalTransaction() EXCLUSIVE_LOCKS_REQUIRED(cs_coinjoin);
     void CommitFinalTransaction() EXCLUSIVE_LOCKS_REQUIRED(!cs_coinjoin);
 
     /// Is this nDenom and txCollateral acceptable?
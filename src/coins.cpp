@@ -281,6 +281,29 @@ bool CCoinsViewCache::Sync()
     return fOk;
 }
 
+bool CCoinsViewCache::SyncAndUncache(int max_height)
+{
+    if (!Sync()) return false;
+    // All remaining coins are unmodified now, so they can be dropped without losing changes. Erasing
+    // them would not return their memory, the pool resource of cacheCoins only grows. So move the coins
+    // we keep out and rebuild the map in a fresh resource, like Flush() does.
+    std::vector<std::pair<COutPoint, Coin>> kept;
+    for (auto& [outpoint, entry] : cacheCoins) {
+        if (static_cast<int>(entry.coin.nHeight) > max_height) {
+            kept.emplace_back(outpoint, std::move(entry.coin));
+        }
+    }
+    cacheCoins.clear();
+    ReallocateCache();
+    cachedCoinsUsage = 0;
+    cacheCoins.reserve(kept.size());
+    for (auto& [outpoint, coin] : kept) {
+        cachedCoinsUsage += coin.DynamicMemoryUsage();
+        cacheCoins.try_emplace(outpoint, std::move(coin));
+    }
+    return true;
+}
+
 void CCoinsViewCache::Uncache(const COutPoint& hash)
 {
     CCoinsMap::iterator it = cacheCoins.find(hash);
@@ -318,6 +318,14 @@ public:
      */
     bool Sync();
 
+    /**
+     * Sync() and afterwards remove the coins created at or below max_height from this cache,
+     * retaining the coins of more recent blocks. The cache is reallocated with the retained
+     * coins only, so DynamicMemoryUsage() reflects what was freed.
+     * If false is returned, the state of this cache (and its backing view) will be undefined.
+     */
+    bool SyncAndUncache(int max_height);
+
     /**
      * Removes the UTXO with the given outpoint from the cache, if it is
      * not modified.
@@ -111,6 +111,17 @@ typedef char* sockopt_arg_type;
 #define USE_EPOLL
 #endif
 
+// io_uring needs multishot poll and timed waits (Linux 5.13+ headers). Only the version is checked here,
+// <linux/io_uring.h> drags in <linux/fs.h> and its macros (e.g. BLOCK_SIZE) and is left to util/edge.cpp.
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && __has_include(<linux/version.h>)
+#include <linux/version.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
+#define USE_IO_URING
+#endif
+#endif
+#endif
+
 #if defined(__FreeBSD__) || defined(__APPLE__)
 #define USE_KQUEUE
 #endif
@@ -11,6 +11,7 @@
 #include <governance/governance.h>
 #include <instantsend/instantsend.h>
 #include <masternode/sync.h>
+#include <net.h>
 #include <util/check.h>
 #include <validation.h>
 
@@ -33,6 +34,7 @@ void CDSNotificationInterface::InitializeCurrentBlockTip(const CBlockIndex* tip,
 {
     SynchronousUpdatedBlockTip(tip, nullptr, ibd);
     UpdatedBlockTip(tip, nullptr, ibd);
+    m_connman.SetMasternodeServices(Assert(m_dmnman)->GetListAtChainTip());
 }
 
 void CDSNotificationInterface::AcceptedBlockHeader(const CBlockIndex *pindexNew)
@@ -91,6 +93,7 @@ void CDSNotificationInterface::BlockDisconnected(const std::shared_ptr<const CBl
 void CDSNotificationInterface::NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff)
 {
     CMNAuth::NotifyMasternodeListChanged(undo, oldMNList, diff, m_connman);
+    m_connman.UpdateMasternodeServices(oldMNList, diff);
     if (m_govman.IsValid()) {
         m_govman.CheckAndRemove();
     }
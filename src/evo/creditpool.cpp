@@ -124,7 +124,8 @@ std::optional<CCreditPool> CCreditPoolManager::GetFromCache(const CBlockIndex& b
             return pool;
         }
     }
-    if (block_index.nHeight % DISK_SNAPSHOT_PERIOD == 0) {
+    // The base block of a UTXO snapshot is assumed-valid and has a disk snapshot too
+    if (block_index.nHeight % DISK_SNAPSHOT_PERIOD == 0 || WITH_LOCK(::cs_main, return block_index.IsAssumedValid())) {
         if (evoDb.Read(std::make_pair(DB_CREDITPOOL_SNAPSHOT, block_hash), pool)) {
             LOCK(cache_mutex);
             creditPoolCache.insert(block_hash, pool);
@@ -235,6 +236,12 @@ CCreditPool CCreditPoolManager::GetCreditPool(const CBlockIndex* block_index)
     return *poolTmp;
 }
 
+void CCreditPoolManager::AddSnapshotPool(const CBlockIndex& block_index, const CCreditPool& pool)
+{
+    evoDb.Write(std::make_pair(DB_CREDITPOOL_SNAPSHOT, block_index.GetBlockHash()), pool);
+    AddToCache(block_index.GetBlockHash(), block_index.nHeight, pool);
+}
+
 CCreditPoolManager::CCreditPoolManager(CEvoDB& _evoDb, const ChainstateManager& chainman) :
     evoDb{_evoDb},
     m_chainman{chainman}
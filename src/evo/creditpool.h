@@ -135,6 +135,12 @@ public:
       */
     CCreditPool GetCreditPool(const CBlockIndex* block) EXCLUSIVE_LOCKS_REQUIRED(!cache_mutex);
 
+    /**
+     * Store the credit pool at the base block of a UTXO snapshot. Blocks below it are not available
+     * until background validation downloads them, so the pool can't be constructed from them.
+     */
+    void AddSnapshotPool(const CBlockIndex& block_index, const CCreditPool& pool) EXCLUSIVE_LOCKS_REQUIRED(!cache_mutex);
+
 private:
     std::optional<CCreditPool> GetFromCache(const CBlockIndex& block_index) EXCLUSIVE_LOCKS_REQUIRED(!cache_mutex);
     void AddToCache(const uint256& block_hash, int height, const CCreditPool& pool) EXCLUSIVE_LOCKS_REQUIRED(!cache_mutex);
@@ -32,6 +32,7 @@ static const std::string DB_LIST_SNAPSHOT = "dmn_S3";
 static const std::string DB_LIST_DIFF = "dmn_D4";        // Bumped for nVersion-first format
 static const std::string DB_LIST_DIFF_LEGACY = "dmn_D3"; // Legacy format key
 static const std::string DB_LIST_REPAIRED = "dmn_R1";
+static const std::string DB_LIST_SNAPSHOT_HEIGHT = "dmn_U1"; // Height of the highest list loaded from a UTXO snapshot
 
 uint64_t CDeterministicMN::GetInternalId() const
 {
@@ -743,6 +744,40 @@ bool CDeterministicMNManager::UndoBlock(gsl::not_null<const CBlockIndex*> pindex
     return true;
 }
 
+bool CDeterministicMNManager::UndoBlocks(gsl::not_null<const CBlockIndex*> pindexTip,
+                                         gsl::not_null<const CBlockIndex*> pindexFork,
+                                         std::optional<MNListUpdates>& updatesRet)
+{
+    CDeterministicMNList curList;
+    CDeterministicMNList prevList;
+    {
+        LOCK(cs);
+        curList = GetListForBlockInternal(pindexTip);
+
+        for (const CBlockIndex* pindex = pindexTip; pindex != pindexFork; pindex = pindex->pprev) {
+            assert(pindex->pprev);
+            mnListsCache.erase(pindex->GetBlockHash());
+            mnListDiffsCache.erase(pindex->GetBlockHash());
+        }
+
+        // Don't unwind the diffs of the disconnected blocks one by one, the cost of
+        // this only depends on the distance of pindexFork to the previous snapshot
+        prevList = GetListForBlockInternal(pindexFork);
+    }
+
+    auto inversedDiff{curList.BuildDiff(prevList)};
+    if (inversedDiff.HasChanges()) {
+        updatesRet = {.old_list = curList, .new_list = prevList, .diff = inversedDiff};
+    }
+
+    const auto& consensusParams = Params().GetConsensus();
+    if (pindexFork->nHeight < consensusParams.DIP0003EnforcementHeight && pindexTip->nHeight >= consensusParams.DIP0003EnforcementHeight) {
+        LogPrintf("CDeterministicMNManager::%s -- DIP3 is not enforced anymore. nHeight=%d\n", __func__, pindexFork->nHeight + 1);
+    }
+
+    return true;
+}
+
 void CDeterministicMNManager::UpdatedBlockTip(gsl::not_null<const CBlockIndex*> pindex)
 {
     LOCK(cs);
@@ -785,6 +820,13 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlockInternal(gsl::not_n
 
         CDeterministicMNListDiff diff;
         if (!m_evoDb.Read(std::make_pair(DB_LIST_DIFF, pindex->GetBlockHash()), diff)) {
+            // Below a UTXO snapshot only the lists it carried are known until background validation processes
+            // the blocks before them, there is no initial snapshot to fall back to
+            if (int snapshot_height; DeploymentActiveAt(*pindex, Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0003) &&
+                                     m_evoDb.Read(DB_LIST_SNAPSHOT_HEIGHT, snapshot_height) && pindex->nHeight < snapshot_height) {
+                throw std::runtime_error(strprintf("%s: no masternode list for block %s at height %d below the UTXO snapshot at height %d",
+                                                   __func__, pindex->GetBlockHash().ToString(), pindex->nHeight, snapshot_height));
+            }
             // no snapshot and no diff on disk means that it's the initial snapshot
             m_initial_snapshot_index = pindex;
             snapshot = CDeterministicMNList(pindex->GetBlockHash(), pindex->nHeight, 0);
@@ -853,6 +895,18 @@ CDeterministicMNList CDeterministicMNManager::GetListAtChainTip()
     return GetListForBlockInternal(tipIndex);
 }
 
+void CDeterministicMNManager::AddSnapshotList(const CDeterministicMNList& mnList)
+{
+    LOCK(cs);
+    m_evoDb.Write(std::make_pair(DB_LIST_SNAPSHOT, mnList.GetBlockHash()), mnList);
+    mnListsCache.emplace(mnList.GetBlockHash(), mnList);
+    if (int snapshot_height{-1}; !m_evoDb.Read(DB_LIST_SNAPSHOT_HEIGHT, snapshot_height) || snapshot_height < mnList.GetHeight()) {
+        m_evoDb.Write(DB_LIST_SNAPSHOT_HEIGHT, mnList.GetHeight());
+    }
+    LogPrintf("CDeterministicMNManager::%s -- Wrote snapshot. nHeight=%d, mapCurMNs.allMNsCount=%d\n",
+        __func__, mnList.GetHeight(), mnList.GetCounts().total());
+}
+
 bool CDeterministicMNManager::IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n)
 {
     if (!tx->IsSpecialTxVersion() || tx->nType != TRANSACTION_PROVIDER_REGISTER) {
@@ -711,6 +711,9 @@ public:
                       const CDeterministicMNList& newList, std::optional<MNListUpdates>& updatesRet)
         EXCLUSIVE_LOCKS_REQUIRED(!cs, ::cs_main);
     bool UndoBlock(gsl::not_null<const CBlockIndex*> pindex, std::optional<MNListUpdates>& updatesRet) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    // Undo all blocks above pindexFork at once, the list at pindexFork is built from the nearest snapshot below it
+    bool UndoBlocks(gsl::not_null<const CBlockIndex*> pindexTip, gsl::not_null<const CBlockIndex*> pindexFork,
+                    std::optional<MNListUpdates>& updatesRet) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     void UpdatedBlockTip(gsl::not_null<const CBlockIndex*> pindex) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
@@ -719,6 +722,9 @@ public:
         return GetListForBlockInternal(pindex);
     };
     CDeterministicMNList GetListAtChainTip() EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    // Store a list carried by a UTXO snapshot, lists of later blocks are built on top of the one at its base block.
+    // Below that block, GetListForBlock() throws for the blocks not processed yet that no carried list is known for.
+    void AddSnapshotList(const CDeterministicMNList& mnList) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     // Test if given TX is a ProRegTx which also contains the collateral at index n
     static bool IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n);
@@ -0,0 +1,146 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <evo/evosnapshot.h>
+
+#include <chain.h>
+#include <chainparams.h>
+#include <consensus/merkle.h>
+#include <consensus/validation.h>
+#include <deploymentstatus.h>
+#include <evo/cbtx.h>
+#include <evo/simplifiedmns.h>
+#include <evo/specialtx.h>
+#include <hash.h>
+#include <primitives/block.h>
+#include <tinyformat.h>
+
+#include <algorithm>
+
+void CEvoSnapshotMNList::SetBlock(const CBlock& block)
+{
+    assert(!block.vtx.empty());
+    m_coinbase = block.vtx[0];
+    m_coinbase_branch.clear();
+
+    std::vector<uint256> hashes;
+    hashes.reserve(block.vtx.size());
+    for (const auto& tx : block.vtx) {
+        hashes.emplace_back(tx->GetHash());
+    }
+    // The coinbase is always the leftmost leaf, so its sibling on every level is the second hash
+    while (hashes.size() > 1) {
+        m_coinbase_branch.emplace_back(hashes[1]);
+        if (hashes.size() & 1) {
+            hashes.emplace_back(hashes.back());
+        }
+        for (size_t i = 0; i < hashes.size() / 2; ++i) {
+            hashes[i] = Hash(hashes[2 * i], hashes[2 * i + 1]);
+        }
+        hashes.resize(hashes.size() / 2);
+    }
+}
+
+bool CEvoSnapshotMNList::Verify(const CBlockIndex& index, std::string& error) const
+{
+    if (!m_coinbase || !m_coinbase->IsCoinBase()) {
+        error = "missing coinbase";
+        return false;
+    }
+    uint256 merkle_root{m_coinbase->GetHash()};
+    for (const auto& hash : m_coinbase_branch) {
+        merkle_root = Hash(merkle_root, hash);
+    }
+    if (merkle_root != index.hashMerkleRoot) {
+        error = "coinbase is not part of the block";
+        return false;
+    }
+
+    if (!DeploymentActiveAt(index, Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0003)) {
+        if (m_mn_list.GetCounts().total() != 0) {
+            error = "masternode list before DIP0003 activation";
+            return false;
+        }
+        return true;
+    }
+
+    const auto opt_cbTx = GetTxPayload<CCbTx>(*m_coinbase);
+    if (!opt_cbTx || opt_cbTx->nHeight != index.nHeight) {
+        error = "bad CbTx payload";
+        return false;
+    }
+
+    if (m_mn_list.GetBlockHash() != index.GetBlockHash() || m_mn_list.GetHeight() != index.nHeight) {
+        error = "masternode list is not at the block";
+        return false;
+    }
+    BlockValidationState state;
+    uint256 merkle_root_mnlist;
+    if (!CalcCbTxMerkleRootMNList(merkle_root_mnlist, m_mn_list.to_sml(), state) ||
+        merkle_root_mnlist != opt_cbTx->merkleRootMNList) {
+        error = "masternode list does not match merkleRootMNList";
+        return false;
+    }
+
+    return true;
+}
+
+bool CEvoSnapshot::Verify(const CBlockIndex& base, std::string& error) const
+{
+    if (!m_base.Verify(base, error)) {
+        return false;
+    }
+
+    if (!DeploymentActiveAt(base, Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0003)) {
+        if (!m_quorum_mn_lists.empty() || !m_commitments.empty() || !m_quorum_snapshots.empty() || m_credit_pool.locked != 0) {
+            error = "evo state before DIP0003 activation";
+            return false;
+        }
+        return true;
+    }
+
+    int prev_height{-1};
+    for (const auto& mn_list : m_quorum_mn_lists) {
+        const int height{mn_list.m_mn_list.GetHeight()};
+        const CBlockIndex* pindex = height > prev_height && height < base.nHeight ? base.GetAncestor(height) : nullptr;
+        if (pindex == nullptr || pindex->GetBlockHash() != mn_list.m_mn_list.GetBlockHash()) {
+            error = "quorum masternode lists are not ordered blocks below the base block";
+            return false;
+        }
+        if (std::string list_error; !mn_list.Verify(*pindex, list_error)) {
+            error = strprintf("quorum %s at height %d", list_error, height);
+            return false;
+        }
+        prev_height = height;
+    }
+
+    // Checked by m_base.Verify()
+    const auto opt_cbTx = GetTxPayload<CCbTx>(*m_base.m_coinbase);
+    assert(opt_cbTx);
+
+    if (opt_cbTx->nVersion >= CCbTx::Version::MERKLE_ROOT_QUORUMS) {
+        std::vector<uint256> qc_hashes;
+        qc_hashes.reserve(m_commitments.size());
+        for (const auto& [qc, _] : m_commitments) {
+            qc_hashes.emplace_back(::SerializeHash(qc));
+        }
+        std::sort(qc_hashes.begin(), qc_hashes.end());
+        bool mutated{false};
+        if (ComputeMerkleRoot(std::move(qc_hashes), &mutated) != opt_cbTx->merkleRootQuorums || mutated) {
+            error = "quorum commitments do not match merkleRootQuorums";
+            return false;
+        }
+    } else if (!m_commitments.empty()) {
+        error = "quorum commitments are not committed to by the CbTx";
+        return false;
+    }
+
+    const CAmount credit_pool_balance{opt_cbTx->nVersion >= CCbTx::Version::CLSIG_AND_BALANCE ? opt_cbTx->creditPoolBalance : 0};
+    if (m_credit_pool.locked != credit_pool_balance) {
+        error = "credit pool does not match creditPoolBalance";
+        return false;
+    }
+
+    return true;
+}
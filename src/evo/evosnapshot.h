@@ -0,0 +1,84 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_EVO_EVOSNAPSHOT_H
+#define BITCOIN_EVO_EVOSNAPSHOT_H
+
+#include <evo/creditpool.h>
+#include <evo/deterministicmns.h>
+#include <llmq/commitment.h>
+#include <llmq/params.h>
+#include <llmq/snapshot.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
+#include <uint256.h>
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+class CBlock;
+class CBlockIndex;
+
+/**
+ * Masternode list at a block of the chain of a UTXO snapshot. Only the headers of that chain are known
+ * when a snapshot is loaded, so the coinbase of the block is included together with its merkle branch,
+ * and the list is checked against the merkleRootMNList committed to by that CCbTx.
+ */
+class CEvoSnapshotMNList
+{
+public:
+    CTransactionRef m_coinbase;
+    std::vector<uint256> m_coinbase_branch;
+    CDeterministicMNList m_mn_list;
+
+    SERIALIZE_METHODS(CEvoSnapshotMNList, obj)
+    {
+        READWRITE(obj.m_coinbase, obj.m_coinbase_branch, obj.m_mn_list);
+    }
+
+    /** Set the coinbase and its merkle branch from the block the list is at */
+    void SetBlock(const CBlock& block);
+
+    /** Check the coinbase against the header of the block and the list against its CCbTx */
+    [[nodiscard]] bool Verify(const CBlockIndex& index, std::string& error) const;
+};
+
+/**
+ * Evo state at the base block of a UTXO snapshot, written after the coins of the snapshot.
+ *
+ * It carries the deterministic masternode list, the mined commitments of the active quorums
+ * and the credit pool, so a node loading the snapshot doesn't need to process every block since
+ * DIP3 activation before masternode lists and quorums are usable. The members of the active
+ * quorums are computed from masternode lists below the base block, so these lists are carried
+ * too, together with the quorum snapshots of rotated quorums. The state is checked against the
+ * merkle roots and the credit pool balance committed to by the CCbTx of the base block.
+ */
+class CEvoSnapshot
+{
+public:
+    CEvoSnapshotMNList m_base;
+    //! Lists at the base and work blocks of the active quorums and, for rotated quorums, at the work
+    //! blocks of the cycles their members are derived from, ordered by height
+    std::vector<CEvoSnapshotMNList> m_quorum_mn_lists;
+    //! Mined commitments of the active quorums, with the hash of the block each one was mined in
+    std::vector<std::pair<llmq::CFinalCommitment, uint256>> m_commitments;
+    //! Quorum snapshots of the rotation cycles the members of the active quorums are derived from, with
+    //! the hash of the first block of each cycle. They are not committed to by any block and taken as is.
+    std::vector<std::tuple<Consensus::LLMQType, uint256, llmq::CQuorumSnapshot>> m_quorum_snapshots;
+    //! Only `locked` is committed to by the CCbTx, the unlock limits and indexes are taken as is
+    //! until background validation recomputes them
+    CCreditPool m_credit_pool;
+
+    SERIALIZE_METHODS(CEvoSnapshot, obj)
+    {
+        READWRITE(obj.m_base, obj.m_quorum_mn_lists, obj.m_commitments, obj.m_quorum_snapshots, obj.m_credit_pool);
+    }
+
+    /** Check the base block state against its CbTx and the quorum lists against the CbTx of their blocks */
+    [[nodiscard]] bool Verify(const CBlockIndex& base, std::string& error) const;
+};
+
+#endif // BITCOIN_EVO_EVOSNAPSHOT_H
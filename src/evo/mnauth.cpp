@@ -48,12 +48,10 @@ void CMNAuth::PushMNAUTH(CNode& peer, CConnman& connman, const CActiveMasternode
     connman.PushMessage(&peer, CNetMsgMaker(peer.GetCommonVersion()).Make(NetMsgType::MNAUTH, mnauth));
 }
 
-MessageProcessingResult CMNAuth::ProcessMessage(CNode& peer, ServiceFlags node_services, CConnman& connman, CMasternodeMetaMan& mn_metaman,
-                                                const CActiveMasternodeManager* const mn_activeman, const CMasternodeSync& mn_sync,
-                                                const CDeterministicMNList& tip_mn_list, std::string_view msg_type, CDataStream& vRecv)
+MessageProcessingResult CMNAuth::ProcessMessage(CNode& peer, ServiceFlags node_services, const CMasternodeSync& mn_sync,
+                                                const CDeterministicMNList& tip_mn_list, std::string_view msg_type, CDataStream& vRecv,
+                                                std::optional<Pending>& pending)
 {
-    assert(mn_metaman.IsValid());
-
     if (msg_type != NetMsgType::MNAUTH || !mn_sync.IsBlockchainSynced()) {
         // we can't verify MNAUTH messages when we don't have the latest MN list
         return {};
@@ -95,12 +93,28 @@ MessageProcessingResult CMNAuth::ProcessMessage(CNode& peer, ServiceFlags node_s
     const uint256 signHash{::SerializeHash(std::make_tuple(pubKey, peer.GetSentMNAuthChallenge(), !peer.IsInboundConn(), peer.nVersion.load()))};
     LogPrint(BCLog::NET_NETCONN, "CMNAuth::%s -- constructed signHash for nVersion %d, peer=%d\n", __func__, peer.nVersion, peer.GetId());
 
-    if (!mnauth.sig.VerifyInsecure(dmn->pdmnState->pubKeyOperator.Get(), signHash, false)) {
+    pending = Pending{mnauth.proRegTxHash, pubKey, dmn->pdmnState->pubKeyOperator.GetHash(), signHash, mnauth.sig};
+    return {};
+}
+
+MessageProcessingResult CMNAuth::ProcessVerified(CNode& peer, CConnman& connman, CMasternodeMetaMan& mn_metaman,
+                                                 const CActiveMasternodeManager* const mn_activeman,
+                                                 const CDeterministicMNList& tip_mn_list, const Pending& mnauth, bool valid)
+{
+    assert(mn_metaman.IsValid());
+
+    if (!valid) {
         // Same as above, MN seems to not know its fate yet, so give it a chance to update. If this is a
         // malicious node (DoSing us), it'll get banned soon.
         return MisbehavingError{10, "mnauth signature verification failed"};
     }
 
+    // The MN list might have moved on while the signature was verified, make sure the key is still the current one
+    const auto dmn = tip_mn_list.GetMN(mnauth.proRegTxHash);
+    if (!dmn || dmn->pdmnState->pubKeyOperator.GetHash() != mnauth.pubKeyOperatorHash) {
+        return MisbehavingError{10, "missing mnauth masternode"};
+    }
+
     if (!peer.IsInboundConn()) {
         mn_metaman.SetLastOutboundSuccess(mnauth.proRegTxHash, GetTime<std::chrono::seconds>().count());
         if (peer.m_masternode_probe_connection) {
@@ -156,7 +170,7 @@ MessageProcessingResult CMNAuth::ProcessMessage(CNode& peer, ServiceFlags node_s
     }
 
     peer.SetVerifiedProRegTxHash(mnauth.proRegTxHash);
-    peer.SetVerifiedPubKeyHash(dmn->pdmnState->pubKeyOperator.GetHash());
+    peer.SetVerifiedPubKeyHash(mnauth.pubKeyOperatorHash);
 
     if (!peer.m_masternode_iqr_connection && connman.IsMasternodeQuorumRelayMember(peer.GetVerifiedProRegTxHash())) {
         // Tell our peer that we're interested in plain LLMQ recovered signatures.
@@ -12,6 +12,7 @@
 #include <serialize.h>
 #include <uint256.h>
 
+#include <optional>
 #include <string_view>
 
 class CActiveMasternodeManager;
@@ -54,15 +55,33 @@ public:
         READWRITE(obj.proRegTxHash, obj.sig);
     }
 
+    /** An MNAUTH which passed all checks except for the verification of its signature */
+    struct Pending {
+        uint256 proRegTxHash;
+        CBLSPublicKey pubKeyOperator;
+        uint256 pubKeyOperatorHash;
+        uint256 signHash;
+        CBLSSignature sig;
+    };
+
     static void PushMNAUTH(CNode& peer, CConnman& connman, const CActiveMasternodeManager& mn_activeman);
 
     /**
+     * Checks an MNAUTH message. The signature is not verified here so that the MNAUTHs of many peers can be
+     * batch-verified, instead pending is set and the caller has to pass the result to ProcessVerified.
+     */
+    [[nodiscard]] static MessageProcessingResult ProcessMessage(CNode& peer, ServiceFlags node_services, const CMasternodeSync& mn_sync,
+                                                                const CDeterministicMNList& tip_mn_list, std::string_view msg_type, CDataStream& vRecv,
+                                                                std::optional<Pending>& pending);
+    /**
+     * Completes the authentication of a peer once the signature of its MNAUTH was verified.
+     *
      * @pre CMasternodeMetaMan's database must be successfully loaded before
      *      attempting to call this function regardless of sync state
      */
-    [[nodiscard]] static MessageProcessingResult ProcessMessage(CNode& peer, ServiceFlags node_services, CConnman& connman, CMasternodeMetaMan& mn_metaman,
-                                                                const CActiveMasternodeManager* const mn_activeman, const CMasternodeSync& mn_sync,
-                                                                const CDeterministicMNList& tip_mn_list, std::string_view msg_type, CDataStream& vRecv);
+    [[nodiscard]] static MessageProcessingResult ProcessVerified(CNode& peer, CConnman& connman, CMasternodeMetaMan& mn_metaman,
+                                                                 const CActiveMasternodeManager* const mn_activeman,
+                                                                 const CDeterministicMNList& tip_mn_list, const Pending& mnauth, bool valid);
     static void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff, CConnman& connman);
 };
 
@@ -11,12 +11,15 @@
 #include <evo/cbtx.h>
 #include <evo/creditpool.h>
 #include <evo/deterministicmns.h>
+#include <evo/evosnapshot.h>
 #include <evo/mnhftx.h>
 #include <evo/netinfo.h>
 #include <evo/simplifiedmns.h>
 #include <llmq/blockprocessor.h>
 #include <llmq/commitment.h>
+#include <llmq/options.h>
 #include <llmq/quorumsman.h>
+#include <llmq/snapshot.h>
 #include <llmq/utils.h>
 #include <messagesigner.h>
 #include <util/helpers.h>
@@ -26,10 +29,16 @@
 #include <consensus/validation.h>
 #include <deploymentstatus.h>
 #include <hash.h>
+#include <node/blockstorage.h>
 #include <primitives/block.h>
 #include <util/system.h>
 #include <validation.h>
 
+#include <map>
+#include <set>
+
+using node::ReadBlockFromDisk;
+
 static bool AddNetInfoEntries(const std::shared_ptr<NetInfoInterface>& net_info, NetInfoPurpose purpose,
                               const NetInfoList& entries, BlockValidationState& state)
 {
@@ -803,7 +812,8 @@ bool CSpecialTxProcessor::ProcessSpecialTxsInBlock(const CBlock& block, const CB
     return true;
 }
 
-bool CSpecialTxProcessor::UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, std::optional<MNListUpdates>& updatesRet)
+bool CSpecialTxProcessor::UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, std::optional<MNListUpdates>& updatesRet,
+                                                bool fUndoMNList)
 {
     AssertLockHeld(::cs_main);
 
@@ -821,7 +831,7 @@ bool CSpecialTxProcessor::UndoSpecialTxsInBlock(const CBlock& block, const CBloc
             return false;
         }
 
-        if (!m_dmnman.UndoBlock(pindex, updatesRet)) {
+        if (fUndoMNList && !m_dmnman.UndoBlock(pindex, updatesRet)) {
             return false;
         }
 
@@ -837,6 +847,156 @@ bool CSpecialTxProcessor::UndoSpecialTxsInBlock(const CBlock& block, const CBloc
     return true;
 }
 
+bool CSpecialTxProcessor::UndoMNListInBlocks(gsl::not_null<const CBlockIndex*> pindexTip,
+                                             gsl::not_null<const CBlockIndex*> pindexFork,
+                                             std::optional<MNListUpdates>& updatesRet)
+{
+    AssertLockHeld(::cs_main);
+
+    try {
+        return m_dmnman.UndoBlocks(pindexTip, pindexFork, updatesRet);
+    } catch (const std::exception& e) {
+        return error(strprintf("CSpecialTxProcessor::%s -- FAILURE! %s\n", __func__, e.what()).c_str());
+    }
+}
+
+bool CSpecialTxProcessor::CreateEvoSnapshot(const CBlock& block, gsl::not_null<const CBlockIndex*> pindex,
+                                            CEvoSnapshot& snapshotRet)
+{
+    AssertLockHeld(::cs_main);
+
+    snapshotRet.m_base.SetBlock(block);
+    snapshotRet.m_base.m_mn_list = m_dmnman.GetListForBlock(pindex);
+
+    // The members of a quorum are computed from the list at its work block, the members of a rotated quorum
+    // also from the members of the previous cycles (see PreviousQuorumQuarters), which are derived from the
+    // quorum snapshots and work block lists of those cycles. All of them are ancestors of pindex.
+    static constexpr int PREVIOUS_CYCLES{3};
+    std::map<int, const CBlockIndex*> list_indexes;
+    std::set<std::pair<Consensus::LLMQType, const CBlockIndex*>> cycle_indexes;
+    const auto add_list = [&](const CBlockIndex* pindexList) {
+        if (pindexList != nullptr && pindexList != pindex &&
+            DeploymentActiveAt(*pindexList, m_consensus_params, Consensus::DEPLOYMENT_DIP0003)) {
+            list_indexes.emplace(pindexList->nHeight, pindexList);
+        }
+    };
+
+    snapshotRet.m_commitments.clear();
+    for (const auto& [llmqType, vecBlockIndexes] : m_qblockman.GetMinedAndActiveCommitmentsUntilBlock(pindex)) {
+        const auto& llmq_params = Params().GetLLMQ(llmqType).value();
+        for (const auto& blockIndex : vecBlockIndexes) {
+            auto [qc, minedBlockHash] = m_qblockman.GetMinedCommitment(llmqType, blockIndex->GetBlockHash());
+            if (minedBlockHash.IsNull()) {
+                LogPrintf("CSpecialTxProcessor::%s -- mined commitment not found. type=%d, quorumHash=%s\n", __func__,
+                          std23::to_underlying(llmqType), blockIndex->GetBlockHash().ToString());
+                return false;
+            }
+            snapshotRet.m_commitments.emplace_back(std::move(qc), minedBlockHash);
+
+            add_list(blockIndex);
+            if (llmq::IsQuorumRotationEnabled(llmq_params, blockIndex)) {
+                const CBlockIndex* pCycleIndex = blockIndex->GetAncestor(blockIndex->nHeight - blockIndex->nHeight % llmq_params.dkgInterval);
+                for (int i = 0; i <= PREVIOUS_CYCLES && pCycleIndex != nullptr; ++i) {
+                    cycle_indexes.emplace(llmqType, pCycleIndex);
+                    add_list(pCycleIndex->GetAncestor(pCycleIndex->nHeight - llmq::WORK_DIFF_DEPTH));
+                    pCycleIndex = pCycleIndex->GetAncestor(pCycleIndex->nHeight - llmq_params.dkgInterval);
+                }
+            } else if (DeploymentActiveAfter(blockIndex, m_consensus_params, Consensus::DEPLOYMENT_V20)) {
+                add_list(blockIndex->GetAncestor(blockIndex->nHeight - llmq::WORK_DIFF_DEPTH));
+            }
+        }
+    }
+
+    snapshotRet.m_quorum_mn_lists.clear();
+    for (const auto& [_, pindexList] : list_indexes) {
+        CBlock list_block;
+        if (!ReadBlockFromDisk(list_block, pindexList, m_consensus_params)) {
+            LogPrintf("CSpecialTxProcessor::%s -- failed to read block %s\n", __func__, pindexList->GetBlockHash().ToString());
+            return false;
+        }
+        auto& mn_list = snapshotRet.m_quorum_mn_lists.emplace_back();
+        mn_list.SetBlock(list_block);
+        mn_list.m_mn_list = m_dmnman.GetListForBlock(pindexList);
+    }
+
+    snapshotRet.m_quorum_snapshots.clear();
+    for (const auto& [llmqType, pCycleIndex] : cycle_indexes) {
+        // Only cycles whose members were computed have one
+        if (auto opt_snap = m_qsnapman.GetSnapshotForBlock(llmqType, pCycleIndex); opt_snap.has_value()) {
+            snapshotRet.m_quorum_snapshots.emplace_back(llmqType, pCycleIndex->GetBlockHash(), std::move(*opt_snap));
+        }
+    }
+
+    try {
+        snapshotRet.m_credit_pool = m_cpoolman.GetCreditPool(pindex);
+    } catch (const std::exception& e) {
+        LogPrintf("CSpecialTxProcessor::%s -- failed to get credit pool: %s\n", __func__, e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool CSpecialTxProcessor::LoadEvoSnapshot(const CEvoSnapshot& snapshot, gsl::not_null<const CBlockIndex*> pindex,
+                                          std::string& error)
+{
+    AssertLockHeld(::cs_main);
+
+    if (!snapshot.Verify(*pindex, error)) {
+        return false;
+    }
+    if (!DeploymentActiveAt(*pindex, m_consensus_params, Consensus::DEPLOYMENT_DIP0003)) {
+        return true;
+    }
+
+    // The commitments themselves are covered by merkleRootQuorums, the blocks they were mined in are not.
+    // Check all of them before anything is written.
+    std::vector<const CBlockIndex*> mined_indexes;
+    mined_indexes.reserve(snapshot.m_commitments.size());
+    for (const auto& [qc, minedBlockHash] : snapshot.m_commitments) {
+        const CBlockIndex* pMinedBlockIndex = m_chainman.m_blockman.LookupBlockIndex(minedBlockHash);
+        if (pMinedBlockIndex == nullptr || pindex->GetAncestor(pMinedBlockIndex->nHeight) != pMinedBlockIndex) {
+            error = "quorum commitment mined outside of the snapshot chain";
+            return false;
+        }
+        if (!m_qblockman.CheckSnapshotCommitment(qc, pMinedBlockIndex)) {
+            error = "bad quorum commitment";
+            return false;
+        }
+        mined_indexes.emplace_back(pMinedBlockIndex);
+    }
+    std::vector<const CBlockIndex*> cycle_indexes;
+    cycle_indexes.reserve(snapshot.m_quorum_snapshots.size());
+    for (const auto& [llmqType, cycleHash, _] : snapshot.m_quorum_snapshots) {
+        const CBlockIndex* pCycleIndex = m_chainman.m_blockman.LookupBlockIndex(cycleHash);
+        if (!Params().GetLLMQ(llmqType).has_value() || pCycleIndex == nullptr ||
+            pindex->GetAncestor(pCycleIndex->nHeight) != pCycleIndex) {
+            error = "quorum snapshot outside of the snapshot chain";
+            return false;
+        }
+        cycle_indexes.emplace_back(pCycleIndex);
+    }
+
+    for (size_t i = 0; i < snapshot.m_commitments.size(); ++i) {
+        m_qblockman.AddSnapshotCommitment(snapshot.m_commitments[i].first, mined_indexes[i]);
+    }
+    for (size_t i = 0; i < snapshot.m_quorum_snapshots.size(); ++i) {
+        const auto& [llmqType, _, quorum_snapshot] = snapshot.m_quorum_snapshots[i];
+        m_qsnapman.StoreSnapshotForBlock(llmqType, cycle_indexes[i], quorum_snapshot);
+    }
+    for (const auto& mn_list : snapshot.m_quorum_mn_lists) {
+        m_dmnman.AddSnapshotList(mn_list.m_mn_list);
+    }
+    m_dmnman.AddSnapshotList(snapshot.m_base.m_mn_list);
+    m_cpoolman.AddSnapshotPool(*pindex, snapshot.m_credit_pool);
+
+    LogPrintf("CSpecialTxProcessor::%s -- loaded evo state at height=%d: %d masternodes, %d quorum commitments, "
+              "%d quorum masternode lists, %d quorum snapshots\n",
+              __func__, pindex->nHeight, snapshot.m_base.m_mn_list.GetCounts().total(), snapshot.m_commitments.size(),
+              snapshot.m_quorum_mn_lists.size(), snapshot.m_quorum_snapshots.size());
+    return true;
+}
+
 bool CSpecialTxProcessor::CheckCreditPoolDiffForBlock(const CBlock& block, const CBlockIndex* pindex, const CCbTx& cbTx,
                                                       BlockValidationState& state)
 {
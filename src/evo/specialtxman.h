@@ -10,6 +10,7 @@
 #include <threadsafety.h>
 
 #include <optional>
+#include <string>
 
 class BlockValidationState;
 class CBlock;
@@ -20,6 +21,7 @@ class CCoinsViewCache;
 class CCreditPoolManager;
 class CDeterministicMNList;
 class CDeterministicMNManager;
+class CEvoSnapshot;
 class CTransaction;
 class ChainstateManager;
 class CMNHFManager;
@@ -73,8 +75,11 @@ public:
     bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, const CCoinsViewCache& view, bool fJustCheck,
                                   bool fCheckCbTxMerkleRoots, BlockValidationState& state, std::optional<MNListUpdates>& updatesRet)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
-    bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, std::optional<MNListUpdates>& updatesRet)
-        EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    // With fUndoMNList=false the masternode list is left to UndoMNListInBlocks, which rolls back many blocks at once
+    bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, std::optional<MNListUpdates>& updatesRet,
+                               bool fUndoMNList) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    bool UndoMNListInBlocks(gsl::not_null<const CBlockIndex*> pindexTip, gsl::not_null<const CBlockIndex*> pindexFork,
+                            std::optional<MNListUpdates>& updatesRet) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
 
     // the returned list will not contain the correct block hash (we can't know it yet as the coinbase TX is not updated yet)
@@ -88,6 +93,13 @@ public:
                               const CDeterministicMNList& prevList, const CCoinsViewCache& view, bool debugLogs,
                               BlockValidationState& state, CDeterministicMNList& mnListRet);
 
+    // Collect the evo state at a block for a UTXO snapshot based on it, `block` must be the block of `pindex`
+    bool CreateEvoSnapshot(const CBlock& block, gsl::not_null<const CBlockIndex*> pindex, CEvoSnapshot& snapshotRet)
+        EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    // Verify the evo state of a UTXO snapshot against the CbTx of its base block and store it
+    bool LoadEvoSnapshot(const CEvoSnapshot& snapshot, gsl::not_null<const CBlockIndex*> pindex, std::string& error)
+        EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
 private:
     bool CheckCreditPoolDiffForBlock(const CBlock& block, const CBlockIndex* pindex, const CCbTx& cbTx,
                                      BlockValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
@@ -59,6 +59,12 @@ void NetGovernance::Schedule(CScheduler& scheduler)
         Params().IsMockableChain() ? std::chrono::seconds{1} : std::chrono::seconds{5});
 }
 
+std::vector<std::string> NetGovernance::GetDispatchedMessageTypes() const
+{
+    // Governance sync can push and validate thousands of objects and votes, keep it off the message handler thread
+    return {NetMsgType::MNGOVERNANCESYNC, NetMsgType::MNGOVERNANCEOBJECT, NetMsgType::MNGOVERNANCEOBJECTVOTE};
+}
+
 void NetGovernance::ProcessMessage(CNode& peer, const std::string& msg_type, CDataStream& vRecv)
 {
     if (!m_gov_manager.IsValid()) return;
@@ -128,7 +134,7 @@ void NetGovernance::ProcessMessage(CNode& peer, const std::string& msg_type, CDa
 
         uint256 nHash = govobj.GetHash();
 
-        WITH_LOCK(::cs_main, m_peer_manager->PeerEraseObjectRequest(peer.GetId(), CInv{MSG_GOVERNANCE_OBJECT, nHash}));
+        m_peer_manager->PeerEraseObjectRequest(peer.GetId(), CInv{MSG_GOVERNANCE_OBJECT, nHash});
 
         if (!m_node_sync.IsBlockchainSynced()) {
             LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECT -- masternode list not synced\n");
@@ -157,7 +163,7 @@ void NetGovernance::ProcessMessage(CNode& peer, const std::string& msg_type, CDa
 
         uint256 nHash = vote.GetHash();
 
-        WITH_LOCK(::cs_main, m_peer_manager->PeerEraseObjectRequest(peer.GetId(), CInv{MSG_GOVERNANCE_OBJECT_VOTE, nHash}));
+        m_peer_manager->PeerEraseObjectRequest(peer.GetId(), CInv{MSG_GOVERNANCE_OBJECT_VOTE, nHash});
 
         // Ignore such messages until masternode list is synced
         if (!m_node_sync.IsBlockchainSynced()) {
@@ -26,6 +26,8 @@ public:
     void Schedule(CScheduler& scheduler) override;
 
     void ProcessMessage(CNode& peer, const std::string& msg_type, CDataStream& vRecv) override;
+    std::vector<std::string> GetDispatchedMessageTypes() const override;
+    std::string GetDispatchThreadName() const override { return "govdispatch"; }
 
     bool AlreadyHave(const CInv& inv) override;
     bool ProcessGetData(CNode& pfrom, const CInv& inv, CConnman& connman, const CNetMsgMaker& msgMaker) override;
@@ -14,8 +14,25 @@
 #include <undo.h>
 #include <util/system.h>
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+
+//! Legacy history format, one key per entry
 constexpr uint8_t DB_ADDRESSINDEX{'a'};
+constexpr uint8_t DB_ADDRESSINDEX_BUCKET{'h'};
 constexpr uint8_t DB_ADDRESSUNSPENTINDEX{'u'};
+constexpr uint8_t DB_ADDRESSSUMMARY{'s'};
+//! Marks that the address summaries cover the history, absent in databases written before summaries existed
+constexpr uint8_t DB_ADDRESSSUMMARY_COMPLETE{'S'};
+
+//! Height the open bucket of an address is stored at, sorting after all sealed buckets
+constexpr int32_t OPEN_BUCKET_HEIGHT{std::numeric_limits<int32_t>::max()};
+//! Flush the legacy entry erase and summary build batches once they grow this large
+constexpr size_t LEGACY_ERASE_BATCH_SIZE{16 << 20};
 
 std::unique_ptr<AddressIndex> g_addressindex;
 
@@ -24,14 +41,95 @@ AddressIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
 {
 }
 
-bool AddressIndex::DB::WriteBatch(const std::vector<CAddressIndexEntry>& address_entries,
+static auto BucketKey(AddressType type, const uint160& address_hash, int32_t height)
+{
+    return std::make_pair(DB_ADDRESSINDEX_BUCKET, CAddressIndexIteratorHeightKey(type, address_hash, height));
+}
+
+static auto SummaryKey(AddressType type, const uint160& address_hash)
+{
+    return std::make_pair(DB_ADDRESSSUMMARY, CAddressIndexIteratorKey(type, address_hash));
+}
+
+static void WriteSummary(CDBBatch& batch, AddressType type, const uint160& address_hash, const CAddressSummary& summary)
+{
+    if (summary.IsNull()) {
+        batch.Erase(SummaryKey(type, address_hash));
+    } else {
+        batch.Write(SummaryKey(type, address_hash), summary);
+    }
+}
+
+static bool SameAddress(const CAddressIndexKey& a, const CAddressIndexKey& b)
+{
+    return a.m_address_type == b.m_address_type && a.m_address_bytes == b.m_address_bytes;
+}
+
+bool AddressIndex::DB::ReadBucket(AddressType type, const uint160& address_hash, int32_t height, CAddressIndexBucket& bucket)
+{
+    if (!Read(BucketKey(type, address_hash, height), bucket)) {
+        return false;
+    }
+    bucket.SetAddress(type, address_hash);
+    return true;
+}
+
+int32_t AddressIndex::DB::LastSealedHeight(AddressType type, const uint160& address_hash, int32_t height)
+{
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(BucketKey(type, address_hash, 0));
+
+    int32_t last_height{-1};
+    while (pcursor->Valid()) {
+        std::pair<uint8_t, CAddressIndexIteratorHeightKey> key;
+        if (!pcursor->GetKey(key) || key.first != DB_ADDRESSINDEX_BUCKET || key.second.m_address_type != type ||
+            key.second.m_address_bytes != address_hash || key.second.m_block_height >= height) {
+            break;
+        }
+        last_height = key.second.m_block_height;
+        pcursor->Next();
+    }
+    return last_height;
+}
+
+bool AddressIndex::DB::WriteBatch(std::vector<CAddressIndexEntry> address_entries,
                                   const std::vector<CAddressUnspentIndexEntry>& unspent_entries)
 {
     CDBBatch batch(*this);
 
-    // Write address transaction history
-    for (const auto& [key, value] : address_entries) {
-        batch.Write(std::make_pair(DB_ADDRESSINDEX, key), value);
+    // Append address transaction history to the open bucket of each address, in key (and so height) order
+    std::sort(address_entries.begin(), address_entries.end(),
+              [](const CAddressIndexEntry& a, const CAddressIndexEntry& b) {
+                  return CAddressIndexKeyCompare{}(a.first, b.first);
+              });
+    for (auto it = address_entries.begin(); it != address_entries.end();) {
+        const AddressType type{it->first.m_address_type};
+        const uint160 address_hash{it->first.m_address_bytes};
+
+        CAddressIndexBucket bucket;
+        ReadBucket(type, address_hash, OPEN_BUCKET_HEIGHT, bucket);
+        CAddressSummary summary;
+        ReadAddressSummary(address_hash, type, summary);
+        const int32_t indexed_height{bucket.m_last_height};
+        const CAddressIndexKey* prev{nullptr};
+        for (const auto& first = it->first; it != address_entries.end() && SameAddress(it->first, first); ++it) {
+            const int32_t height{it->first.m_block_height};
+            if (height <= indexed_height) {
+                // Already written, e.g. a sync batch which is replayed after an unclean shutdown
+                continue;
+            }
+            // Seal a full bucket, but never split the entries of one block across buckets
+            if (bucket.m_entries.size() >= MAX_BUCKET_ENTRIES && bucket.m_entries.back().first.m_block_height != height) {
+                batch.Write(BucketKey(type, address_hash, bucket.m_entries.back().first.m_block_height), bucket);
+                bucket.m_entries.clear();
+            }
+            bucket.m_entries.push_back(*it);
+            bucket.m_last_height = height;
+            summary.Add(it->first, it->second, /*new_tx=*/!prev || !CAddressIndexBucket::SameTx(*prev, it->first));
+            prev = &it->first;
+        }
+        batch.Write(BucketKey(type, address_hash, OPEN_BUCKET_HEIGHT), bucket);
+        WriteSummary(batch, type, address_hash, summary);
     }
 
     // Write address unspent outputs (handles both adds and deletes)
@@ -48,52 +146,79 @@ bool AddressIndex::DB::WriteBatch(const std::vector<CAddressIndexEntry>& address
 }
 
 bool AddressIndex::DB::ReadAddressIndex(const uint160& address_hash, const AddressType type,
-                                        std::vector<CAddressIndexEntry>& entries, const int32_t start, const int32_t end)
+                                        std::vector<CAddressIndexEntry>& entries, const int32_t start, const int32_t end,
+                                        const std::optional<CAddressIndexKey>& after, const size_t limit)
 {
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
 
-    if (start > 0 && end > 0) {
-        pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightKey(type, address_hash, start)));
-    } else {
-        pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorKey(type, address_hash)));
+    // Sealed buckets are keyed by their last height, so the first one which can contain start is found by seeking to it
+    int32_t seek_height{start > 0 && end > 0 ? start : 0};
+    if (after) {
+        seek_height = std::max(seek_height, after->m_block_height);
     }
+    pcursor->Seek(BucketKey(type, address_hash, seek_height));
 
+    size_t count{0};
     while (pcursor->Valid()) {
-        std::pair<uint8_t, CAddressIndexKey> key;
-        if (pcursor->GetKey(key) && key.first == DB_ADDRESSINDEX && key.second.m_address_type == type &&
-            key.second.m_address_bytes == address_hash) {
-            if (end > 0 && key.second.m_block_height > end) {
-                break;
+        std::pair<uint8_t, CAddressIndexIteratorHeightKey> key;
+        if (!pcursor->GetKey(key) || key.first != DB_ADDRESSINDEX_BUCKET || key.second.m_address_type != type ||
+            key.second.m_address_bytes != address_hash) {
+            break;
+        }
+        CAddressIndexBucket bucket;
+        if (!pcursor->GetValue(bucket)) {
+            return error("failed to get address index value");
+        }
+        bucket.SetAddress(type, address_hash);
+        for (const auto& [entry_key, value] : bucket.m_entries) {
+            if (start > 0 && end > 0 && entry_key.m_block_height < start) {
+                continue;
             }
-            CAmount value;
-            if (pcursor->GetValue(value)) {
-                entries.emplace_back(key.second, value);
-                pcursor->Next();
-            } else {
-                return error("failed to get address index value");
+            if (end > 0 && entry_key.m_block_height > end) {
+                return true;
             }
-        } else {
-            break;
+            if (after && !CAddressIndexKeyCompare{}(*after, entry_key)) {
+                continue;
+            }
+            if (limit > 0 && count == limit) {
+                return true;
+            }
+            entries.emplace_back(entry_key, value);
+            ++count;
         }
+        pcursor->Next();
     }
 
     return true;
 }
 
 bool AddressIndex::DB::ReadAddressUnspentIndex(const uint160& address_hash, const AddressType type,
-                                               std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort)
+                                               std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort,
+                                               const std::optional<CAddressUnspentKey>& after, const size_t limit)
 {
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
 
-    pcursor->Seek(std::make_pair(DB_ADDRESSUNSPENTINDEX, CAddressIndexIteratorKey(type, address_hash)));
+    if (after) {
+        pcursor->Seek(std::make_pair(DB_ADDRESSUNSPENTINDEX, *after));
+    } else {
+        pcursor->Seek(std::make_pair(DB_ADDRESSUNSPENTINDEX, CAddressIndexIteratorKey(type, address_hash)));
+    }
 
-    while (pcursor->Valid()) {
+    size_t count{0};
+    while (pcursor->Valid() && (limit == 0 || count < limit)) {
         std::pair<uint8_t, CAddressUnspentKey> key;
         if (pcursor->GetKey(key) && key.first == DB_ADDRESSUNSPENTINDEX && key.second.m_address_type == type &&
             key.second.m_address_bytes == address_hash) {
+            // Seeking lands on the resumed output itself if it is still unspent. Keys are ordered by
+            // their serialization, which has the output index little-endian, so only skip that one key.
+            if (after && after->m_tx_hash == key.second.m_tx_hash && after->m_tx_index == key.second.m_tx_index) {
+                pcursor->Next();
+                continue;
+            }
             CAddressUnspentValue value;
             if (pcursor->GetValue(value)) {
                 entries.emplace_back(key.second, value);
+                ++count;
                 pcursor->Next();
             } else {
                 return error("failed to get address unspent value");
@@ -113,15 +238,9 @@ bool AddressIndex::DB::ReadAddressUnspentIndex(const uint160& address_hash, cons
     return true;
 }
 
-bool AddressIndex::DB::EraseAddressIndex(const std::vector<CAddressIndexEntry>& entries)
+bool AddressIndex::DB::ReadAddressSummary(const uint160& address_hash, const AddressType type, CAddressSummary& summary)
 {
-    CDBBatch batch(*this);
-
-    for (const auto& [key, _] : entries) {
-        batch.Erase(std::make_pair(DB_ADDRESSINDEX, key));
-    }
-
-    return CDBWrapper::WriteBatch(batch);
+    return Read(SummaryKey(type, address_hash), summary);
 }
 
 bool AddressIndex::DB::UpdateAddressUnspentIndex(const std::vector<CAddressUnspentIndexEntry>& entries)
@@ -139,13 +258,46 @@ bool AddressIndex::DB::UpdateAddressUnspentIndex(const std::vector<CAddressUnspe
     return CDBWrapper::WriteBatch(batch);
 }
 
-bool AddressIndex::DB::RewindBatch(const std::vector<CAddressIndexEntry>& address_entries,
+bool AddressIndex::DB::RewindBatch(int32_t height, const std::vector<CAddressIndexEntry>& address_entries,
                                    const std::vector<CAddressUnspentIndexEntry>& unspent_entries)
 {
     CDBBatch batch(*this);
 
+    std::set<std::pair<AddressType, uint160>> addresses;
     for (const auto& [key, _] : address_entries) {
-        batch.Erase(std::make_pair(DB_ADDRESSINDEX, key));
+        addresses.emplace(key.m_address_type, key.m_address_bytes);
+    }
+    for (const auto& [type, address_hash] : addresses) {
+        CAddressIndexBucket bucket;
+        ReadBucket(type, address_hash, OPEN_BUCKET_HEIGHT, bucket);
+        CAddressSummary summary;
+        ReadAddressSummary(address_hash, type, summary);
+        auto drop_rewound = [&] {
+            while (!bucket.m_entries.empty() && bucket.m_entries.back().first.m_block_height >= height) {
+                const auto [key, amount] = bucket.m_entries.back();
+                bucket.m_entries.pop_back();
+                // Transactions never span buckets, as blocks are never split across them
+                summary.Remove(amount, /*last_of_tx=*/bucket.m_entries.empty() ||
+                                                      !CAddressIndexBucket::SameTx(bucket.m_entries.back().first, key));
+            }
+        };
+        drop_rewound();
+        // The entries of the block were sealed into a bucket when a later block was appended,
+        // which was rewound already. Reopen that bucket.
+        CAddressIndexBucket sealed;
+        if (bucket.m_entries.empty() && ReadBucket(type, address_hash, height, sealed)) {
+            batch.Erase(BucketKey(type, address_hash, height));
+            bucket.m_entries = std::move(sealed.m_entries);
+            drop_rewound();
+        }
+        bucket.m_last_height = std::min(bucket.m_last_height, height - 1);
+        batch.Write(BucketKey(type, address_hash, OPEN_BUCKET_HEIGHT), bucket);
+
+        if (!summary.IsNull()) {
+            summary.m_last_height = bucket.m_entries.empty() ? LastSealedHeight(type, address_hash, height)
+                                                             : bucket.m_entries.back().first.m_block_height;
+        }
+        WriteSummary(batch, type, address_hash, summary);
     }
 
     for (const auto& [key, value] : unspent_entries) {
@@ -159,6 +311,102 @@ bool AddressIndex::DB::RewindBatch(const std::vector<CAddressIndexEntry>& addres
     return CDBWrapper::WriteBatch(batch);
 }
 
+bool AddressIndex::DB::HasLegacyEntries()
+{
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(DB_ADDRESSINDEX);
+    uint8_t prefix{0};
+    return pcursor->Valid() && pcursor->GetKey(prefix) && prefix == DB_ADDRESSINDEX;
+}
+
+bool AddressIndex::DB::EraseLegacyEntries()
+{
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    CDBBatch batch(*this);
+
+    pcursor->Seek(DB_ADDRESSINDEX);
+    while (pcursor->Valid()) {
+        std::pair<uint8_t, CAddressIndexKey> key;
+        if (!pcursor->GetKey(key) || key.first != DB_ADDRESSINDEX) {
+            break;
+        }
+        batch.Erase(key);
+        if (batch.SizeEstimate() > LEGACY_ERASE_BATCH_SIZE) {
+            if (!CDBWrapper::WriteBatch(batch)) {
+                return false;
+            }
+            batch.Clear();
+        }
+        pcursor->Next();
+    }
+
+    // Start over from the genesis block. Unspent outputs are rewritten in block order while
+    // syncing again, which leaves them in the same state.
+    WriteBestBlock(batch, CBlockLocator{});
+    if (!CDBWrapper::WriteBatch(batch, /*fSync=*/true)) {
+        return false;
+    }
+    CompactRange(DB_ADDRESSINDEX, DB_ADDRESSINDEX_BUCKET);
+    return true;
+}
+
+bool AddressIndex::DB::HasSummaries()
+{
+    return Exists(DB_ADDRESSSUMMARY_COMPLETE);
+}
+
+bool AddressIndex::DB::BuildSummaries()
+{
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    CDBBatch batch(*this);
+
+    // Buckets of an address are ordered by height with the open bucket last, so its history is
+    // visited in order and the summary is complete once the next address is reached
+    std::optional<CAddressIndexIteratorKey> address;
+    CAddressSummary summary;
+    const CAddressIndexKey* prev{nullptr};
+    CAddressIndexBucket bucket;
+    auto flush_summary = [&] {
+        if (address) {
+            WriteSummary(batch, address->m_address_type, address->m_address_bytes, summary);
+        }
+    };
+
+    pcursor->Seek(DB_ADDRESSINDEX_BUCKET);
+    while (pcursor->Valid()) {
+        std::pair<uint8_t, CAddressIndexIteratorHeightKey> key;
+        if (!pcursor->GetKey(key) || key.first != DB_ADDRESSINDEX_BUCKET) {
+            break;
+        }
+        if (!address || address->m_address_type != key.second.m_address_type ||
+            address->m_address_bytes != key.second.m_address_bytes) {
+            flush_summary();
+            address = CAddressIndexIteratorKey(key.second.m_address_type, key.second.m_address_bytes);
+            summary = CAddressSummary{};
+        }
+        // Transactions never span buckets, the first entry of a bucket always starts a new one
+        prev = nullptr;
+        if (!pcursor->GetValue(bucket)) {
+            return error("failed to get address index value");
+        }
+        for (const auto& [entry_key, value] : bucket.m_entries) {
+            summary.Add(entry_key, value, /*new_tx=*/!prev || !CAddressIndexBucket::SameTx(*prev, entry_key));
+            prev = &entry_key;
+        }
+        if (batch.SizeEstimate() > LEGACY_ERASE_BATCH_SIZE) {
+            if (!CDBWrapper::WriteBatch(batch)) {
+                return false;
+            }
+            batch.Clear();
+        }
+        pcursor->Next();
+    }
+    flush_summary();
+
+    batch.Write(DB_ADDRESSSUMMARY_COMPLETE, true);
+    return CDBWrapper::WriteBatch(batch, /*fSync=*/true);
+}
+
 AddressIndex::AddressIndex(size_t n_cache_size, bool f_memory, bool f_wipe) :
     m_db(std::make_unique<AddressIndex::DB>(n_cache_size, f_memory, f_wipe))
 {
@@ -166,13 +414,10 @@ AddressIndex::AddressIndex(size_t n_cache_size, bool f_memory, bool f_wipe) :
 
 AddressIndex::~AddressIndex() = default;
 
-bool AddressIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+/** Derive the address history and unspent entries of a connected block, in block order */
+static bool GetBlockEntries(const CBlock& block, const CBlockIndex* pindex, std::vector<CAddressIndexEntry>& addressIndex,
+                            std::vector<CAddressUnspentIndexEntry>& addressUnspentIndex)
 {
-    // Skip genesis block (no inputs to index)
-    if (pindex->nHeight == 0) {
-        return true;
-    }
-
     // Read undo data for this block to get information about spent outputs
     CBlockUndo blockundo;
     if (!node::UndoReadFromDisk(blockundo, pindex)) {
@@ -180,9 +425,6 @@ bool AddressIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
                      pindex->GetBlockHash().ToString(), pindex->nHeight);
     }
 
-    std::vector<CAddressIndexEntry> addressIndex;
-    std::vector<CAddressUnspentIndexEntry> addressUnspentIndex;
-
     // Process each non-coinbase transaction
     // blockundo.vtxundo[i] corresponds to block.vtx[i+1] (coinbase is skipped in undo data)
     if (blockundo.vtxundo.size() != block.vtx.size() - 1) {
@@ -264,7 +506,95 @@ bool AddressIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
                                          CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight));
     }
 
-    return m_db->WriteBatch(addressIndex, addressUnspentIndex);
+    return true;
+}
+
+bool AddressIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    // Skip genesis block (no inputs to index)
+    if (pindex->nHeight == 0) {
+        return true;
+    }
+
+    std::vector<CAddressIndexEntry> addressIndex;
+    std::vector<CAddressUnspentIndexEntry> addressUnspentIndex;
+    if (!GetBlockEntries(block, pindex, addressIndex, addressUnspentIndex)) {
+        return false;
+    }
+
+    return m_db->WriteBatch(std::move(addressIndex), addressUnspentIndex);
+}
+
+class AddressIndex::SyncBatch final : public BaseIndex::SyncBatch
+{
+private:
+    AddressIndex::DB& m_db;
+    std::vector<std::vector<CAddressIndexEntry>> m_address_entries;
+    std::vector<std::vector<CAddressUnspentIndexEntry>> m_unspent_entries;
+
+public:
+    SyncBatch(AddressIndex::DB& db, size_t n_blocks) :
+        m_db{db},
+        m_address_entries(n_blocks),
+        m_unspent_entries(n_blocks)
+    {
+    }
+
+    bool AddBlock(size_t n, const CBlock& block, const CBlockIndex* pindex) override
+    {
+        if (pindex->nHeight == 0) {
+            return true;
+        }
+        return GetBlockEntries(block, pindex, m_address_entries[n], m_unspent_entries[n]);
+    }
+
+    bool Write() override
+    {
+        // History is appended per address in key order by WriteBatch
+        size_t n_entries{0};
+        for (const auto& entries : m_address_entries) {
+            n_entries += entries.size();
+        }
+        std::vector<CAddressIndexEntry> address_entries;
+        address_entries.reserve(n_entries);
+        for (auto& entries : m_address_entries) {
+            std::move(entries.begin(), entries.end(), std::back_inserter(address_entries));
+        }
+
+        // Unspent updates are applied in block order, so an output created and spent within
+        // the batch collapses into a single erase
+        std::map<CAddressUnspentKey, CAddressUnspentValue, CAddressUnspentKeyCompare> unspent;
+        for (auto& entries : m_unspent_entries) {
+            for (auto& [key, value] : entries) {
+                unspent.insert_or_assign(key, std::move(value));
+            }
+        }
+
+        return m_db.WriteBatch(std::move(address_entries), {unspent.begin(), unspent.end()});
+    }
+};
+
+std::unique_ptr<BaseIndex::SyncBatch> AddressIndex::NewSyncBatch(size_t n_blocks) const
+{
+    return std::make_unique<AddressIndex::SyncBatch>(*m_db, n_blocks);
+}
+
+bool AddressIndex::Init()
+{
+    // History in the legacy format can't be converted without the blocks, build it again instead
+    if (m_db->HasLegacyEntries()) {
+        LogPrintf("%s: Address index uses the legacy history format, rebuilding it\n", __func__);
+        if (!m_db->EraseLegacyEntries()) {
+            return error("%s: Failed to erase legacy address index entries", __func__);
+        }
+    }
+    if (!m_db->HasSummaries()) {
+        LogPrintf("%s: Building address summaries from the address index\n", __func__);
+        if (!m_db->BuildSummaries()) {
+            return error("%s: Failed to build address summaries", __func__);
+        }
+    }
+    return BaseIndex::Init();
 }
 
 bool AddressIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
@@ -382,7 +712,7 @@ bool AddressIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new
         }
 
         // Apply both rewind updates in a single batch to avoid leaving the index half-rewound.
-        if (!m_db->RewindBatch(addressIndex, addressUnspentIndex)) {
+        if (!m_db->RewindBatch(pindex->nHeight, addressIndex, addressUnspentIndex)) {
             return error("%s: Failed to apply address index rewind batch", __func__);
         }
     }
@@ -394,13 +724,22 @@ bool AddressIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new
 BaseIndex::DB& AddressIndex::GetDB() const { return *m_db; }
 
 bool AddressIndex::GetAddressIndex(const uint160& address_hash, const AddressType type,
-                                   std::vector<CAddressIndexEntry>& entries, const int32_t start, const int32_t end) const
+                                   std::vector<CAddressIndexEntry>& entries, const int32_t start, const int32_t end,
+                                   const std::optional<CAddressIndexKey>& after, const size_t limit) const
+{
+    return m_db->ReadAddressIndex(address_hash, type, entries, start, end, after, limit);
+}
+
+CAddressSummary AddressIndex::GetAddressSummary(const uint160& address_hash, const AddressType type) const
 {
-    return m_db->ReadAddressIndex(address_hash, type, entries, start, end);
+    CAddressSummary summary;
+    m_db->ReadAddressSummary(address_hash, type, summary);
+    return summary;
 }
 
 bool AddressIndex::GetAddressUnspentIndex(const uint160& address_hash, const AddressType type,
-                                          std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort) const
+                                          std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort,
+                                          const std::optional<CAddressUnspentKey>& after, const size_t limit) const
 {
-    return m_db->ReadAddressUnspentIndex(address_hash, type, entries, height_sort);
+    return m_db->ReadAddressUnspentIndex(address_hash, type, entries, height_sort, after, limit);
 }
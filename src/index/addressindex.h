@@ -9,20 +9,32 @@
 #include <index/base.h>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 static constexpr bool DEFAULT_ADDRESSINDEX{false};
+//! Number of entries after which the open history bucket of an address is sealed
+static constexpr size_t MAX_BUCKET_ENTRIES{512};
+
+namespace addressindex_tests {
+class TestAddressIndexDB;
+} // namespace addressindex_tests
 
 /**
  * AddressIndex is an async index that maintains two separate databases:
- * 1. Address transaction history (all transactions touching an address)
+ * 1. Address transaction history (all transactions touching an address), stored as
+ *    CAddressIndexBucket runs of entries per address. The latest run of an address is kept
+ *    open for appending, full runs are sealed under the height of their last entry.
  * 2. Address unspent outputs (UTXO set filtered by address)
+ * 3. Address summaries (balance, received amount, transaction count, first and last seen height),
+ *    updated in the same batch as the history so balances don't need a walk over it
  *
  * Uses undo data to access historical UTXO information, requiring undo files
  * to be available (incompatible with pruned nodes).
  */
 class AddressIndex final : public BaseIndex
 {
+friend class addressindex_tests::TestAddressIndexDB; // for test access to the history buckets
 protected:
     class DB;
 
@@ -32,38 +44,69 @@ private:
 protected:
     class DB : public BaseIndex::DB
     {
+    friend class addressindex_tests::TestAddressIndexDB;
     public:
         explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
 
-        /// Write a batch of address index entries
-        bool WriteBatch(const std::vector<CAddressIndexEntry>& address_entries,
+        /// Append address history entries (in any order) to their addresses and update unspent outputs
+        bool WriteBatch(std::vector<CAddressIndexEntry> address_entries,
                         const std::vector<CAddressUnspentIndexEntry>& unspent_entries);
 
-        /// Read address transaction history
+        /// Read address transaction history, optionally only entries ordered after `after` and at most `limit` (0 for no limit) of them
         bool ReadAddressIndex(const uint160& address_hash, const AddressType type,
-                              std::vector<CAddressIndexEntry>& entries, const int32_t start = 0, const int32_t end = 0);
+                              std::vector<CAddressIndexEntry>& entries, const int32_t start = 0, const int32_t end = 0,
+                              const std::optional<CAddressIndexKey>& after = std::nullopt, const size_t limit = 0);
 
-        /// Read address unspent outputs
+        /// Read address unspent outputs, optionally only outputs ordered after `after` and at most `limit` (0 for no limit) of them
         bool ReadAddressUnspentIndex(const uint160& address_hash, const AddressType type,
-                                     std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort = false);
+                                     std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort = false,
+                                     const std::optional<CAddressUnspentKey>& after = std::nullopt, const size_t limit = 0);
 
-        /// Erase address transaction history entries
-        bool EraseAddressIndex(const std::vector<CAddressIndexEntry>& entries);
+        /// Read the totals of the history of an address, a null summary if it has no history
+        bool ReadAddressSummary(const uint160& address_hash, const AddressType type, CAddressSummary& summary);
 
         /// Update address unspent index (handles both adds and deletes)
         bool UpdateAddressUnspentIndex(const std::vector<CAddressUnspentIndexEntry>& entries);
 
-        /// Atomically erase address history entries and update unspent outputs during rewind.
-        bool RewindBatch(const std::vector<CAddressIndexEntry>& address_entries,
+        /// Atomically drop the address history of the block at height and update unspent outputs during rewind.
+        bool RewindBatch(int32_t height, const std::vector<CAddressIndexEntry>& address_entries,
                          const std::vector<CAddressUnspentIndexEntry>& unspent_entries);
+
+        /// Whether the database contains history entries in the legacy one key per entry format
+        bool HasLegacyEntries();
+
+        /// Erase all legacy history entries and reset the best block, so the history gets rebuilt
+        bool EraseLegacyEntries();
+
+        /// Whether the address summaries cover the history in the database
+        bool HasSummaries();
+
+        /// Build the summaries of all addresses from their history
+        bool BuildSummaries();
+
+    private:
+        /// Read the bucket stored at height (or the open bucket) of an address, false if there is none
+        bool ReadBucket(AddressType type, const uint160& address_hash, int32_t height, CAddressIndexBucket& bucket);
+
+        /// Height of the last sealed bucket of an address stored below height, -1 if there is none
+        int32_t LastSealedHeight(AddressType type, const uint160& address_hash, int32_t height);
     };
 
     /// Override to return false - we need undo data
     bool AllowPrune() const override { return false; }
 
+    class SyncBatch;
+
     /// Write block data to the index databases
     bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
 
+    /// Build the index in batches of blocks while syncing
+    bool SupportsSyncBatch() const override { return true; }
+    std::unique_ptr<BaseIndex::SyncBatch> NewSyncBatch(size_t n_blocks) const override;
+
+    /// Rebuild the index if it uses the legacy history format
+    [[nodiscard]] bool Init() override;
+
     /// Custom rewind to handle both transaction history and unspent index
     bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
 
@@ -78,13 +121,20 @@ public:
     /// Destructor
     virtual ~AddressIndex() override;
 
-    /// Query address transaction history
+    /// Query address transaction history. Entries are returned in key order, so a query can be resumed
+    /// after the last entry it returned by passing it as `after`.
     bool GetAddressIndex(const uint160& address_hash, const AddressType type, std::vector<CAddressIndexEntry>& entries,
-                         const int32_t start = 0, const int32_t end = 0) const;
+                         const int32_t start = 0, const int32_t end = 0,
+                         const std::optional<CAddressIndexKey>& after = std::nullopt, const size_t limit = 0) const;
+
+    /// Query the totals of the history of an address
+    CAddressSummary GetAddressSummary(const uint160& address_hash, const AddressType type) const;
 
-    /// Query address unspent outputs
+    /// Query address unspent outputs. Unless sorted by height, outputs are returned in key order and a
+    /// query can be resumed after the last output it returned by passing it as `after`.
     bool GetAddressUnspentIndex(const uint160& address_hash, const AddressType type,
-                                std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort = false) const;
+                                std::vector<CAddressUnspentIndexEntry>& entries, const bool height_sort = false,
+                                const std::optional<CAddressUnspentKey>& after = std::nullopt, const size_t limit = 0) const;
 };
 
 /// Global AddressIndex instance
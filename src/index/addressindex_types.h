@@ -8,6 +8,7 @@
 #ifndef BITCOIN_INDEX_ADDRESSINDEX_TYPES_H
 #define BITCOIN_INDEX_ADDRESSINDEX_TYPES_H
 
+#include <compressor.h>
 #include <consensus/amount.h>
 #include <script/script.h>
 #include <serialize.h>
@@ -155,6 +156,17 @@ public:
     }
 };
 
+struct CAddressIndexKeyCompare {
+    bool operator()(const CAddressIndexKey& a, const CAddressIndexKey& b) const
+    {
+        auto to_tuple = [](const CAddressIndexKey& obj) {
+            return std::tie(obj.m_address_type, obj.m_address_bytes, obj.m_block_height, obj.m_block_tx_pos,
+                            obj.m_tx_hash, obj.m_tx_index, obj.m_tx_spent);
+        };
+        return to_tuple(a) < to_tuple(b);
+    }
+};
+
 struct CAddressIndexIteratorKey {
 public:
     AddressType m_address_type{AddressType::UNKNOWN};
@@ -232,6 +244,145 @@ public:
     }
 };
 
+/**
+ * Address history entries of a single address, stored under one database key. Entries are kept
+ * in key order and serialized column by column: height deltas, positions in the block, hashes of
+ * distinct transactions, output indexes with the spending flag and compressed amounts. The address
+ * type and hash are only part of the database key.
+ */
+struct CAddressIndexBucket {
+public:
+    //! Highest block height appended to the address, blocks up to it are skipped when written again
+    int32_t m_last_height{-1};
+    std::vector<CAddressIndexEntry> m_entries;
+
+public:
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s << m_last_height;
+        WriteCompactSize(s, m_entries.size());
+        int32_t prev_height{0};
+        for (const auto& [key, _] : m_entries) {
+            s << VARINT(static_cast<uint32_t>(key.m_block_height - prev_height));
+            prev_height = key.m_block_height;
+        }
+        for (const auto& [key, _] : m_entries) {
+            s << VARINT(key.m_block_tx_pos);
+        }
+        // Height and position identify the transaction, only store its hash when they change
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (i == 0 || !SameTx(m_entries[i - 1].first, m_entries[i].first)) {
+                s << m_entries[i].first.m_tx_hash;
+            }
+        }
+        for (const auto& [key, _] : m_entries) {
+            s << VARINT((uint64_t{key.m_tx_index} << 1) | static_cast<uint64_t>(key.m_tx_spent));
+        }
+        // Spending entries are negative, store the magnitude
+        for (const auto& [key, amount] : m_entries) {
+            s << VARINT(CompressAmount(static_cast<uint64_t>(key.m_tx_spent ? -amount : amount)));
+        }
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        s >> m_last_height;
+        m_entries.clear();
+        m_entries.resize(ReadCompactSize(s));
+        int32_t height{0};
+        for (auto& [key, _] : m_entries) {
+            uint32_t delta;
+            s >> VARINT(delta);
+            height += static_cast<int32_t>(delta);
+            key.m_block_height = height;
+        }
+        for (auto& [key, _] : m_entries) {
+            s >> VARINT(key.m_block_tx_pos);
+        }
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (i == 0 || !SameTx(m_entries[i - 1].first, m_entries[i].first)) {
+                s >> m_entries[i].first.m_tx_hash;
+            } else {
+                m_entries[i].first.m_tx_hash = m_entries[i - 1].first.m_tx_hash;
+            }
+        }
+        for (auto& [key, _] : m_entries) {
+            uint64_t index_spent;
+            s >> VARINT(index_spent);
+            key.m_tx_index = static_cast<uint32_t>(index_spent >> 1);
+            key.m_tx_spent = index_spent & 1;
+        }
+        for (auto& [key, amount] : m_entries) {
+            uint64_t compressed;
+            s >> VARINT(compressed);
+            amount = static_cast<CAmount>(DecompressAmount(compressed));
+            if (key.m_tx_spent) amount = -amount;
+        }
+    }
+
+    /** Set the address of all entries, which is not serialized */
+    void SetAddress(AddressType address_type, const uint160& address_bytes)
+    {
+        for (auto& [key, _] : m_entries) {
+            key.m_address_type = address_type;
+            key.m_address_bytes = address_bytes;
+        }
+    }
+
+    /** Whether two entries of an address belong to the same transaction */
+    static bool SameTx(const CAddressIndexKey& a, const CAddressIndexKey& b)
+    {
+        return a.m_block_height == b.m_block_height && a.m_block_tx_pos == b.m_block_tx_pos;
+    }
+};
+
+/**
+ * Totals of the history of an address, maintained alongside its buckets so they don't have to be
+ * summed up from the whole history when queried.
+ */
+struct CAddressSummary {
+public:
+    CAmount m_balance{0};
+    //! Sum of all positive entries, including change
+    CAmount m_received{0};
+    //! Number of distinct transactions touching the address
+    uint64_t m_tx_count{0};
+    int32_t m_first_height{-1};
+    int32_t m_last_height{-1};
+
+public:
+    SERIALIZE_METHODS(CAddressSummary, obj)
+    {
+        READWRITE(obj.m_balance, obj.m_received, VARINT(obj.m_tx_count), obj.m_first_height, obj.m_last_height);
+    }
+
+    bool IsNull() const { return m_tx_count == 0; }
+
+    /** Account for an entry appended to the history, new_tx if it is the first entry of its transaction */
+    void Add(const CAddressIndexKey& key, CAmount amount, bool new_tx)
+    {
+        m_balance += amount;
+        if (amount > 0) m_received += amount;
+        if (new_tx) {
+            if (m_tx_count++ == 0) m_first_height = key.m_block_height;
+        }
+        m_last_height = key.m_block_height;
+    }
+
+    /** Account for an entry dropped from the end of the history, last_of_tx if no entry of its transaction is left.
+     *  The last height is left to the caller, which knows the remaining history. */
+    void Remove(CAmount amount, bool last_of_tx)
+    {
+        m_balance -= amount;
+        if (amount > 0) m_received -= amount;
+        if (last_of_tx && m_tx_count > 0 && --m_tx_count == 0) {
+            m_first_height = m_last_height = -1;
+        }
+    }
+};
+
 struct CAddressUnspentKey {
 public:
     AddressType m_address_type{AddressType::UNKNOWN};
@@ -278,6 +429,16 @@ public:
     }
 };
 
+struct CAddressUnspentKeyCompare {
+    bool operator()(const CAddressUnspentKey& a, const CAddressUnspentKey& b) const
+    {
+        auto to_tuple = [](const CAddressUnspentKey& obj) {
+            return std::tie(obj.m_address_type, obj.m_address_bytes, obj.m_tx_hash, obj.m_tx_index);
+        };
+        return to_tuple(a) < to_tuple(b);
+    }
+};
+
 struct CAddressUnspentValue {
 public:
     CAmount m_amount{-1};
@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <ctpl_stl.h>
 #include <index/base.h>
 #include <node/blockstorage.h>
 #include <node/interface_ui.h>
@@ -14,6 +15,10 @@
 #include <validation.h>
 #include <warnings.h>
 
+#include <algorithm>
+#include <exception>
+#include <future>
+
 using node::PruneLockInfo;
 using node::ReadBlockFromDisk;
 using node::fPruneMode;
@@ -22,6 +27,8 @@ constexpr uint8_t DB_BEST_BLOCK{'B'};
 
 constexpr auto SYNC_LOG_INTERVAL{30s};
 constexpr auto SYNC_LOCATOR_WRITE_INTERVAL{30s};
+//! Number of blocks synced at once by indexes supporting SyncBatch
+constexpr size_t SYNC_BATCH_SIZE{500};
 
 void BaseIndex::FatalErrorImpl(const std::string& message)
 {
@@ -133,8 +140,17 @@ void BaseIndex::ThreadSync()
     if (!m_synced) {
         auto& consensus_params = Params().GetConsensus();
 
+        // Indexes which support it are built in batches, decoding the blocks of a batch on a pool of threads
+        std::unique_ptr<ctpl::thread_pool> pool;
+        if (SupportsSyncBatch()) {
+            const int n_threads{std::clamp<int>(gArgs.GetIntArg("-indexsyncthreads", DEFAULT_INDEX_SYNC_THREADS), 1, MAX_INDEX_SYNC_THREADS)};
+            pool = std::make_unique<ctpl::thread_pool>(n_threads);
+            RenameThreadPool(*pool, GetName());
+        }
+
         std::chrono::steady_clock::time_point last_log_time{0s};
         std::chrono::steady_clock::time_point last_locator_write_time{0s};
+        std::vector<const CBlockIndex*> blocks;
         while (true) {
             if (m_interrupt) {
                 SetBestBlockIndex(pindex);
@@ -145,6 +161,7 @@ void BaseIndex::ThreadSync()
                 return;
             }
 
+            blocks.clear();
             {
                 LOCK(cs_main);
                 const CBlockIndex* pindex_next = NextSyncBlock(pindex, m_chainstate->m_chain);
@@ -160,19 +177,69 @@ void BaseIndex::ThreadSync()
                                __func__, GetName());
                     return;
                 }
-                pindex = pindex_next;
+                blocks.push_back(pindex_next);
+                while (pool && blocks.size() < SYNC_BATCH_SIZE) {
+                    const CBlockIndex* pindex_batch = m_chainstate->m_chain.Next(blocks.back());
+                    if (!pindex_batch) break;
+                    blocks.push_back(pindex_batch);
+                }
             }
 
-            CBlock block;
-            if (!ReadBlockFromDisk(block, pindex, consensus_params)) {
-                FatalError("%s: Failed to read block %s from disk",
-                           __func__, pindex->GetBlockHash().ToString());
-                return;
-            }
-            if (!WriteBlock(block, pindex)) {
-                FatalError("%s: Failed to write block %s to index database",
-                           __func__, pindex->GetBlockHash().ToString());
-                return;
+            if (pool) {
+                auto batch = NewSyncBatch(blocks.size());
+                std::vector<std::future<bool>> futures;
+                futures.reserve(blocks.size());
+                for (size_t i = 0; i < blocks.size(); ++i) {
+                    futures.emplace_back(pool->push([&, i](int) {
+                        if (m_interrupt) return false;
+                        CBlock block;
+                        if (!ReadBlockFromDisk(block, blocks[i], consensus_params)) {
+                            return error("%s: Failed to read block %s from disk", __func__,
+                                         blocks[i]->GetBlockHash().ToString());
+                        }
+                        return batch->AddBlock(i, block, blocks[i]);
+                    }));
+                }
+                // The tasks refer to blocks and batch, so all of them have to finish before an
+                // exception can leave this scope
+                bool decoded{true};
+                std::exception_ptr exception;
+                for (auto& future : futures) {
+                    try {
+                        decoded &= future.get();
+                    } catch (...) {
+                        if (!exception) exception = std::current_exception();
+                    }
+                }
+                if (exception) std::rethrow_exception(exception);
+                if (m_interrupt) {
+                    // Drop the partially decoded batch, the index resumes from the last checkpoint
+                    continue;
+                }
+                if (!decoded || !batch->Write()) {
+                    FatalError("%s: Failed to write blocks %d-%d to index database",
+                               __func__, blocks.front()->nHeight, blocks.back()->nHeight);
+                    return;
+                }
+                pindex = blocks.back();
+                // Every batch is a checkpoint to resume from
+                SetBestBlockIndex(pindex);
+                last_locator_write_time = std::chrono::steady_clock::now();
+                // No need to handle errors in Commit. See rationale above.
+                Commit();
+            } else {
+                pindex = blocks.front();
+                CBlock block;
+                if (!ReadBlockFromDisk(block, pindex, consensus_params)) {
+                    FatalError("%s: Failed to read block %s from disk",
+                               __func__, pindex->GetBlockHash().ToString());
+                    return;
+                }
+                if (!WriteBlock(block, pindex)) {
+                    FatalError("%s: Failed to write block %s to index database",
+                               __func__, pindex->GetBlockHash().ToString());
+                    return;
+                }
             }
 
             auto current_time{std::chrono::steady_clock::now()};
@@ -11,11 +11,15 @@
 #include <validationinterface.h>
 
 #include <atomic>
+#include <memory>
 
 class CBlock;
 class CBlockIndex;
 class CChainState;
 
+static constexpr int DEFAULT_INDEX_SYNC_THREADS{4};
+static constexpr int MAX_INDEX_SYNC_THREADS{16};
+
 struct IndexSummary {
     std::string name;
     bool synced{false};
@@ -102,6 +106,33 @@ protected:
     /// Write update index entries for a newly connected block.
     virtual bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) { return true; }
 
+    /**
+     * Index entries of a run of consecutive blocks, used to build the index in bulk while it is
+     * catching up with the chain. Blocks of a batch are read and decoded in parallel, the entries
+     * are then written to the index database in one go, in block order.
+     */
+    class SyncBatch
+    {
+    public:
+        virtual ~SyncBatch() = default;
+
+        /// Decode the n-th block of the batch. Called concurrently for different blocks, so this
+        /// must only touch the state of block n and must not access the index database.
+        virtual bool AddBlock(size_t n, const CBlock& block, const CBlockIndex* pindex) = 0;
+
+        /// Write the entries of all blocks of the batch to the index database
+        virtual bool Write() = 0;
+    };
+
+    /// Whether the index is built in batches through NewSyncBatch while syncing, instead of block
+    /// by block through WriteBlock
+    virtual bool SupportsSyncBatch() const { return false; }
+
+    /// Create a batch for n_blocks blocks, only called if SupportsSyncBatch(). Syncing a batch must
+    /// leave the index in the same state as calling WriteBlock on each of its blocks, and it must
+    /// be safe to sync a batch again after a crash.
+    virtual std::unique_ptr<SyncBatch> NewSyncBatch(size_t n_blocks) const { return nullptr; }
+
     /// Virtual method called internally by Commit that can be overridden to atomically
     /// commit more index state.
     virtual bool CommitInternal(CDBBatch& batch);
@@ -16,6 +16,9 @@
 #include <undo.h>
 #include <util/system.h>
 
+#include <algorithm>
+#include <iterator>
+
 constexpr uint8_t DB_SPENTINDEX{'p'};
 
 std::unique_ptr<SpentIndex> g_spentindex;
@@ -60,13 +63,9 @@ SpentIndex::SpentIndex(size_t n_cache_size, bool f_memory, bool f_wipe) :
 
 SpentIndex::~SpentIndex() = default;
 
-bool SpentIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+/** Derive the spent index entries of a connected block */
+static bool GetBlockEntries(const CBlock& block, const CBlockIndex* pindex, std::vector<CSpentIndexEntry>& entries)
 {
-    // Skip genesis block (no inputs to index)
-    if (pindex->nHeight == 0) {
-        return true;
-    }
-
     // Read undo data for this block to get information about spent outputs
     CBlockUndo blockundo;
     if (!node::UndoReadFromDisk(blockundo, pindex)) {
@@ -74,8 +73,6 @@ bool SpentIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
                      pindex->GetBlockHash().ToString(), pindex->nHeight);
     }
 
-    std::vector<CSpentIndexEntry> entries;
-
     // Process each non-coinbase transaction
     // blockundo.vtxundo[i] corresponds to block.vtx[i+1] (coinbase is skipped in undo data)
     if (blockundo.vtxundo.size() != block.vtx.size() - 1) {
@@ -110,9 +107,70 @@ bool SpentIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
         }
     }
 
+    return true;
+}
+
+bool SpentIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    // Skip genesis block (no inputs to index)
+    if (pindex->nHeight == 0) {
+        return true;
+    }
+
+    std::vector<CSpentIndexEntry> entries;
+    if (!GetBlockEntries(block, pindex, entries)) {
+        return false;
+    }
+
     return m_db->WriteBatch(entries);
 }
 
+class SpentIndex::SyncBatch final : public BaseIndex::SyncBatch
+{
+private:
+    SpentIndex::DB& m_db;
+    std::vector<std::vector<CSpentIndexEntry>> m_entries;
+
+public:
+    SyncBatch(SpentIndex::DB& db, size_t n_blocks) :
+        m_db{db},
+        m_entries(n_blocks)
+    {
+    }
+
+    bool AddBlock(size_t n, const CBlock& block, const CBlockIndex* pindex) override
+    {
+        if (pindex->nHeight == 0) {
+            return true;
+        }
+        return GetBlockEntries(block, pindex, m_entries[n]);
+    }
+
+    bool Write() override
+    {
+        // An outpoint can only be spent once on a chain, merge all keys into a single run in key order
+        size_t n_entries{0};
+        for (const auto& entries : m_entries) {
+            n_entries += entries.size();
+        }
+        std::vector<CSpentIndexEntry> entries;
+        entries.reserve(n_entries);
+        for (auto& block_entries : m_entries) {
+            std::move(block_entries.begin(), block_entries.end(), std::back_inserter(entries));
+        }
+        std::sort(entries.begin(), entries.end(), [](const CSpentIndexEntry& a, const CSpentIndexEntry& b) {
+            return CSpentIndexKeyCompare{}(a.first, b.first);
+        });
+
+        return m_db.WriteBatch(entries);
+    }
+};
+
+std::unique_ptr<BaseIndex::SyncBatch> SpentIndex::NewSyncBatch(size_t n_blocks) const
+{
+    return std::make_unique<SpentIndex::SyncBatch>(*m_db, n_blocks);
+}
+
 bool SpentIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
 {
     assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
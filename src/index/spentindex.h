@@ -51,8 +51,14 @@ protected:
         bool EraseSpentIndex(const std::vector<CSpentIndexKey>& keys);
     };
 
+    class SyncBatch;
+
     bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
 
+    /// Build the index in batches of blocks while syncing
+    bool SupportsSyncBatch() const override { return true; }
+    std::unique_ptr<BaseIndex::SyncBatch> NewSyncBatch(size_t n_blocks) const override;
+
     /// Custom rewind to handle spent index cleanup
     bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
 
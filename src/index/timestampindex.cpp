@@ -9,6 +9,8 @@
 #include <tinyformat.h>
 #include <util/system.h>
 
+#include <optional>
+
 constexpr uint8_t DB_TIMESTAMPINDEX{'s'};
 
 std::unique_ptr<TimestampIndex> g_timestampindex;
@@ -23,6 +25,15 @@ bool TimestampIndex::DB::Write(const CTimestampIndexKey& key)
     return CDBWrapper::Write(std::make_pair(DB_TIMESTAMPINDEX, key), true);
 }
 
+bool TimestampIndex::DB::WriteBatch(const std::vector<CTimestampIndexKey>& keys)
+{
+    CDBBatch batch(*this);
+    for (const auto& key : keys) {
+        batch.Write(std::make_pair(DB_TIMESTAMPINDEX, key), true);
+    }
+    return CDBWrapper::WriteBatch(batch);
+}
+
 bool TimestampIndex::DB::ReadRange(uint32_t high, uint32_t low, std::vector<uint256>& hashes)
 {
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
@@ -68,6 +79,43 @@ bool TimestampIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
     return m_db->Write(key);
 }
 
+class TimestampIndex::SyncBatch final : public BaseIndex::SyncBatch
+{
+private:
+    TimestampIndex::DB& m_db;
+    std::vector<std::optional<CTimestampIndexKey>> m_keys;
+
+public:
+    SyncBatch(TimestampIndex::DB& db, size_t n_blocks) :
+        m_db{db},
+        m_keys(n_blocks)
+    {
+    }
+
+    bool AddBlock(size_t n, const CBlock& block, const CBlockIndex* pindex) override
+    {
+        if (pindex->nHeight != 0) {
+            m_keys[n] = CTimestampIndexKey(pindex->nTime, pindex->GetBlockHash());
+        }
+        return true;
+    }
+
+    bool Write() override
+    {
+        std::vector<CTimestampIndexKey> keys;
+        keys.reserve(m_keys.size());
+        for (const auto& key : m_keys) {
+            if (key) keys.push_back(*key);
+        }
+        return m_db.WriteBatch(keys);
+    }
+};
+
+std::unique_ptr<BaseIndex::SyncBatch> TimestampIndex::NewSyncBatch(size_t n_blocks) const
+{
+    return std::make_unique<TimestampIndex::SyncBatch>(*m_db, n_blocks);
+}
+
 bool TimestampIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
 {
     assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
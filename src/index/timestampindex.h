@@ -33,6 +33,9 @@ protected:
         /// Write a timestamp index entry to the database
         bool Write(const CTimestampIndexKey& key);
 
+        /// Write a batch of timestamp index entries to the database
+        bool WriteBatch(const std::vector<CTimestampIndexKey>& keys);
+
         /// Read timestamp index entries within the given range
         bool ReadRange(uint32_t high, uint32_t low, std::vector<uint256>& hashes);
 
@@ -40,8 +43,14 @@ protected:
         bool EraseTimestampIndex(const CTimestampIndexKey& key);
     };
 
+    class SyncBatch;
+
     bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
 
+    /// Build the index in batches of blocks while syncing
+    bool SupportsSyncBatch() const override { return true; }
+    std::unique_ptr<BaseIndex::SyncBatch> NewSyncBatch(size_t n_blocks) const override;
+
     /// Custom rewind to handle timestamp index cleanup
     bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
 
@@ -38,6 +38,31 @@ bool InstantSendLock::TriviallyValid() const
     return inputs_set.size() == inputs.size();
 }
 
+CompactInstantSendLock::CompactInstantSendLock(const InstantSendLock& islock) :
+    nVersion{islock.nVersion},
+    txid{islock.txid},
+    cycleHash{islock.cycleHash},
+    sig{islock.sig}
+{
+}
+
+InstantSendLockPtr CompactInstantSendLock::Reconstruct(const CTransaction& tx) const
+{
+    if (tx.GetHash() != txid || tx.vin.size() > InstantSendLock::MAX_INPUTS) {
+        return nullptr;
+    }
+    auto islock = std::make_shared<InstantSendLock>();
+    islock->nVersion = nVersion;
+    islock->inputs.reserve(tx.vin.size());
+    for (const auto& in : tx.vin) {
+        islock->inputs.emplace_back(in.prevout);
+    }
+    islock->txid = txid;
+    islock->cycleHash = cycleHash;
+    islock->sig = sig;
+    return islock;
+}
+
 uint256 GenInputLockRequestId(const COutPoint& outpoint)
 {
     return ::SerializeHash(std::make_pair(INPUTLOCK_REQUESTID_PREFIX, outpoint));
@@ -15,6 +15,7 @@
 #include <vector>
 
 class COutPoint;
+class CTransaction;
 
 namespace instantsend {
 struct InstantSendLock {
@@ -50,9 +51,35 @@ struct InstantSendLock {
     bool TriviallyValid() const;
 };
 
-uint256 GenInputLockRequestId(const COutPoint& outpoint);
-
 using InstantSendLockPtr = std::shared_ptr<InstantSendLock>;
+
+/**
+ * An InstantSendLock without its inputs. These are always the outpoints spent by the
+ * locked transaction (in order), so a peer that has the transaction can rebuild the
+ * full lock and only the txid, cycleHash and signature need to go over the wire.
+ */
+struct CompactInstantSendLock {
+    uint8_t nVersion{InstantSendLock::CURRENT_VERSION};
+    uint256 txid;
+    uint256 cycleHash;
+    CBLSLazySignature sig;
+
+    CompactInstantSendLock() = default;
+    explicit CompactInstantSendLock(const InstantSendLock& islock);
+
+    SERIALIZE_METHODS(CompactInstantSendLock, obj)
+    {
+        READWRITE(obj.nVersion);
+        READWRITE(obj.txid);
+        READWRITE(obj.cycleHash);
+        READWRITE(obj.sig);
+    }
+
+    /** Rebuild the full lock, returns nullptr if tx is not the locked transaction */
+    InstantSendLockPtr Reconstruct(const CTransaction& tx) const;
+};
+
+uint256 GenInputLockRequestId(const COutPoint& outpoint);
 } // namespace instantsend
 
 #endif // BITCOIN_INSTANTSEND_LOCK_H
@@ -17,6 +17,7 @@
 #include <masternode/sync.h>
 #include <node/interface_ui.h>
 #include <util/thread.h>
+#include <util/time.h>
 #include <validation.h>
 
 #include <chrono>
@@ -242,17 +243,55 @@ Uint256HashSet GetIdsFromLockable(const std::vector<T>& vec)
 
 void NetInstantSend::ProcessMessage(CNode& pfrom, const std::string& msg_type, CDataStream& vRecv)
 {
-    if (msg_type != NetMsgType::ISDLOCK) {
+    if (msg_type != NetMsgType::ISDLOCK && msg_type != NetMsgType::ISDLOCKCMPCT) {
         return;
     }
 
     if (!m_is_manager.IsInstantSendEnabled()) return;
 
+    if (msg_type == NetMsgType::ISDLOCKCMPCT) {
+        instantsend::CompactInstantSendLock cmpct;
+        vRecv >> cmpct;
+        ProcessCompactISLock(pfrom.GetId(), std::move(cmpct));
+        return;
+    }
+
     auto islock = std::make_shared<instantsend::InstantSendLock>();
     vRecv >> *islock;
+    ProcessIncomingISLock(pfrom.GetId(), std::move(islock));
+}
 
-    const NodeId from = pfrom.GetId();
+void NetInstantSend::ProcessCompactISLock(NodeId from, instantsend::CompactInstantSendLock&& cmpct)
+{
+    uint256 hashBlock{};
+    if (auto tx = GetTransaction(nullptr, &m_mempool, cmpct.txid, Params().GetConsensus(), hashBlock)) {
+        if (auto islock = cmpct.Reconstruct(*tx)) {
+            ProcessIncomingISLock(from, std::move(islock));
+        } else {
+            m_peer_manager->PeerMisbehaving(from, INVALID_ISLOCK_MISBEHAVIOR_SCORE);
+        }
+        return;
+    }
+    if (m_is_manager.GetInstantSendLockByTxid(cmpct.txid) != nullptr) return;
 
+    // We don't know the transaction (anymore), keep the lock until it shows up in TransactionAddedToMempool
+    const auto now{GetTime<std::chrono::seconds>()};
+    const uint256 txid{cmpct.txid};
+    {
+        LOCK(cs_pending_compact);
+        std::erase_if(m_pending_compact, [&](const auto& entry) {
+            return entry.second.time + PENDING_COMPACT_ISLOCK_TIMEOUT < now;
+        });
+        if (m_pending_compact.size() >= MAX_PENDING_COMPACT_ISLOCKS) return;
+        if (!m_pending_compact.try_emplace(txid, PendingCompactISLock{from, std::move(cmpct), now}).second) return;
+    }
+    LogPrint(BCLog::INSTANTSEND, "NetInstantSend -- ISDLOCKCMPCT txid=%s: waiting for transaction, peer=%d\n",
+             txid.ToString(), from);
+    m_peer_manager->PeerAskPeersForTransaction(txid);
+}
+
+void NetInstantSend::ProcessIncomingISLock(NodeId from, instantsend::InstantSendLockPtr islock)
+{
     // Reject oversized locks before any O(n) work (hashing, dedup). A consensus-valid
     // transaction -- and therefore a valid islock -- can never exceed MAX_INPUTS inputs,
     // so this cannot drop a legitimate lock.
@@ -263,7 +302,7 @@ void NetInstantSend::ProcessMessage(CNode& pfrom, const std::string& msg_type, C
 
     uint256 hash = ::SerializeHash(*islock);
 
-    WITH_LOCK(::cs_main, m_peer_manager->PeerEraseObjectRequest(from, CInv{MSG_ISDLOCK, hash}));
+    m_peer_manager->PeerEraseObjectRequest(from, CInv{MSG_ISDLOCK, hash});
 
     if (!ValidateIncomingISLock(*islock, from)) {
         return;
@@ -438,7 +477,19 @@ void NetInstantSend::WorkThreadMain()
 
 void NetInstantSend::TransactionAddedToMempool(const CTransactionRef& tx, int64_t, uint64_t mempool_sequence)
 {
-    if (!m_is_manager.IsInstantSendEnabled() || !m_mn_sync.IsBlockchainSynced() || tx->vin.empty()) {
+    if (!m_is_manager.IsInstantSendEnabled()) {
+        return;
+    }
+
+    // Expired entries are only erased on the next insert, don't revive them here
+    auto pending = WITH_LOCK(cs_pending_compact, return m_pending_compact.extract(tx->GetHash()));
+    if (pending && pending.mapped().time + PENDING_COMPACT_ISLOCK_TIMEOUT >= GetTime<std::chrono::seconds>()) {
+        if (auto islock = pending.mapped().cmpct.Reconstruct(*tx)) {
+            ProcessIncomingISLock(pending.mapped().from, std::move(islock));
+        }
+    }
+
+    if (!m_mn_sync.IsBlockchainSynced() || tx->vin.empty()) {
         return;
     }
 
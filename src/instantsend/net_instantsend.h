@@ -5,10 +5,14 @@
 #ifndef BITCOIN_INSTANTSEND_NET_INSTANTSEND_H
 #define BITCOIN_INSTANTSEND_NET_INSTANTSEND_H
 
+#include <instantsend/lock.h>
 #include <net_processing.h>
+#include <saltedhasher.h>
+#include <sync.h>
 #include <util/threadinterrupt.h>
 #include <validationinterface.h>
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <thread>
@@ -28,8 +32,6 @@ class CMasternodeSync;
 class CTxMemPool;
 
 namespace instantsend {
-struct InstantSendLock;
-using InstantSendLockPtr = std::shared_ptr<InstantSendLock>;
 struct PendingISLockEntry;
 class InstantSendSigner;
 } // namespace instantsend
@@ -81,6 +83,19 @@ protected:
 private:
     struct BatchVerificationData;
 
+    /** A compact islock waiting for its transaction, see ProcessCompactISLock() */
+    struct PendingCompactISLock {
+        NodeId from;
+        instantsend::CompactInstantSendLock cmpct;
+        std::chrono::seconds time;
+    };
+    static constexpr size_t MAX_PENDING_COMPACT_ISLOCKS{1000};
+    static constexpr auto PENDING_COMPACT_ISLOCK_TIMEOUT{std::chrono::minutes{2}};
+
+    void ProcessIncomingISLock(NodeId from, instantsend::InstantSendLockPtr islock);
+    void ProcessCompactISLock(NodeId from, instantsend::CompactInstantSendLock&& cmpct)
+        EXCLUSIVE_LOCKS_REQUIRED(!cs_pending_compact);
+
     bool ValidateIncomingISLock(const instantsend::InstantSendLock& islock, NodeId node_id);
     std::optional<int> ResolveCycleHeight(const uint256& cycle_hash);
     bool ValidateDeterministicCycleHeight(int cycle_height, const Consensus::LLMQParams& llmq_params, NodeId node_id);
@@ -117,6 +132,9 @@ private:
     CTxMemPool& m_mempool;
     const CMasternodeSync& m_mn_sync;
 
+    Mutex cs_pending_compact;
+    Uint256HashMap<PendingCompactISLock> m_pending_compact GUARDED_BY(cs_pending_compact);
+
     std::thread workThread;
     CThreadInterrupt workInterrupt;
 };
@@ -320,8 +320,13 @@ bool CQuorumBlockProcessor::ProcessCommitment(int nHeight, const uint256& blockH
     }
 
     if (HasMinedCommitment(llmq_params.type, quorumHash)) {
-        // should not happen as it's already handled in ProcessBlock
-        return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-qc-dup");
+        // A UTXO snapshot stores its commitments before background validation connects the blocks they were
+        // mined in, these blocks must have the same commitment. Anything else should not happen as it's
+        // already handled in ProcessBlock.
+        const auto [minedQc, minedBlockHash] = GetMinedCommitment(llmq_params.type, quorumHash);
+        if (minedBlockHash != blockHash || ::SerializeHash(minedQc) != ::SerializeHash(qc)) {
+            return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-qc-dup");
+        }
     }
 
     if (!IsMiningPhase(llmq_params, m_chainstate.m_chain, nHeight)) {
@@ -419,6 +424,45 @@ bool CQuorumBlockProcessor::UndoBlock(const CBlock& block, gsl::not_null<const C
     return true;
 }
 
+bool CQuorumBlockProcessor::CheckSnapshotCommitment(const CFinalCommitment& qc, gsl::not_null<const CBlockIndex*> pMinedBlockIndex) const
+{
+    AssertLockHeld(::cs_main);
+
+    if (!Params().GetLLMQ(qc.llmqType).has_value() || qc.IsNull()) {
+        return false;
+    }
+
+    const CBlockIndex* pQuorumBaseBlockIndex = m_chainstate.m_blockman.LookupBlockIndex(qc.quorumHash);
+    if (pQuorumBaseBlockIndex == nullptr || pMinedBlockIndex->GetAncestor(pQuorumBaseBlockIndex->nHeight) != pQuorumBaseBlockIndex) {
+        LogPrint(BCLog::LLMQ, "%s -- type=%d, quorumHash=%s is not an ancestor of the mined block\n", __func__,
+                 std23::to_underlying(qc.llmqType), qc.quorumHash.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+void CQuorumBlockProcessor::AddSnapshotCommitment(const CFinalCommitment& qc, gsl::not_null<const CBlockIndex*> pMinedBlockIndex)
+{
+    AssertLockHeld(::cs_main);
+
+    const auto& llmq_params_opt = Params().GetLLMQ(qc.llmqType);
+    assert(llmq_params_opt.has_value());
+    const auto& llmq_params = llmq_params_opt.value();
+    const CBlockIndex* pQuorumBaseBlockIndex = m_chainstate.m_blockman.LookupBlockIndex(qc.quorumHash);
+    assert(pQuorumBaseBlockIndex != nullptr);
+
+    m_evoDb.Write(std::make_pair(DB_MINED_COMMITMENT, std::make_pair(llmq_params.type, qc.quorumHash)),
+                  std::make_pair(qc, pMinedBlockIndex->GetBlockHash()));
+    if (IsQuorumRotationEnabled(llmq_params, pQuorumBaseBlockIndex)) {
+        m_evoDb.Write(BuildInversedHeightKeyIndexed(llmq_params.type, pMinedBlockIndex->nHeight, int(qc.quorumIndex)), pQuorumBaseBlockIndex->nHeight);
+    } else {
+        m_evoDb.Write(BuildInversedHeightKey(llmq_params.type, pMinedBlockIndex->nHeight), pQuorumBaseBlockIndex->nHeight);
+    }
+
+    WITH_LOCK(minableCommitmentsCs, mapHasMinedCommitmentCache[qc.llmqType].erase(qc.quorumHash));
+}
+
 bool CQuorumBlockProcessor::GetCommitmentsFromBlock(const CBlock& block, gsl::not_null<const CBlockIndex*> pindex, std::multimap<Consensus::LLMQType, CFinalCommitment>& ret, BlockValidationState& state)
 {
     AssertLockHeld(::cs_main);
@@ -477,12 +521,22 @@ size_t CQuorumBlockProcessor::GetNumCommitmentsRequired(const Consensus::LLMQPar
 
     for (const auto quorumIndex : util::irange(quorums_num)) {
         uint256 quorumHash = GetQuorumBlockHash(llmqParams, m_chainstate.m_chain, nHeight, quorumIndex);
-        if (!quorumHash.IsNull() && !HasMinedCommitment(llmqParams.type, quorumHash)) ++ret;
+        if (quorumHash.IsNull()) continue;
+        if (!HasMinedCommitment(llmqParams.type, quorumHash) || !IsCommitmentMinedBelow(llmqParams.type, quorumHash, nHeight)) ++ret;
     }
 
     return ret;
 }
 
+bool CQuorumBlockProcessor::IsCommitmentMinedBelow(Consensus::LLMQType llmqType, const uint256& quorumHash, int nHeight) const
+{
+    AssertLockHeld(::cs_main);
+
+    const auto [_, minedBlockHash] = GetMinedCommitment(llmqType, quorumHash);
+    const CBlockIndex* pMinedBlockIndex = m_chainstate.m_blockman.LookupBlockIndex(minedBlockHash);
+    return pMinedBlockIndex == nullptr || pMinedBlockIndex->nHeight < nHeight;
+}
+
 // WARNING: This method returns uint256() on the first block of the DKG interval (because the block hash is not known yet)
 uint256 CQuorumBlockProcessor::GetQuorumBlockHash(const Consensus::LLMQParams& llmqParams, const CChain& active_chain, int nHeight, int quorumIndex)
 {
@@ -33,6 +33,10 @@ class CNode;
 
 extern RecursiveMutex cs_main; // NOLINT(readability-redundant-declaration)
 
+namespace evo_deterministicmns_tests {
+class TestQuorumBlockProcessor;
+} // namespace evo_deterministicmns_tests
+
 namespace llmq
 {
 class CFinalCommitment;
@@ -40,6 +44,7 @@ class CQuorumSnapshotManager;
 
 class CQuorumBlockProcessor
 {
+friend class ::evo_deterministicmns_tests::TestQuorumBlockProcessor; // for test access to commitment processing
 private:
     CChainState& m_chainstate;
     CDeterministicMNManager& m_dmnman;
@@ -69,6 +74,14 @@ public:
                       bool fJustCheck, bool fBLSChecks) EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
     bool UndoBlock(const CBlock& block, gsl::not_null<const CBlockIndex*> pindex)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
+    //! Check that a commitment of a UTXO snapshot can be stored as mined in pMinedBlockIndex
+    bool CheckSnapshotCommitment(const CFinalCommitment& qc, gsl::not_null<const CBlockIndex*> pMinedBlockIndex) const
+        EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    //! Store a commitment of a UTXO snapshot which passed CheckSnapshotCommitment. It was checked against the CbTx
+    //! of the snapshot base block instead of being verified when the block it was mined in got connected, which
+    //! background validation does later on.
+    void AddSnapshotCommitment(const CFinalCommitment& qc, gsl::not_null<const CBlockIndex*> pMinedBlockIndex)
+        EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
 
     //! it returns hash of commitment if it should be relay, otherwise nullopt
     std::optional<CInv> AddMineableCommitment(const CFinalCommitment& fqc) EXCLUSIVE_LOCKS_REQUIRED(!minableCommitmentsCs);
@@ -98,6 +111,10 @@ private:
                            bool fJustCheck) EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
     size_t GetNumCommitmentsRequired(const Consensus::LLMQParams& llmqParams, int nHeight) const
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
+    //! Whether the mined commitment of a quorum was mined below nHeight. Only commitments of a UTXO snapshot are
+    //! stored before the block they were mined in is connected.
+    bool IsCommitmentMinedBelow(Consensus::LLMQType llmqType, const uint256& quorumHash, int nHeight) const
+        EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     static uint256 GetQuorumBlockHash(const Consensus::LLMQParams& llmqParams, const CChain& active_chain, int nHeight, int quorumIndex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
 } // namespace llmq
@@ -385,6 +385,8 @@ void NetQuorum::CheckQuorumConnections(const Consensus::LLMQParams& llmqParams,
 {
     const bool is_masternode = m_role->IsMasternode();
     const uint256 proTxHash = is_masternode ? m_role->GetProTxHash() : uint256{};
+    const bool quorums_watch = is_masternode ? m_role->IsWatching() : true;
+    const bool all_members_connected = IsAllMembersConnectedEnabled(llmqParams.type, m_sporkman);
 
     auto lastQuorums = m_qman.ScanQuorums(llmqParams.type, pindexNew, (size_t)llmqParams.keepOldConnections);
     auto deletableQuorums = GetQuorumsToDelete(llmqParams, pindexNew);
@@ -393,45 +395,62 @@ void NetQuorum::CheckQuorumConnections(const Consensus::LLMQParams& llmqParams,
         llmqParams.type == Params().GetConsensus().llmqTypeDIP0024InstantSend &&
         std::ranges::any_of(lastQuorums, [&proTxHash](const auto& old_quorum) { return old_quorum->IsMember(proTxHash); });
 
+    LOCK(cs_connection_plans);
+
+    // Forget the plans of quorums which rotated out, their connections are dropped with deletableQuorums below
+    std::erase_if(m_connection_plans, [&](const auto& entry) {
+        const auto& [llmq_type, quorum_hash] = entry.first;
+        return llmq_type == llmqParams.type && std::ranges::none_of(lastQuorums, [&quorum_hash](const auto& quorum) {
+            return quorum->m_quorum_base_block_index->GetBlockHash() == quorum_hash;
+        });
+    });
+
     for (const auto& quorum : lastQuorums) {
-        if (EnsureQuorumConnections(llmqParams, m_connman, m_sporkman,
-                                           {m_dmnman, m_qsnapman, m_chainman, quorum->m_quorum_base_block_index},
-                                           m_dmnman.GetListAtChainTip(), proTxHash,
-                                           /*is_masternode=*/is_masternode,
-                                           /*quorums_watch=*/is_masternode ? m_role->IsWatching() : true)) {
-            if (deletableQuorums.erase(quorum->qc->quorumHash) > 0) {
-                LogPrint(BCLog::LLMQ, "NetQuorum::%s -- llmqType[%d] h[%d] keeping mn quorum connections for quorum: [%d:%s]\n",
-                         __func__, std23::to_underlying(llmqParams.type), pindexNew->nHeight,
-                         quorum->m_quorum_base_block_index->nHeight,
-                         quorum->m_quorum_base_block_index->GetBlockHash().ToString());
-            }
-        } else if (watchOtherISQuorums && !quorum->IsMember(proTxHash)) {
-            Uint256HashSet connections;
-            const auto& cindexes = utils::CalcDeterministicWatchConnections(llmqParams.type,
-                                                                             quorum->m_quorum_base_block_index,
-                                                                             quorum->members.size(), 1);
-            for (auto idx : cindexes) {
-                connections.emplace(quorum->members[idx]->proTxHash);
-            }
-            if (!connections.empty()) {
-                if (!m_connman.HasMasternodeQuorumNodes(llmqParams.type, quorum->m_quorum_base_block_index->GetBlockHash())) {
-                    LogPrint(BCLog::LLMQ, "NetQuorum::%s -- llmqType[%d] h[%d] adding mn inter-quorum connections for quorum: [%d:%s]\n",
-                             __func__, std23::to_underlying(llmqParams.type), pindexNew->nHeight,
-                             quorum->m_quorum_base_block_index->nHeight,
-                             quorum->m_quorum_base_block_index->GetBlockHash().ToString());
-                    m_connman.SetMasternodeQuorumNodes(llmqParams.type,
-                                                       quorum->m_quorum_base_block_index->GetBlockHash(), connections);
-                    m_connman.SetMasternodeQuorumRelayMembers(llmqParams.type,
-                                                              quorum->m_quorum_base_block_index->GetBlockHash(), connections);
+        const auto base_index = quorum->m_quorum_base_block_index;
+        const bool watch_other_is = watchOtherISQuorums && !quorum->IsMember(proTxHash);
+
+        // Only (re)compute the connections of quorums we haven't seen yet or if anything they depend on changed
+        auto [it, inserted] = m_connection_plans.try_emplace({llmqParams.type, base_index->GetBlockHash()});
+        auto& plan = it->second;
+        const bool recalc = inserted || plan.protx_hash != proTxHash || plan.all_members_connected != all_members_connected ||
+                            plan.quorums_watch != quorums_watch || plan.watch_other_is != watch_other_is;
+        if (recalc) {
+            plan.protx_hash = proTxHash;
+            plan.all_members_connected = all_members_connected;
+            plan.quorums_watch = quorums_watch;
+            plan.watch_other_is = watch_other_is;
+            plan.connections = CalcQuorumConnections(llmqParams, m_sporkman,
+                                                     {m_dmnman, m_qsnapman, m_chainman, base_index}, proTxHash,
+                                                     is_masternode, quorums_watch);
+            if (!plan.connections && watch_other_is) {
+                QuorumConnections connections;
+                const auto& cindexes = utils::CalcDeterministicWatchConnections(llmqParams.type, base_index,
+                                                                                 quorum->members.size(), 1);
+                for (auto idx : cindexes) {
+                    connections.connections.emplace(quorum->members[idx]->proTxHash);
                 }
-                if (deletableQuorums.erase(quorum->qc->quorumHash) > 0) {
-                    LogPrint(BCLog::LLMQ, "NetQuorum::%s -- llmqType[%d] h[%d] keeping mn inter-quorum connections for quorum: [%d:%s]\n",
+                if (!connections.connections.empty()) {
+                    LogPrint(BCLog::LLMQ, "NetQuorum::%s -- llmqType[%d] h[%d] adding mn inter-quorum connections for quorum: [%d:%s]\n",
                              __func__, std23::to_underlying(llmqParams.type), pindexNew->nHeight,
-                             quorum->m_quorum_base_block_index->nHeight,
-                             quorum->m_quorum_base_block_index->GetBlockHash().ToString());
+                             base_index->nHeight, base_index->GetBlockHash().ToString());
+                    connections.relay_members = connections.connections;
+                    plan.connections = std::move(connections);
                 }
             }
         }
+        if (!plan.connections) {
+            continue;
+        }
+
+        // Unchanged plans are only handed to connman again if it lost track of the quorum
+        if (recalc || !m_connman.HasMasternodeQuorumNodes(llmqParams.type, base_index->GetBlockHash())) {
+            ApplyQuorumConnections(llmqParams, m_connman, base_index, m_dmnman.GetListAtChainTip(), *plan.connections);
+        }
+        if (deletableQuorums.erase(quorum->qc->quorumHash) > 0) {
+            LogPrint(BCLog::LLMQ, "NetQuorum::%s -- llmqType[%d] h[%d] keeping mn quorum connections for quorum: [%d:%s]\n",
+                     __func__, std23::to_underlying(llmqParams.type), pindexNew->nHeight,
+                     base_index->nHeight, base_index->GetBlockHash().ToString());
+        }
     }
 
     for (const auto& quorumHash : deletableQuorums) {
@@ -708,33 +727,32 @@ void NetQuorum::StartCleanupOldQuorumDataThread(gsl::not_null<const CBlockIndex*
     });
 }
 
-bool EnsureQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman& connman, const CSporkManager& sporkman,
-                             const UtilParameters& util_params, const CDeterministicMNList& tip_mn_list,
-                             const uint256& myProTxHash, bool is_masternode, bool quorums_watch)
+std::optional<QuorumConnections> CalcQuorumConnections(const Consensus::LLMQParams& llmqParams, const CSporkManager& sporkman,
+                                                       const UtilParameters& util_params, const uint256& myProTxHash,
+                                                       bool is_masternode, bool quorums_watch)
 {
     if (!is_masternode && !quorums_watch) {
-        return false;
+        return std::nullopt;
     }
 
     auto members = utils::GetAllQuorumMembers(llmqParams.type, util_params);
     if (members.empty()) {
-        return false;
+        return std::nullopt;
     }
 
     bool isMember = std::ranges::find_if(members, [&](const auto& dmn) { return dmn->proTxHash == myProTxHash; }) !=
                     members.end();
 
     if (!isMember && !quorums_watch) {
-        return false;
+        return std::nullopt;
     }
 
     LogPrint(BCLog::NET_NETCONN, "%s -- isMember=%d for quorum %s:\n", __func__, isMember,
              util_params.m_base_index->GetBlockHash().ToString());
 
-    Uint256HashSet connections;
-    Uint256HashSet relayMembers;
+    QuorumConnections ret;
     if (isMember) {
-        connections = utils::GetQuorumConnections(llmqParams, sporkman, util_params, myProTxHash, /*onlyOutbound=*/true);
+        ret.connections = utils::GetQuorumConnections(llmqParams, sporkman, util_params, myProTxHash, /*onlyOutbound=*/true);
         // If all-members-connected is enabled for this quorum type, leverage the full-mesh
         // connections for low-latency recovered sig propagation by treating all members as
         // relay members (instead of the ring-based subset). This ensures peers will send
@@ -742,24 +760,32 @@ bool EnsureQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman&
         if (IsAllMembersConnectedEnabled(llmqParams.type, sporkman)) {
             for (const auto& dmn : members) {
                 if (dmn->proTxHash != myProTxHash) {
-                    relayMembers.emplace(dmn->proTxHash);
+                    ret.relay_members.emplace(dmn->proTxHash);
                 }
             }
         } else {
-            relayMembers = utils::GetQuorumRelayMembers(llmqParams, util_params, myProTxHash, true);
+            ret.relay_members = utils::GetQuorumRelayMembers(llmqParams, util_params, myProTxHash, true);
         }
     } else {
         auto cindexes = utils::CalcDeterministicWatchConnections(llmqParams.type, util_params.m_base_index, members.size(), 1);
         for (auto idx : cindexes) {
-            connections.emplace(members[idx]->proTxHash);
+            ret.connections.emplace(members[idx]->proTxHash);
         }
-        relayMembers = connections;
+        ret.relay_members = ret.connections;
     }
+    return ret;
+}
+
+void ApplyQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman& connman,
+                            gsl::not_null<const CBlockIndex*> base_index, const CDeterministicMNList& tip_mn_list,
+                            const QuorumConnections& quorum_connections)
+{
+    const auto& [connections, relayMembers] = quorum_connections;
     if (!connections.empty()) {
-        if (!connman.HasMasternodeQuorumNodes(llmqParams.type, util_params.m_base_index->GetBlockHash()) &&
+        if (!connman.HasMasternodeQuorumNodes(llmqParams.type, base_index->GetBlockHash()) &&
             LogAcceptDebug(BCLog::LLMQ)) {
             std::string debugMsg = strprintf("%s -- adding masternodes quorum connections for quorum %s:\n", __func__,
-                                             util_params.m_base_index->GetBlockHash().ToString());
+                                             base_index->GetBlockHash().ToString());
             for (const auto& c : connections) {
                 auto dmn = tip_mn_list.GetValidMN(c);
                 if (!dmn) {
@@ -771,11 +797,23 @@ bool EnsureQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman&
             }
             LogPrint(BCLog::NET_NETCONN, debugMsg.c_str()); /* Continued */
         }
-        connman.SetMasternodeQuorumNodes(llmqParams.type, util_params.m_base_index->GetBlockHash(), connections);
+        connman.SetMasternodeQuorumNodes(llmqParams.type, base_index->GetBlockHash(), connections);
     }
     if (!relayMembers.empty()) {
-        connman.SetMasternodeQuorumRelayMembers(llmqParams.type, util_params.m_base_index->GetBlockHash(), relayMembers);
+        connman.SetMasternodeQuorumRelayMembers(llmqParams.type, base_index->GetBlockHash(), relayMembers);
+    }
+}
+
+bool EnsureQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman& connman, const CSporkManager& sporkman,
+                             const UtilParameters& util_params, const CDeterministicMNList& tip_mn_list,
+                             const uint256& myProTxHash, bool is_masternode, bool quorums_watch)
+{
+    const auto quorum_connections = CalcQuorumConnections(llmqParams, sporkman, util_params, myProTxHash, is_masternode,
+                                                          quorums_watch);
+    if (!quorum_connections) {
+        return false;
     }
+    ApplyQuorumConnections(llmqParams, connman, util_params.m_base_index, tip_mn_list, *quorum_connections);
     return true;
 }
 
@@ -17,11 +17,13 @@
 #include <gsl/pointers.h>
 
 #include <map>
+#include <optional>
 
 class CActiveMasternodeManager;
 class CBlockIndex;
 class CBLSWorker;
 class CConnman;
+class CDeterministicMNList;
 class CDeterministicMNManager;
 class CMasternodeSync;
 class CSporkManager;
@@ -36,6 +38,12 @@ struct UtilParameters;
 } // namespace llmq
 
 namespace llmq {
+/** The masternodes we want to be connected to for a quorum and the ones we want recovered sigs from */
+struct QuorumConnections {
+    Uint256HashSet connections;
+    Uint256HashSet relay_members;
+};
+
 /**
  * NetHandler responsible for all quorum networking:
  *  - QGETDATA / QDATA message processing (quorum vvec and encrypted contribution exchange)
@@ -120,10 +128,35 @@ private:
     mutable std::map<Consensus::LLMQType, Uint256LruHashMap<uint256>> cleanupQuorumsCache
         GUARDED_BY(cs_cleanup);
 
+    /**
+     * The connections planned for every active quorum, across all LLMQ types. Quorum members and connections are
+     * fixed for the lifetime of a quorum, so they are only computed when a quorum rotates in (or when our identity,
+     * the relevant sporks or the watch status change) instead of on every tip update, and only quorums rotating in
+     * and out touch the connection sets in CConnman.
+     */
+    struct QuorumConnectionPlan {
+        //! Inputs the plan was computed for
+        uint256 protx_hash;
+        bool all_members_connected{false};
+        bool quorums_watch{false};
+        bool watch_other_is{false};
+        //! std::nullopt if we don't want connections for the quorum
+        std::optional<QuorumConnections> connections;
+    };
+    mutable Mutex cs_connection_plans;
+    mutable std::map<std::pair<Consensus::LLMQType, uint256>, QuorumConnectionPlan> m_connection_plans
+        GUARDED_BY(cs_connection_plans);
+
     mutable ctpl::thread_pool workerPool;
     mutable CThreadInterrupt quorumThreadInterrupt;
 };
 
+std::optional<QuorumConnections> CalcQuorumConnections(const Consensus::LLMQParams& llmqParams, const CSporkManager& sporkman,
+                                                       const UtilParameters& util_params, const uint256& myProTxHash,
+                                                       bool is_masternode, bool quorums_watch);
+void ApplyQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman& connman,
+                            gsl::not_null<const CBlockIndex*> base_index, const CDeterministicMNList& tip_mn_list,
+                            const QuorumConnections& quorum_connections);
 bool EnsureQuorumConnections(const Consensus::LLMQParams& llmqParams, CConnman& connman, const CSporkManager& sporkman,
                              const UtilParameters& util_params, const CDeterministicMNList& tip_mn_list,
                              const uint256& myProTxHash, bool is_masternode, bool quorums_watch);
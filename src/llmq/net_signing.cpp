@@ -30,8 +30,7 @@ void NetSigning::ProcessMessage(CNode& pfrom, const std::string& msg_type, CData
         auto recoveredSig = std::make_shared<CRecoveredSig>();
         vRecv >> *recoveredSig;
 
-        WITH_LOCK(cs_main, m_peer_manager->PeerEraseObjectRequest(pfrom.GetId(), CInv{MSG_QUORUM_RECOVERED_SIG,
-                                                                                      recoveredSig->GetHash()}));
+        m_peer_manager->PeerEraseObjectRequest(pfrom.GetId(), CInv{MSG_QUORUM_RECOVERED_SIG, recoveredSig->GetHash()});
 
         if (!Params().GetLLMQ(recoveredSig->getLlmqType()).has_value()) {
             m_peer_manager->PeerMisbehaving(pfrom.GetId(), 100);
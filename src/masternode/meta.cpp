@@ -8,15 +8,11 @@
 #include <univalue.h>
 #include <util/time.h>
 
-const std::string MasternodeMetaStore::SERIALIZATION_VERSION_STRING = "CMasternodeMetaMan-Version-5";
+const std::string MasternodeMetaStore::SERIALIZATION_VERSION_STRING = "CMasternodeMetaMan-Version-6";
 
 static constexpr int MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS{5};
 static constexpr int MASTERNODE_MAX_MIXING_TXES{5};
 
-namespace {
-static const CMasternodeMetaInfo default_meta_info{};
-} // anonymous namespace
-
 CMasternodeMetaMan::CMasternodeMetaMan() :
     m_db{std::make_unique<db_type>("mncache.dat", "magicMasternodeCache")}
 {
@@ -38,15 +34,18 @@ bool CMasternodeMetaMan::LoadCache(bool load_cache)
 UniValue CMasternodeMetaInfo::ToJson() const
 {
     int64_t now = GetTime<std::chrono::seconds>().count();
+    const int64_t last_outbound_attempt{lastOutboundAttempt};
+    const int64_t last_outbound_success{lastOutboundSuccess};
 
     UniValue ret(UniValue::VOBJ);
-    ret.pushKV("lastDSQ", m_last_dsq);
-    ret.pushKV("mixingTxCount", m_mixing_tx_count);
-    ret.pushKV("outboundAttemptCount", outboundAttemptCount);
-    ret.pushKV("lastOutboundAttempt", lastOutboundAttempt);
-    ret.pushKV("lastOutboundAttemptElapsed", now - lastOutboundAttempt);
-    ret.pushKV("lastOutboundSuccess", lastOutboundSuccess);
-    ret.pushKV("lastOutboundSuccessElapsed", now - lastOutboundSuccess);
+    ret.pushKV("lastDSQ", m_last_dsq.load());
+    ret.pushKV("mixingTxCount", m_mixing_tx_count.load());
+    ret.pushKV("outboundAttemptCount", outboundAttemptCount.load());
+    ret.pushKV("lastOutboundAttempt", last_outbound_attempt);
+    ret.pushKV("lastOutboundAttemptElapsed", now - last_outbound_attempt);
+    ret.pushKV("lastOutboundSuccess", last_outbound_success);
+    ret.pushKV("lastOutboundSuccessElapsed", now - last_outbound_success);
+    LOCK(cs);
     ret.pushKV("is_platform_banned", m_platform_ban);
     ret.pushKV("platform_ban_height_updated", m_platform_ban_updated);
 
@@ -55,89 +54,99 @@ UniValue CMasternodeMetaInfo::ToJson() const
 
 void CMasternodeMetaInfo::AddGovernanceVote(const uint256& nGovernanceObjectHash)
 {
+    AddGovernanceVote(nGovernanceObjectHash, 1);
+}
+
+void CMasternodeMetaInfo::AddGovernanceVote(const uint256& nGovernanceObjectHash, int votes)
+{
+    LOCK(cs);
     // Insert a zero value, or not. Then increment the value regardless. This
     // ensures the value is in the map.
     const auto& pair = mapGovernanceObjectsVotedOn.emplace(nGovernanceObjectHash, 0);
-    pair.first->second++;
+    pair.first->second += votes;
 }
 
 void CMasternodeMetaInfo::RemoveGovernanceObject(const uint256& nGovernanceObjectHash)
 {
+    LOCK(cs);
     // Whether or not the govobj hash exists in the map first is irrelevant.
     mapGovernanceObjectsVotedOn.erase(nGovernanceObjectHash);
 }
 
-const CMasternodeMetaInfo& CMasternodeMetaMan::GetMetaInfoOrDefault(const uint256& protx_hash) const
+CMasternodeMetaInfoPtr CMasternodeMetaMan::FindMetaInfo(const uint256& protx_hash) const
 {
+    READ_LOCK(cs);
     const auto it = metaInfos.find(protx_hash);
-    if (it == metaInfos.end()) return default_meta_info;
+    if (it == metaInfos.end()) return nullptr;
     return it->second;
 }
 
 CMasternodeMetaInfo CMasternodeMetaMan::GetInfo(const uint256& proTxHash) const
 {
-    LOCK(cs);
-    return GetMetaInfoOrDefault(proTxHash);
+    if (const auto meta_info = FindMetaInfo(proTxHash)) {
+        return *meta_info;
+    }
+    return CMasternodeMetaInfo{};
 }
 
-CMasternodeMetaInfo& CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash)
+CMasternodeMetaInfoPtr CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash)
 {
-    auto it = metaInfos.find(proTxHash);
-    if (it != metaInfos.end()) {
-        return it->second;
+    if (auto meta_info = FindMetaInfo(proTxHash)) {
+        return meta_info;
+    }
+    LOCK(cs);
+    // Another thread might have inserted the entry between the two locks, try_emplace keeps it in that case
+    auto it = metaInfos.try_emplace(proTxHash, nullptr).first;
+    if (it->second == nullptr) {
+        it->second = std::make_shared<CMasternodeMetaInfo>(proTxHash);
     }
-    it = metaInfos.emplace(proTxHash, CMasternodeMetaInfo{proTxHash}).first;
     return it->second;
 }
 
 bool CMasternodeMetaMan::IsMixingThresholdExceeded(const uint256& protx_hash, int mn_count) const
 {
-    LOCK(cs);
-    auto it = metaInfos.find(protx_hash);
-    if (it == metaInfos.end()) {
+    const auto meta_info = FindMetaInfo(protx_hash);
+    if (meta_info == nullptr) {
         LogPrint(BCLog::COINJOIN, "DSQUEUE -- node %s is logged\n", protx_hash.ToString());
         return false;
     }
-    const auto& meta_info = it->second;
-    int64_t last_dsq = meta_info.m_last_dsq;
+    int64_t last_dsq = meta_info->m_last_dsq;
     int64_t threshold = last_dsq + mn_count / 5;
+    int64_t dsq_count = nDsqCount;
 
     LogPrint(BCLog::COINJOIN, "DSQUEUE -- mn: %s last_dsq: %d  dsq_threshold: %d  nDsqCount: %d\n",
-             protx_hash.ToString(), last_dsq, threshold, nDsqCount);
-    return last_dsq != 0 && threshold > nDsqCount;
+             protx_hash.ToString(), last_dsq, threshold, dsq_count);
+    return last_dsq != 0 && threshold > dsq_count;
 }
 
 void CMasternodeMetaMan::AllowMixing(const uint256& proTxHash)
 {
-    LOCK(cs);
-    auto& mm = GetMetaInfo(proTxHash);
-    mm.m_last_dsq = ++nDsqCount;
-    mm.m_mixing_tx_count = 0;
+    auto mm = GetMetaInfo(proTxHash);
+    mm->m_last_dsq = ++nDsqCount;
+    mm->m_mixing_tx_count = 0;
 }
 
 void CMasternodeMetaMan::DisallowMixing(const uint256& proTxHash)
 {
-    LOCK(cs);
-    GetMetaInfo(proTxHash).m_mixing_tx_count++;
+    GetMetaInfo(proTxHash)->m_mixing_tx_count++;
 }
 
 bool CMasternodeMetaMan::IsValidForMixingTxes(const uint256& protx_hash) const
 {
-    LOCK(cs);
-    return GetMetaInfoOrDefault(protx_hash).m_mixing_tx_count <= MASTERNODE_MAX_MIXING_TXES;
+    const auto meta_info = FindMetaInfo(protx_hash);
+    return meta_info == nullptr || meta_info->m_mixing_tx_count <= MASTERNODE_MAX_MIXING_TXES;
 }
 
 void CMasternodeMetaMan::AddGovernanceVote(const uint256& proTxHash, const uint256& nGovernanceObjectHash)
 {
-    LOCK(cs);
-    GetMetaInfo(proTxHash).AddGovernanceVote(nGovernanceObjectHash);
+    GetMetaInfo(proTxHash)->AddGovernanceVote(nGovernanceObjectHash);
 }
 
 void CMasternodeMetaMan::RemoveGovernanceObject(const uint256& nGovernanceObjectHash)
 {
-    LOCK(cs);
-    for (auto& [_, meta_info] : metaInfos) {
-        meta_info.RemoveGovernanceObject(nGovernanceObjectHash);
+    READ_LOCK(cs);
+    for (const auto& [_, meta_info] : metaInfos) {
+        meta_info->RemoveGovernanceObject(nGovernanceObjectHash);
     }
 }
 
@@ -150,58 +159,53 @@ std::vector<uint256> CMasternodeMetaMan::GetAndClearDirtyGovernanceObjectHashes(
 
 void CMasternodeMetaMan::SetLastOutboundAttempt(const uint256& protx_hash, int64_t t)
 {
-    LOCK(cs);
-    GetMetaInfo(protx_hash).SetLastOutboundAttempt(t);
+    GetMetaInfo(protx_hash)->SetLastOutboundAttempt(t);
 }
 
 void CMasternodeMetaMan::SetLastOutboundSuccess(const uint256& protx_hash, int64_t t)
 {
-    LOCK(cs);
-    GetMetaInfo(protx_hash).SetLastOutboundSuccess(t);
+    GetMetaInfo(protx_hash)->SetLastOutboundSuccess(t);
 }
 
 int64_t CMasternodeMetaMan::GetLastOutboundAttempt(const uint256& protx_hash) const
 {
-    LOCK(cs);
-    return GetMetaInfoOrDefault(protx_hash).lastOutboundAttempt;
+    const auto meta_info = FindMetaInfo(protx_hash);
+    return meta_info ? meta_info->lastOutboundAttempt.load() : 0;
 }
 
 int64_t CMasternodeMetaMan::GetLastOutboundSuccess(const uint256& protx_hash) const
 {
-    LOCK(cs);
-    return GetMetaInfoOrDefault(protx_hash).lastOutboundSuccess;
+    const auto meta_info = FindMetaInfo(protx_hash);
+    return meta_info ? meta_info->lastOutboundSuccess.load() : 0;
 }
 
 bool CMasternodeMetaMan::OutboundFailedTooManyTimes(const uint256& protx_hash) const
 {
-    LOCK(cs);
-    return GetMetaInfoOrDefault(protx_hash).outboundAttemptCount > MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS;
+    const auto meta_info = FindMetaInfo(protx_hash);
+    return meta_info && meta_info->outboundAttemptCount > MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS;
 }
 
 bool CMasternodeMetaMan::IsPlatformBanned(const uint256& protx_hash) const
 {
-    LOCK(cs);
-    return GetMetaInfoOrDefault(protx_hash).m_platform_ban;
+    const auto meta_info = FindMetaInfo(protx_hash);
+    return meta_info && meta_info->IsPlatformBanned();
 }
 
 bool CMasternodeMetaMan::ResetPlatformBan(const uint256& protx_hash, int height)
 {
-    LOCK(cs);
-
-    auto it = metaInfos.find(protx_hash);
-    if (it == metaInfos.end()) return false;
+    const auto meta_info = FindMetaInfo(protx_hash);
+    if (meta_info == nullptr) return false;
 
-    return it->second.SetPlatformBan(false, height);
+    return meta_info->SetPlatformBan(false, height);
 }
 
 bool CMasternodeMetaMan::SetPlatformBan(const uint256& inv_hash, PlatformBanMessage&& ban_msg)
 {
-    LOCK(cs);
-
     const uint256& protx_hash = ban_msg.m_protx_hash;
 
-    bool ret = GetMetaInfo(protx_hash).SetPlatformBan(true, ban_msg.m_requested_height);
+    bool ret = GetMetaInfo(protx_hash)->SetPlatformBan(true, ban_msg.m_requested_height);
     if (ret) {
+        LOCK(cs);
         m_seen_platform_bans.emplace(inv_hash, std::move(ban_msg));
     }
     return ret;
@@ -247,21 +251,21 @@ void CMasternodeMetaMan::RemoveUsedMasternodes(size_t count)
 
 size_t CMasternodeMetaMan::GetUsedMasternodesCount() const
 {
-    LOCK(cs);
+    READ_LOCK(cs);
     return m_used_masternodes.size();
 }
 
 bool CMasternodeMetaMan::IsUsedMasternode(const uint256& proTxHash) const
 {
-    LOCK(cs);
+    READ_LOCK(cs);
     return m_used_masternodes_set.find(proTxHash) != m_used_masternodes_set.end();
 }
 
 std::string MasternodeMetaStore::ToString() const
 {
-    LOCK(cs);
+    READ_LOCK(cs);
     return strprintf("Masternodes: meta infos object count: %d, nDsqCount: %d, used masternodes count: %d",
-                     metaInfos.size(), nDsqCount, m_used_masternodes.size());
+                     metaInfos.size(), nDsqCount.load(), m_used_masternodes.size());
 }
 
 uint256 PlatformBanMessage::GetHash() const { return ::SerializeHash(*this); }
@@ -13,8 +13,11 @@
 #include <uint256.h>
 #include <unordered_lru_cache.h>
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -25,26 +28,32 @@ class CFlatDB;
 
 // Holds extra (non-deterministic) information about masternodes
 // This is mostly local information, e.g. about mixing and governance
+//
+// Counters that are bumped from connection and mixing code paths are atomics so that they can be updated
+// without holding any lock, the remaining fields are protected by the per-entry mutex.
 class CMasternodeMetaInfo
 {
+private:
+    mutable Mutex cs;
+
 public:
     uint256 m_protx_hash;
 
     //! the dsq count from the last dsq broadcast of this node
-    int64_t m_last_dsq{0};
-    int m_mixing_tx_count{0};
+    std::atomic<int64_t> m_last_dsq{0};
+    std::atomic<int> m_mixing_tx_count{0};
 
     // KEEP TRACK OF GOVERNANCE ITEMS EACH MASTERNODE HAS VOTE UPON FOR RECALCULATION
-    std::map<uint256, int> mapGovernanceObjectsVotedOn;
+    std::map<uint256, int> mapGovernanceObjectsVotedOn GUARDED_BY(cs);
 
-    int outboundAttemptCount{0};
-    int64_t lastOutboundAttempt{0};
-    int64_t lastOutboundSuccess{0};
+    std::atomic<int> outboundAttemptCount{0};
+    std::atomic<int64_t> lastOutboundAttempt{0};
+    std::atomic<int64_t> lastOutboundSuccess{0};
 
     //! bool flag is node currently under platform ban by p2p message
-    bool m_platform_ban{false};
+    bool m_platform_ban GUARDED_BY(cs){false};
     //! height at which platform ban has been applied or removed
-    int m_platform_ban_updated{0};
+    int m_platform_ban_updated GUARDED_BY(cs){0};
 
 public:
     CMasternodeMetaInfo() = default;
@@ -52,26 +61,56 @@ public:
         m_protx_hash(protx_hash)
     {
     }
-    CMasternodeMetaInfo(const CMasternodeMetaInfo& ref) = default;
+    CMasternodeMetaInfo(const CMasternodeMetaInfo& ref) EXCLUSIVE_LOCKS_REQUIRED(!ref.cs) :
+        m_protx_hash(ref.m_protx_hash),
+        m_last_dsq(ref.m_last_dsq.load()),
+        m_mixing_tx_count(ref.m_mixing_tx_count.load()),
+        outboundAttemptCount(ref.outboundAttemptCount.load()),
+        lastOutboundAttempt(ref.lastOutboundAttempt.load()),
+        lastOutboundSuccess(ref.lastOutboundSuccess.load())
+    {
+        LOCK(ref.cs);
+        mapGovernanceObjectsVotedOn = ref.mapGovernanceObjectsVotedOn;
+        m_platform_ban = ref.m_platform_ban;
+        m_platform_ban_updated = ref.m_platform_ban_updated;
+    }
 
+    // Only fixed-width fields are serialized here so that every record has the same on-disk size,
+    // governance votes are stored separately by MasternodeMetaStore, see below
     SERIALIZE_METHODS(CMasternodeMetaInfo, obj)
     {
-        READWRITE(obj.m_protx_hash, obj.m_last_dsq, obj.m_mixing_tx_count, obj.mapGovernanceObjectsVotedOn,
-                  obj.outboundAttemptCount, obj.lastOutboundAttempt, obj.lastOutboundSuccess, obj.m_platform_ban,
-                  obj.m_platform_ban_updated);
+        LOCK(obj.cs);
+        READWRITE(obj.m_protx_hash, obj.m_last_dsq, obj.m_mixing_tx_count, obj.outboundAttemptCount,
+                  obj.lastOutboundAttempt, obj.lastOutboundSuccess, obj.m_platform_ban, obj.m_platform_ban_updated);
     }
 
-    UniValue ToJson() const;
+    //! Size of a single serialized record
+    static constexpr size_t RECORD_SIZE{32 + 8 + 4 + 4 + 8 + 8 + 1 + 4};
+
+    UniValue ToJson() const EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     // KEEP TRACK OF EACH GOVERNANCE ITEM IN CASE THIS NODE GOES OFFLINE, SO WE CAN RECALCULATE THEIR STATUS
-    void AddGovernanceVote(const uint256& nGovernanceObjectHash);
-    void RemoveGovernanceObject(const uint256& nGovernanceObjectHash);
+    void AddGovernanceVote(const uint256& nGovernanceObjectHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    void AddGovernanceVote(const uint256& nGovernanceObjectHash, int votes) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    void RemoveGovernanceObject(const uint256& nGovernanceObjectHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    std::map<uint256, int> GetGovernanceVotes() const EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    {
+        LOCK(cs);
+        return mapGovernanceObjectsVotedOn;
+    }
 
     void SetLastOutboundAttempt(int64_t t) { lastOutboundAttempt = t; ++outboundAttemptCount; }
     void SetLastOutboundSuccess(int64_t t) { lastOutboundSuccess = t; outboundAttemptCount = 0; }
 
-    bool SetPlatformBan(bool is_banned, int height)
+    bool IsPlatformBanned() const EXCLUSIVE_LOCKS_REQUIRED(!cs)
     {
+        LOCK(cs);
+        return m_platform_ban;
+    }
+
+    bool SetPlatformBan(bool is_banned, int height) EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    {
+        LOCK(cs);
         if (height < m_platform_ban_updated) {
             return false;
         }
@@ -83,33 +122,75 @@ public:
         return true;
     }
 };
+using CMasternodeMetaInfoPtr = std::shared_ptr<CMasternodeMetaInfo>;
 
+/**
+ * Entries are stored as shared pointers in a hash map guarded by a shared mutex. Looking up an
+ * existing entry only needs a read lock, and once the entry is found its hot counters are updated
+ * through atomics after the store lock has been released. The exclusive lock is only taken when
+ * a new masternode is inserted or the store itself is modified.
+ */
 class MasternodeMetaStore
 {
 protected:
     static const std::string SERIALIZATION_VERSION_STRING;
 
-    mutable Mutex cs;
-    std::map<uint256, CMasternodeMetaInfo> metaInfos GUARDED_BY(cs);
+    mutable SharedMutex cs;
+    Uint256HashMap<CMasternodeMetaInfoPtr> metaInfos GUARDED_BY(cs);
     // keep track of dsq count to prevent masternodes from gaming coinjoin queue
-    int64_t nDsqCount GUARDED_BY(cs){0};
+    std::atomic<int64_t> nDsqCount{0};
     // keep track of the used Masternodes for CoinJoin across all wallets
     // Using deque for efficient FIFO removal and unordered_set for O(1) lookups
     std::deque<uint256> m_used_masternodes GUARDED_BY(cs);
     Uint256HashSet m_used_masternodes_set GUARDED_BY(cs);
 
 public:
+    /**
+     * On-disk layout (all integers are little-endian and fixed-width):
+     *
+     *   version string
+     *   uint32 record count, followed by that many fixed-size CMasternodeMetaInfo records sorted by proTxHash
+     *   uint32 vote count, followed by that many (uint32 record index, uint256 object hash, int32 vote count) entries
+     *   int64 dsq count
+     *   vector of used masternodes
+     *
+     * Records are written in proTxHash order so that the file is independent of hash map iteration order,
+     * governance votes reference their masternode by record index instead of repeating the proTxHash.
+     */
     template<typename Stream>
     void Serialize(Stream &s) const EXCLUSIVE_LOCKS_REQUIRED(!cs)
     {
-        LOCK(cs);
-        std::vector<CMasternodeMetaInfo> tmpMetaInfo;
-        for (const auto& p : metaInfos) {
-            tmpMetaInfo.emplace_back(p.second);
+        READ_LOCK(cs);
+        std::vector<CMasternodeMetaInfoPtr> records;
+        records.reserve(metaInfos.size());
+        for (const auto& [_, meta_info] : metaInfos) {
+            records.emplace_back(meta_info);
+        }
+        std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+            return a->m_protx_hash < b->m_protx_hash;
+        });
+
+        s << SERIALIZATION_VERSION_STRING;
+
+        s << static_cast<uint32_t>(records.size());
+        std::vector<std::map<uint256, int>> votes;
+        votes.reserve(records.size());
+        uint32_t vote_count{0};
+        for (const auto& meta_info : records) {
+            s << *meta_info;
+            vote_count += votes.emplace_back(meta_info->GetGovernanceVotes()).size();
+        }
+
+        s << vote_count;
+        for (uint32_t record_index = 0; record_index < votes.size(); ++record_index) {
+            for (const auto& [obj_hash, count] : votes[record_index]) {
+                s << record_index << obj_hash << static_cast<int32_t>(count);
+            }
         }
+
         // Convert deque to vector for serialization - unordered_set will be rebuilt on deserialization
         std::vector<uint256> tmpUsedMasternodes(m_used_masternodes.begin(), m_used_masternodes.end());
-        s << SERIALIZATION_VERSION_STRING << tmpMetaInfo << nDsqCount << tmpUsedMasternodes;
+        s << nDsqCount << tmpUsedMasternodes;
     }
 
     template<typename Stream>
@@ -123,13 +204,36 @@ public:
         if (strVersion != SERIALIZATION_VERSION_STRING) {
             return;
         }
-        std::vector<CMasternodeMetaInfo> tmpMetaInfo;
-        std::vector<uint256> tmpUsedMasternodes;
-        s >> tmpMetaInfo >> nDsqCount >> tmpUsedMasternodes;
-        for (auto& mm : tmpMetaInfo) {
-            metaInfos.emplace(mm.m_protx_hash, CMasternodeMetaInfo{mm});
+
+        uint32_t record_count;
+        s >> record_count;
+        std::vector<CMasternodeMetaInfoPtr> records;
+        for (uint32_t i = 0; i < record_count; ++i) {
+            auto meta_info = std::make_shared<CMasternodeMetaInfo>();
+            s >> *meta_info;
+            if (!records.empty() && !(records.back()->m_protx_hash < meta_info->m_protx_hash)) {
+                throw std::ios_base::failure("MasternodeMetaStore: records are not sorted");
+            }
+            metaInfos.emplace(meta_info->m_protx_hash, meta_info);
+            records.emplace_back(std::move(meta_info));
         }
 
+        uint32_t vote_count;
+        s >> vote_count;
+        for (uint32_t i = 0; i < vote_count; ++i) {
+            uint32_t record_index;
+            uint256 obj_hash;
+            int32_t votes;
+            s >> record_index >> obj_hash >> votes;
+            if (record_index >= records.size()) {
+                throw std::ios_base::failure("MasternodeMetaStore: vote references unknown record");
+            }
+            records[record_index]->AddGovernanceVote(obj_hash, votes);
+        }
+
+        std::vector<uint256> tmpUsedMasternodes;
+        s >> nDsqCount >> tmpUsedMasternodes;
+
         // Convert vector to deque and build unordered_set for O(1) lookups
         m_used_masternodes.assign(tmpUsedMasternodes.begin(), tmpUsedMasternodes.end());
         m_used_masternodes_set.clear();
@@ -200,8 +304,10 @@ private:
     mutable unordered_lru_cache<uint256, PlatformBanMessage, StaticSaltedHasher> m_seen_platform_bans GUARDED_BY(cs){
         SeenBanInventorySize};
 
-    CMasternodeMetaInfo& GetMetaInfo(const uint256& proTxHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    const CMasternodeMetaInfo& GetMetaInfoOrDefault(const uint256& proTxHash) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+    //! Returns the entry for proTxHash, creating it if it doesn't exist yet
+    CMasternodeMetaInfoPtr GetMetaInfo(const uint256& proTxHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    //! Returns the entry for proTxHash or nullptr, never creates a new entry
+    CMasternodeMetaInfoPtr FindMetaInfo(const uint256& proTxHash) const EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
 public:
     CMasternodeMetaMan(const CMasternodeMetaMan&) = delete;
@@ -225,7 +331,7 @@ public:
     void DisallowMixing(const uint256& proTxHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     bool IsValidForMixingTxes(const uint256& protx_hash) const EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
-    void AddGovernanceVote(const uint256& proTxHash, const uint256& nGovernanceObjectHash);
+    void AddGovernanceVote(const uint256& proTxHash, const uint256& nGovernanceObjectHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     void RemoveGovernanceObject(const uint256& nGovernanceObjectHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     std::vector<uint256> GetAndClearDirtyGovernanceObjectHashes() EXCLUSIVE_LOCKS_REQUIRED(!cs);
@@ -13,8 +13,7 @@
 
 #include <algorithm>
 
-void CMasternodeUtils::DoMaintenance(CConnman& connman, CDeterministicMNManager& dmnman, const CMasternodeSync& mn_sync,
-                                     CJWalletManager* const cj_walletman)
+void CMasternodeUtils::DoMaintenance(CConnman& connman, const CMasternodeSync& mn_sync, CJWalletManager* const cj_walletman)
 {
     if (!mn_sync.IsBlockchainSynced()) return;
     if (ShutdownRequested()) return;
@@ -46,9 +45,8 @@ void CMasternodeUtils::DoMaintenance(CConnman& connman, CDeterministicMNManager&
             // we're only disconnecting m_masternode_connection connections
             if (!pnode->m_masternode_connection) return;
             if (!pnode->GetVerifiedProRegTxHash().IsNull()) {
-                const auto tip_mn_list = dmnman.GetListAtChainTip();
                 // keep _verified_ LLMQ connections
-                if (connman.IsMasternodeQuorumNode(pnode, tip_mn_list)) {
+                if (connman.IsMasternodeQuorumNode(pnode)) {
                     return;
                 }
                 // keep _verified_ LLMQ relay connections
@@ -6,15 +6,13 @@
 #define BITCOIN_MASTERNODE_UTILS_H
 
 class CConnman;
-class CDeterministicMNManager;
 class CMasternodeSync;
 class CJWalletManager;
 
 class CMasternodeUtils
 {
 public:
-    static void DoMaintenance(CConnman& connman, CDeterministicMNManager& dmnman, const CMasternodeSync& mn_sync,
-                              CJWalletManager* const cj_walletman);
+    static void DoMaintenance(CConnman& connman, const CMasternodeSync& mn_sync, CJWalletManager* const cj_walletman);
 };
 
 #endif // BITCOIN_MASTERNODE_UTILS_H
@@ -138,7 +138,96 @@ size_t CSerializedNetMsg::GetMemoryUsage() const noexcept
     // Don't count the dynamic memory used for the m_type string, by assuming it fits in the
     // "small string" optimization area (which stores data inside the object itself, up to some
     // size; 15 bytes in modern libstdc++).
-    return sizeof(*this) + memusage::DynamicUsage(data);
+    // A shared payload is counted in full for every peer it is queued for. This keeps send buffer
+    // limits, which bound how far each individual peer can fall behind, independent of sharing.
+    return sizeof(*this) + memusage::DynamicUsage(data) + (m_shared ? memusage::DynamicUsage(m_shared->data) : 0);
+}
+
+void CSerializedNetMsg::MakeShared()
+{
+    if (m_shared) return;
+    auto shared = std::make_shared<SharedPayload>();
+    shared->hash = Hash(data);
+    shared->data = std::move(data);
+    ClearShrink(data);
+    m_shared = std::move(shared);
+}
+
+void CSerializedNetMsg::ClearPayload() noexcept
+{
+    ClearShrink(data);
+    m_shared.reset();
+}
+
+SendPriority GetSendPriority(const std::string& msg_type)
+{
+    // MNAUTH has to follow VERSION/VERACK and precede any quorum traffic, keep them in one class
+    if (msg_type == NetMsgType::VERSION ||
+        msg_type == NetMsgType::VERACK ||
+        msg_type == NetMsgType::MNAUTH ||
+        msg_type == NetMsgType::QSENDRECSIGS ||
+        msg_type == NetMsgType::QWATCH) {
+        return SendPriority::HIGH;
+    }
+    if (IsQuorumPriorityMessage(msg_type) ||
+        msg_type == NetMsgType::QCONTRIB ||
+        msg_type == NetMsgType::QCOMPLAINT ||
+        msg_type == NetMsgType::QJUSTIFICATION ||
+        msg_type == NetMsgType::QPCOMMITMENT) {
+        return SendPriority::HIGH;
+    }
+    // BLOCK and MERKLEBLOCK are deliberately not here, the hashContinue INV of a getblocks response and
+    // the matched transactions of BIP37 have to follow them
+    if (msg_type == NetMsgType::MNLISTDIFF ||
+        msg_type == NetMsgType::QUORUMROTATIONINFO ||
+        msg_type == NetMsgType::QDATA ||
+        msg_type == NetMsgType::MNGOVERNANCEOBJECT ||
+        msg_type == NetMsgType::MNGOVERNANCEOBJECTVOTE) {
+        return SendPriority::BULK;
+    }
+    return SendPriority::NORMAL;
+}
+
+void SendQueue::push_back(CSerializedNetMsg&& msg, SendPriority priority)
+{
+    m_queues[static_cast<size_t>(priority)].push_back(std::move(msg));
+    ++m_size;
+}
+
+size_t SendQueue::NextClass() const
+{
+    assert(m_size > 0);
+    for (size_t i = SEND_PRIORITY_COUNT; i-- > 0;) {
+        if (!m_queues[i].empty() && m_skipped[i] >= MAX_SKIPPED) return i;
+    }
+    size_t i{0};
+    while (m_queues[i].empty()) ++i;
+    return i;
+}
+
+CSerializedNetMsg& SendQueue::front()
+{
+    return m_queues[NextClass()].front();
+}
+
+void SendQueue::pop_front()
+{
+    const size_t next = NextClass();
+    m_queues[next].pop_front();
+    --m_size;
+    m_skipped[next] = 0;
+    for (size_t i = next + 1; i < SEND_PRIORITY_COUNT; ++i) {
+        if (!m_queues[i].empty()) ++m_skipped[i];
+    }
+}
+
+void SendQueue::clear()
+{
+    for (auto& queue : m_queues) {
+        queue.clear();
+    }
+    m_skipped.fill(0);
+    m_size = 0;
 }
 
 void CConnman::AddAddrFetch(const std::string& strDest)
@@ -817,13 +906,13 @@ bool V1Transport::SetMessageToSend(CSerializedNetMsg& msg) noexcept
     AssertLockNotHeld(m_send_mutex);
     // Determine whether a new message can be set.
     LOCK(m_send_mutex);
-    if (m_sending_header || m_bytes_sent < m_message_to_send.data.size()) return false;
+    if (m_sending_header || m_bytes_sent < m_message_to_send.Payload().size()) return false;
 
-    // create dbl-sha256 checksum
-    uint256 hash = Hash(msg.data);
+    // create dbl-sha256 checksum, shared payloads have it precomputed
+    uint256 hash = msg.m_shared ? msg.m_shared->hash : Hash(msg.data);
 
     // create header
-    CMessageHeader hdr(m_magic_bytes, msg.m_type.c_str(), msg.data.size());
+    CMessageHeader hdr(m_magic_bytes, msg.m_type.c_str(), msg.Payload().size());
     memcpy(hdr.pchChecksum, hash.begin(), CMessageHeader::CHECKSUM_SIZE);
 
     // serialize header
@@ -845,11 +934,11 @@ Transport::BytesToSend V1Transport::GetBytesToSend(bool have_next_message) const
         return {Span{m_header_to_send}.subspan(m_bytes_sent),
                 // We have more to send after the header if the message has payload, or if there
                 // is a next message after that.
-                have_next_message || !m_message_to_send.data.empty(),
+                have_next_message || !m_message_to_send.Payload().empty(),
                 m_message_to_send.m_type
                };
     } else {
-        return {Span{m_message_to_send.data}.subspan(m_bytes_sent),
+        return {m_message_to_send.Payload().subspan(m_bytes_sent),
                 // We only have more to send after this message's payload if there is another
                 // message.
                 have_next_message,
@@ -867,9 +956,10 @@ void V1Transport::MarkBytesSent(size_t bytes_sent) noexcept
         // We're done sending a message's header. Switch to sending its data bytes.
         m_sending_header = false;
         m_bytes_sent = 0;
-    } else if (!m_sending_header && m_bytes_sent == m_message_to_send.data.size()) {
-        // We're done sending a message's data. Wipe the data vector to reduce memory consumption.
-        ClearShrink(m_message_to_send.data);
+    } else if (!m_sending_header && m_bytes_sent == m_message_to_send.Payload().size()) {
+        // We're done sending a message's data. Wipe the data vector (or drop our reference to the
+        // shared one) to reduce memory consumption.
+        m_message_to_send.ClearPayload();
         m_bytes_sent = 0;
     }
 }
@@ -1578,23 +1668,25 @@ bool V2Transport::SetMessageToSend(CSerializedNetMsg& msg) noexcept
 
     if (short_message_id.has_value() && m_peer_version >= GetMessageMinVersion(msg.m_type)) {
         // Use short encoding (1 byte)
-        contents.resize(1 + msg.data.size());
+        const auto payload{msg.Payload()};
+        contents.resize(1 + payload.size());
         contents[0] = *short_message_id;
-        std::copy(msg.data.begin(), msg.data.end(), contents.begin() + 1);
+        std::copy(payload.begin(), payload.end(), contents.begin() + 1);
     } else {
         // Use long encoding (13 bytes for message type)
         // Initialize with zeroes, and then write the message type string starting at offset 1.
         // This means contents[0] and the unused positions in contents[1..13] remain 0x00.
-        contents.resize(1 + CMessageHeader::COMMAND_SIZE + msg.data.size(), 0);
+        const auto payload{msg.Payload()};
+        contents.resize(1 + CMessageHeader::COMMAND_SIZE + payload.size(), 0);
         std::copy(msg.m_type.begin(), msg.m_type.end(), contents.data() + 1);
-        std::copy(msg.data.begin(), msg.data.end(), contents.begin() + 1 + CMessageHeader::COMMAND_SIZE);
+        std::copy(payload.begin(), payload.end(), contents.begin() + 1 + CMessageHeader::COMMAND_SIZE);
     }
     // Construct ciphertext in send buffer.
     m_send_buffer.resize(contents.size() + BIP324Cipher::EXPANSION);
     m_cipher.Encrypt(MakeByteSpan(contents), {}, false, MakeWritableByteSpan(m_send_buffer));
     m_send_type = msg.m_type;
     // Release memory
-    ClearShrink(msg.data);
+    msg.ClearPayload();
     return true;
 }
 
@@ -1693,24 +1785,24 @@ Transport::Info V2Transport::GetInfo() const noexcept
 
 std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
 {
-    auto it = node.vSendMsg.begin();
     size_t nSentSize = 0;
     bool data_left{false}; //!< second return value (whether unsent data remains)
     std::optional<bool> expected_more;
 
     while (true) {
-        if (it != node.vSendMsg.end()) {
-            // If possible, move one message from the send queue to the transport. This fails when
-            // there is an existing message still being sent, or (for v2 transports) when the
-            // handshake has not yet completed.
-            size_t memusage = it->GetMemoryUsage();
-            if (node.m_transport->SetMessageToSend(*it)) {
-                // Update memory usage of send buffer (as *it will be deleted).
+        if (!node.vSendMsg.empty()) {
+            // If possible, move the next message by priority from the send queue to the transport.
+            // This fails when there is an existing message still being sent, or (for v2 transports)
+            // when the handshake has not yet completed.
+            auto& msg = node.vSendMsg.front();
+            size_t memusage = msg.GetMemoryUsage();
+            if (node.m_transport->SetMessageToSend(msg)) {
+                // Update memory usage of send buffer (as msg will be deleted).
                 node.m_send_memusage -= memusage;
-                ++it;
+                node.vSendMsg.pop_front();
             }
         }
-        const auto& [data, more, msg_type] = node.m_transport->GetBytesToSend(it != node.vSendMsg.end());
+        const auto& [data, more, msg_type] = node.m_transport->GetBytesToSend(!node.vSendMsg.empty());
         // We rely on the 'more' value returned by GetBytesToSend to correctly predict whether more
         // bytes are still to be sent, to correctly set the MSG_MORE flag. As a sanity check,
         // verify that the previously returned 'more' was correct.
@@ -1764,10 +1856,9 @@ std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
 
     node.fPauseSend = node.m_send_memusage + node.m_transport->GetSendMemoryUsage() > nSendBufferMaxSize;
 
-    if (it == node.vSendMsg.end()) {
+    if (node.vSendMsg.empty()) {
         assert(node.m_send_memusage == 0);
     }
-    node.vSendMsg.erase(node.vSendMsg.begin(), it);
     node.nSendMsgSize = node.vSendMsg.size();
     return {nSentSize, data_left};
 }
@@ -2420,7 +2511,7 @@ void CConnman::SocketHandler(CMasternodeSync& mn_sync)
         // select(2)). If none are ready, wait for a short while and return
         // empty sets.
         events_per_sock = GenerateWaitSockets(snap.Nodes());
-        if ((is_lt && events_per_sock.empty()) || !Sock::WaitManyInternal(timeout, events_per_sock, SocketEventsParams{socketEventsMode, GetModeFileDescriptor(), ToggleWakeupPipe})) {
+        if ((is_lt && events_per_sock.empty()) || !Sock::WaitManyInternal(timeout, events_per_sock, SocketEventsParams{socketEventsMode, GetModeFileDescriptor(), ToggleWakeupPipe, m_edge_trig_events.get()})) {
             if (is_lt) {
                 interruptNet.sleep_for(std::chrono::milliseconds(SELECT_TIMEOUT_MILLISECONDS));
             }
@@ -2914,7 +3005,7 @@ bool CConnman::MaybePickPreferredNetwork(std::optional<Network>& network)
     return false;
 }
 
-void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, CDeterministicMNManager& dmnman)
+void CConnman::ThreadOpenConnections(const std::vector<std::string> connect)
 {
     AssertLockNotHeld(m_unused_i2p_sessions_mutex);
     AssertLockNotHeld(m_reconnections_mutex);
@@ -3149,8 +3240,6 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, CDe
 
         addrman.ResolveCollisions();
 
-        auto mnList = dmnman.GetListAtChainTip();
-
         const auto current_time{NodeClock::now()};
         int nTries = 0;
         while (!interruptNet)
@@ -3257,7 +3346,7 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, CDe
             }
 
             // don't try to connect to masternodes that we already have a connection to (most likely inbound)
-            if (auto dmn = mnList.GetMNByService(addr); dmn && setConnectedMasternodes.count(dmn->proTxHash)) {
+            if (const auto proTxHash = GetMasternodeByService(addr); !proTxHash.IsNull() && setConnectedMasternodes.count(proTxHash)) {
                 continue;
             }
 
@@ -3441,46 +3530,46 @@ void CConnman::ThreadOpenMasternodeConnections(CDeterministicMNManager& dmnman,
         const auto getPendingQuorumNodes = [&]() SHARED_LOCKS_REQUIRED(m_nodes_mutex) EXCLUSIVE_LOCKS_REQUIRED(cs_vPendingMasternodes) {
             AssertSharedLockHeld(m_nodes_mutex);
             AssertLockHeld(cs_vPendingMasternodes);
-            std::vector<CDeterministicMNCPtr> ret;
-            for (const auto& group : masternodeQuorumNodes) {
-                for (const auto& proRegTxHash : group.second) {
-                    if (connectedProRegTxHashes.count(proRegTxHash)) {
-                        continue;
-                    }
-                    auto dmn = mnList.GetMN(proRegTxHash);
-                    if (!dmn) {
-                        continue;
-                    }
-                    const auto addr2 = dmn->pdmnState->netInfo->GetPrimary();
-                    CNode* pnode = FindNodeMutable(addr2, /*fExcludeDisconnecting=*/false);
-                    if (pnode && (pnode->m_masternode_connection || pnode->fDisconnect)) {
-                        // node is either a masternode or disconnecting, skip it
-                        continue;
-                    }
-                    if (connectedNodes.count(addr2)) {
-                        // we probably connected to it before it became a masternode
-                        // or maybe we are still waiting for mnauth
-                        bool slow_handshake = pnode && pnode->nTimeFirstMessageReceived.load() != 0s &&
-                                             GetTime<std::chrono::seconds>() - pnode->nTimeFirstMessageReceived.load() > 5s;
-                        if (slow_handshake) {
-                            // clearly not expecting mnauth to take that long even if it wasn't the first message
-                            // we received (as it should normally), disconnect
-                            LogPrint(BCLog::NET_NETCONN, "CConnman::%s -- dropping non-mnauth connection to %s, service=%s\n",
-                                                         _func_, proRegTxHash.ToString(), addr2.ToStringAddrPort());
-                            pnode->fDisconnect = true;
-                        }
-                        // either way - it's not ready, skip it for now
-                        continue;
-                    }
-                    // back off connecting to an address if we already tried recently
-                    int64_t last_attempt = mn_metaman.GetLastOutboundAttempt(dmn->proTxHash);
-                    if (nANow - last_attempt < chainParams.LLMQConnectionRetryTimeout()) {
-                        continue;
+            std::vector<std::pair</*quorum_count=*/size_t, CDeterministicMNCPtr>> ret;
+            for (const auto& [proRegTxHash, quorum_count] : m_quorum_node_refs) {
+                if (connectedProRegTxHashes.count(proRegTxHash)) {
+                    continue;
+                }
+                auto dmn = mnList.GetMN(proRegTxHash);
+                if (!dmn) {
+                    continue;
+                }
+                const auto addr2 = dmn->pdmnState->netInfo->GetPrimary();
+                CNode* pnode = FindNodeMutable(addr2, /*fExcludeDisconnecting=*/false);
+                if (pnode && (pnode->m_masternode_connection || pnode->fDisconnect)) {
+                    // node is either a masternode or disconnecting, skip it
+                    continue;
+                }
+                if (connectedNodes.count(addr2)) {
+                    // we probably connected to it before it became a masternode
+                    // or maybe we are still waiting for mnauth
+                    bool slow_handshake = pnode && pnode->nTimeFirstMessageReceived.load() != 0s &&
+                                         GetTime<std::chrono::seconds>() - pnode->nTimeFirstMessageReceived.load() > 5s;
+                    if (slow_handshake) {
+                        // clearly not expecting mnauth to take that long even if it wasn't the first message
+                        // we received (as it should normally), disconnect
+                        LogPrint(BCLog::NET_NETCONN, "CConnman::%s -- dropping non-mnauth connection to %s, service=%s\n",
+                                                     _func_, proRegTxHash.ToString(), addr2.ToStringAddrPort());
+                        pnode->fDisconnect = true;
                     }
-                    // all checks passed
-                    ret.emplace_back(dmn);
+                    // either way - it's not ready, skip it for now
+                    continue;
+                }
+                // back off connecting to an address if we already tried recently
+                int64_t last_attempt = mn_metaman.GetLastOutboundAttempt(dmn->proTxHash);
+                if (nANow - last_attempt < chainParams.LLMQConnectionRetryTimeout()) {
+                    continue;
                 }
+                // all checks passed
+                ret.emplace_back(quorum_count, dmn);
             }
+            // Masternodes which are needed by more quorums first
+            std::ranges::sort(ret, std::greater{}, [](const auto& p) { return p.first; });
             return ret;
         };
 
@@ -3535,8 +3624,10 @@ void CConnman::ThreadOpenMasternodeConnections(CDeterministicMNManager& dmnman,
             }
 
             if (const auto pending = getPendingQuorumNodes(); !pending.empty()) {
+                // pick randomly among the masternodes with the highest priority
+                const auto top_count = std::ranges::count_if(pending, [&](const auto& p) { return p.first == pending.front().first; });
                 // not-null
-                auto dmn = pending[GetRand(pending.size())];
+                auto dmn = pending[GetRand(top_count)].second;
                 LogPrint(BCLog::NET_NETCONN, "CConnman::%s -- opening quorum connection to %s, service=%s\n",
                          _func_, dmn->proTxHash.ToString(), dmn->pdmnState->netInfo->GetPrimary().ToStringAddrPort());
                 return dmn;
@@ -3982,7 +4073,8 @@ bool CConnman::Start(CDeterministicMNManager& dmnman, CMasternodeMetaMan& mn_met
     AssertLockNotHeld(m_total_bytes_sent_mutex);
     Init(connOptions);
 
-    if (socketEventsMode == SocketEventsMode::EPoll || socketEventsMode == SocketEventsMode::KQueue) {
+    if (socketEventsMode == SocketEventsMode::EPoll || socketEventsMode == SocketEventsMode::KQueue ||
+        socketEventsMode == SocketEventsMode::IOUring) {
         m_edge_trig_events = std::make_unique<EdgeTriggeredEvents>(socketEventsMode);
         if (!m_edge_trig_events->IsValid()) {
             LogPrintf("Unable to initialize EdgeTriggeredEvents instance\n");
@@ -4078,7 +4170,7 @@ bool CConnman::Start(CDeterministicMNManager& dmnman, CMasternodeMetaMan& mn_met
     if (connOptions.m_use_addrman_outgoing || !connOptions.m_specified_outgoing.empty()) {
         threadOpenConnections = std::thread(
             &util::TraceThread, "opencon",
-            [this, connect = connOptions.m_specified_outgoing, &dmnman] { ThreadOpenConnections(connect, dmnman); });
+            [this, connect = connOptions.m_specified_outgoing] { ThreadOpenConnections(connect); });
     }
 
     // Initiate masternode connections
@@ -4341,22 +4433,46 @@ bool CConnman::AddPendingMasternode(const uint256& proTxHash)
     return true;
 }
 
+/**
+ * Replace the member set of a quorum with new_members, updating the number of quorums each masternode is part of.
+ * Returns false if the set did not change.
+ */
+static bool UpdateQuorumMembers(Uint256HashSet& members, const Uint256HashSet& new_members, Uint256HashMap<size_t>& refs)
+{
+    if (members == new_members) {
+        return false;
+    }
+    for (const auto& proTxHash : members) {
+        if (new_members.contains(proTxHash)) continue;
+        auto it = refs.find(proTxHash);
+        assert(it != refs.end());
+        if (--it->second == 0) {
+            refs.erase(it);
+        }
+    }
+    for (const auto& proTxHash : new_members) {
+        if (!members.contains(proTxHash)) {
+            ++refs[proTxHash];
+        }
+    }
+    members = new_members;
+    return true;
+}
+
 void CConnman::SetMasternodeQuorumNodes(Consensus::LLMQType llmqType, const uint256& quorumHash, const Uint256HashSet& proTxHashes)
 {
     LOCK(cs_vPendingMasternodes);
-    auto it = masternodeQuorumNodes.emplace(std::make_pair(llmqType, quorumHash), proTxHashes);
-    if (!it.second) {
-        it.first->second = proTxHashes;
-    }
+    UpdateQuorumMembers(masternodeQuorumNodes[std::make_pair(llmqType, quorumHash)], proTxHashes, m_quorum_node_refs);
 }
 
 void CConnman::SetMasternodeQuorumRelayMembers(Consensus::LLMQType llmqType, const uint256& quorumHash, const Uint256HashSet& proTxHashes)
 {
     {
         LOCK(cs_vPendingMasternodes);
-        auto it = masternodeQuorumRelayMembers.emplace(std::make_pair(llmqType, quorumHash), proTxHashes);
-        if (!it.second) {
-            it.first->second = proTxHashes;
+        if (!UpdateQuorumMembers(masternodeQuorumRelayMembers[std::make_pair(llmqType, quorumHash)], proTxHashes,
+                                 m_quorum_relay_refs)) {
+            // Nothing new, no need to walk the existing connections
+            return;
         }
     }
 
@@ -4423,37 +4539,36 @@ std::vector<NodeId> CConnman::GetMasternodeQuorumNodes(Consensus::LLMQType llmqT
 void CConnman::RemoveMasternodeQuorumNodes(Consensus::LLMQType llmqType, const uint256& quorumHash)
 {
     LOCK(cs_vPendingMasternodes);
-    masternodeQuorumNodes.erase(std::make_pair(llmqType, quorumHash));
-    masternodeQuorumRelayMembers.erase(std::make_pair(llmqType, quorumHash));
+    const auto key{std::make_pair(llmqType, quorumHash)};
+    if (auto it = masternodeQuorumNodes.find(key); it != masternodeQuorumNodes.end()) {
+        UpdateQuorumMembers(it->second, {}, m_quorum_node_refs);
+        masternodeQuorumNodes.erase(it);
+    }
+    if (auto it = masternodeQuorumRelayMembers.find(key); it != masternodeQuorumRelayMembers.end()) {
+        UpdateQuorumMembers(it->second, {}, m_quorum_relay_refs);
+        masternodeQuorumRelayMembers.erase(it);
+    }
 }
 
-bool CConnman::IsMasternodeQuorumNode(const CNode* pnode, const CDeterministicMNList& tip_mn_list) const
+bool CConnman::IsMasternodeQuorumNode(const CNode* pnode) const
 {
     // Let's see if this is an outgoing connection to an address that is known to be a masternode
     // We however only need to know this if the node did not authenticate itself as a MN yet
     uint256 assumedProTxHash;
     if (pnode->GetVerifiedProRegTxHash().IsNull() && !pnode->IsInboundConn()) {
-        auto dmn = tip_mn_list.GetMNByService(pnode->addr);
-        if (dmn == nullptr) {
+        assumedProTxHash = GetMasternodeByService(pnode->addr);
+        if (assumedProTxHash.IsNull()) {
             // This is definitely not a masternode
             return false;
         }
-        assumedProTxHash = dmn->proTxHash;
     }
 
-    LOCK(cs_vPendingMasternodes);
-    for (const auto& p : masternodeQuorumNodes) {
-        if (!pnode->GetVerifiedProRegTxHash().IsNull()) {
-            if (p.second.count(pnode->GetVerifiedProRegTxHash())) {
-                return true;
-            }
-        } else if (!assumedProTxHash.IsNull()) {
-            if (p.second.count(assumedProTxHash)) {
-                return true;
-            }
-        }
+    const uint256 proTxHash{pnode->GetVerifiedProRegTxHash().IsNull() ? assumedProTxHash : pnode->GetVerifiedProRegTxHash()};
+    if (proTxHash.IsNull()) {
+        return false;
     }
-    return false;
+    LOCK(cs_vPendingMasternodes);
+    return m_quorum_node_refs.contains(proTxHash);
 }
 
 bool CConnman::IsMasternodeQuorumRelayMember(const uint256& protxHash)
@@ -4462,12 +4577,7 @@ bool CConnman::IsMasternodeQuorumRelayMember(const uint256& protxHash)
         return false;
     }
     LOCK(cs_vPendingMasternodes);
-    for (const auto& p : masternodeQuorumRelayMembers) {
-        if (p.second.count(protxHash)) {
-            return true;
-        }
-    }
-    return false;
+    return m_quorum_relay_refs.contains(protxHash);
 }
 
 void CConnman::AddPendingProbeConnections(const Uint256HashSet& proTxHashes)
@@ -4476,6 +4586,73 @@ void CConnman::AddPendingProbeConnections(const Uint256HashSet& proTxHashes)
     masternodePendingProbes.insert(proTxHashes.begin(), proTxHashes.end());
 }
 
+/** Call func for every service entry of a masternode state */
+template <typename Func>
+static void ForEachMasternodeService(const CDeterministicMNState& state, Func&& func)
+{
+    if (!state.netInfo) return;
+    for (const auto& entry : state.netInfo->GetEntries()) {
+        if (const auto service_opt{entry.GetAddrPort()}) {
+            func(*service_opt);
+        }
+    }
+}
+
+void CConnman::SetMasternodeServices(const CDeterministicMNList& mn_list)
+{
+    LOCK(m_masternode_services_mutex);
+    m_masternode_services.clear();
+    mn_list.ForEachMN(/*onlyValid=*/false, [&](const auto& dmn) {
+        ForEachMasternodeService(*dmn.pdmnState, [&](const CService& service) {
+            m_masternode_services.emplace(service, dmn.proTxHash);
+        });
+    });
+    m_masternode_services_initialized = true;
+}
+
+void CConnman::UpdateMasternodeServices(const CDeterministicMNList& old_mn_list, const CDeterministicMNListDiff& diff)
+{
+    if (WITH_LOCK(m_masternode_services_mutex, return !m_masternode_services_initialized)) {
+        SetMasternodeServices(old_mn_list);
+    }
+
+    LOCK(m_masternode_services_mutex);
+    const auto erase_services = [&](const CDeterministicMN& dmn) {
+        ForEachMasternodeService(*dmn.pdmnState, [&](const CService& service) {
+            // Don't erase the entry if the service was taken over by another masternode in the meantime
+            if (auto it = m_masternode_services.find(service); it != m_masternode_services.end() && it->second == dmn.proTxHash) {
+                m_masternode_services.erase(it);
+            }
+        });
+    };
+    for (const auto internal_id : diff.removedMns) {
+        if (const auto dmn = old_mn_list.GetMNByInternalId(internal_id)) {
+            erase_services(*dmn);
+        }
+    }
+    for (const auto& [internal_id, state_diff] : diff.updatedMNs) {
+        if (!(state_diff.fields & CDeterministicMNStateDiff::Field_netInfo)) continue;
+        if (const auto dmn = old_mn_list.GetMNByInternalId(internal_id)) {
+            erase_services(*dmn);
+            ForEachMasternodeService(state_diff.state, [&](const CService& service) {
+                m_masternode_services.insert_or_assign(service, dmn->proTxHash);
+            });
+        }
+    }
+    for (const auto& dmn : diff.addedMNs) {
+        ForEachMasternodeService(*dmn->pdmnState, [&](const CService& service) {
+            m_masternode_services.insert_or_assign(service, dmn->proTxHash);
+        });
+    }
+}
+
+uint256 CConnman::GetMasternodeByService(const CService& addr) const
+{
+    LOCK(m_masternode_services_mutex);
+    const auto it = m_masternode_services.find(addr);
+    return it != m_masternode_services.end() ? it->second : uint256{};
+}
+
 size_t CConnman::GetNodeCount(ConnectionDirection flags) const
 {
     READ_LOCK(m_nodes_mutex);
@@ -4758,8 +4935,16 @@ void CNode::MarkReceivedMsgsForProcessing()
     m_msg_quorum_queue_size += nQuorumSizeAdded;
     m_msg_process_queue.splice(m_msg_process_queue.end(), normalMsgs);
     m_msg_process_queue_size += nNormalSizeAdded;
-    // Compute backpressure over combined size of both queues
-    fPauseRecv = (m_msg_quorum_queue_size + m_msg_process_queue_size) > m_recv_flood_size;
+    // Compute backpressure over combined size of all queues
+    UpdatePauseRecv();
+}
+
+void CNode::AccountForDispatchedMsg(int64_t nBytes)
+{
+    LOCK(m_msg_process_queue_mutex);
+    assert(nBytes >= 0 || m_msg_dispatch_queue_size >= size_t(-nBytes));
+    m_msg_dispatch_queue_size += nBytes;
+    UpdatePauseRecv();
 }
 
 std::optional<std::pair<CNetMessage, bool>> CNode::PollMessage()
@@ -4788,8 +4973,8 @@ std::optional<std::pair<CNetMessage, bool>> CNode::PollMessage()
         if (!m_msg_process_queue.empty()) {
             ++m_quorum_msg_count_since_normal;
         }
-        // Compute backpressure over combined size of both queues
-        fPauseRecv = (m_msg_quorum_queue_size + m_msg_process_queue_size) > m_recv_flood_size;
+        // Compute backpressure over combined size of all queues
+        UpdatePauseRecv();
         // Return true for 'more' if either queue has remaining messages
         return std::make_pair(std::move(msgs.front()), !m_msg_quorum_queue.empty() || !m_msg_process_queue.empty());
     }
@@ -4802,8 +4987,8 @@ std::optional<std::pair<CNetMessage, bool>> CNode::PollMessage()
     msgs.splice(msgs.begin(), m_msg_process_queue, m_msg_process_queue.begin());
     m_msg_process_queue_size -= msgs.front().m_raw_message_size;
     m_quorum_msg_count_since_normal = 0; // Reset counter after processing normal message
-    // Compute backpressure over combined size of both queues
-    fPauseRecv = (m_msg_quorum_queue_size + m_msg_process_queue_size) > m_recv_flood_size;
+    // Compute backpressure over combined size of all queues
+    UpdatePauseRecv();
 
     return std::make_pair(std::move(msgs.front()), !m_msg_quorum_queue.empty() || !m_msg_process_queue.empty());
 }
@@ -4816,10 +5001,11 @@ bool CConnman::NodeFullyConnected(const CNode* pnode)
 void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 {
     AssertLockNotHeld(m_total_bytes_sent_mutex);
-    size_t nMessageSize = msg.data.size();
+    const auto payload{msg.Payload()};
+    size_t nMessageSize = payload.size();
     LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n", msg.m_type, nMessageSize, pnode->GetId());
     if (gArgs.GetBoolArg("-capturemessages", false)) {
-        CaptureMessage(pnode->addr, msg.m_type, msg.data, /*is_incoming=*/false);
+        CaptureMessage(pnode->addr, msg.m_type, payload, /*is_incoming=*/false);
     }
 
     TRACE6(net, outbound_message,
@@ -4827,8 +5013,8 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
         pnode->m_addr_name.c_str(),
         pnode->ConnectionTypeAsString().c_str(),
         msg.m_type.c_str(),
-        msg.data.size(),
-        msg.data.data()
+        payload.size(),
+        payload.data()
     );
 
     ::g_stats_client->count(strprintf("bandwidth.message.%s.bytesSent", msg.m_type), nMessageSize, 1.0f);
@@ -4845,8 +5031,10 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
         // Update memory usage of send buffer.
         pnode->m_send_memusage += msg.GetMemoryUsage();
         if (pnode->m_send_memusage + pnode->m_transport->GetSendMemoryUsage() > nSendBufferMaxSize) pnode->fPauseSend = true;
-        // Move message to vSendMsg queue.
-        pnode->vSendMsg.push_back(std::move(msg));
+        // Move message to vSendMsg queue. Nothing is reordered before the handshake is complete, the
+        // negotiation messages (e.g. SENDADDRV2) have to be sent before VERACK, so they all share its class.
+        const SendPriority priority{pnode->fSuccessfullyConnected ? GetSendPriority(msg.m_type) : SendPriority::HIGH};
+        pnode->vSendMsg.push_back(std::move(msg), priority);
         pnode->nSendMsgSize = pnode->vSendMsg.size();
 
         // If there was nothing to send before, and there is now (predicted by the "more" value
@@ -37,6 +37,7 @@
 #include <util/threadinterrupt.h>
 #include <util/wpipe.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -57,6 +58,7 @@ class AddrMan;
 class BanMan;
 class CConnman;
 class CDeterministicMNList;
+class CDeterministicMNListDiff;
 class CDeterministicMNManager;
 class CMasternodeMetaMan;
 class CMasternodeSync;
@@ -153,16 +155,74 @@ struct CSerializedNetMsg {
         CSerializedNetMsg copy;
         copy.data = data;
         copy.m_type = m_type;
+        copy.m_shared = m_shared;
         return copy;
     }
 
     std::vector<unsigned char> data;
     std::string m_type;
 
+    /** Immutable payload shared by all copies of a message that is relayed to many peers */
+    struct SharedPayload {
+        std::vector<unsigned char> data;
+        /** dbl-sha256 of data, computed once instead of for every v1 header */
+        uint256 hash;
+    };
+    /** If set, the payload of this message (data is empty then) */
+    std::shared_ptr<const SharedPayload> m_shared;
+
+    /** Move the payload into a reference counted buffer, so that Copy() shares it instead of duplicating it.
+     *  Transport framing is still added per peer when the message is sent. */
+    void MakeShared();
+    /** The payload of this message, whether owned or shared */
+    Span<const unsigned char> Payload() const noexcept { return m_shared ? Span{m_shared->data} : Span{data}; }
+    /** Release the payload, dropping the reference to a shared one */
+    void ClearPayload() noexcept;
+
     /** Compute total memory usage of this object (own memory + any dynamic memory). */
     size_t GetMemoryUsage() const noexcept;
 };
 
+/** Send priority classes of outgoing messages, lower values are sent first */
+enum class SendPriority : uint8_t {
+    HIGH = 0, //!< connection setup, LLMQ signing/DKG and lock messages
+    NORMAL,   //!< everything else
+    BULK,     //!< large masternode list, quorum data and governance payloads
+};
+constexpr size_t SEND_PRIORITY_COUNT{3};
+
+SendPriority GetSendPriority(const std::string& msg_type);
+
+/**
+ * Messages waiting to be handed over to the transport, kept in one FIFO per
+ * SendPriority. The oldest message of the highest non-empty class is sent first,
+ * except that a lower class which was passed over MAX_SKIPPED times in a row is
+ * served next, so bulk transfers keep making progress under a steady stream of
+ * higher priority messages. Order is preserved within a class.
+ */
+class SendQueue
+{
+public:
+    static constexpr size_t MAX_SKIPPED{16};
+
+    void push_back(CSerializedNetMsg&& msg) { push_back(std::move(msg), GetSendPriority(msg.m_type)); }
+    void push_back(CSerializedNetMsg&& msg, SendPriority priority);
+    /** The next message to send, must not be called on an empty queue */
+    CSerializedNetMsg& front();
+    void pop_front();
+    void clear();
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+private:
+    size_t NextClass() const;
+
+    std::array<std::deque<CSerializedNetMsg>, SEND_PRIORITY_COUNT> m_queues;
+    std::array<size_t, SEND_PRIORITY_COUNT> m_skipped{};
+    size_t m_size{0};
+};
+
 /**
  * Look up IP addresses from all interfaces on the machine and add them to the
  * list of local addresses to self-advertise.
@@ -743,7 +803,7 @@ public:
     /** Total number of bytes sent on the wire to this peer. */
     uint64_t nSendBytes GUARDED_BY(cs_vSend){0};
     /** Messages still to be fed to m_transport->SetMessageToSend. */
-    std::deque<CSerializedNetMsg> vSendMsg GUARDED_BY(cs_vSend);
+    SendQueue vSendMsg GUARDED_BY(cs_vSend);
     std::atomic<size_t> nSendMsgSize{0};
     mutable Mutex cs_vSend;
     Mutex m_sock_mutex;
@@ -822,6 +882,11 @@ public:
     std::optional<std::pair<CNetMessage, bool>> PollMessage()
         EXCLUSIVE_LOCKS_REQUIRED(!m_msg_process_queue_mutex);
 
+    /** Account for message bytes handed over to (positive) or released by (negative) a NetHandler
+     *  dispatch thread, so that they count towards the receive flood limit of this connection. */
+    void AccountForDispatchedMsg(int64_t nBytes)
+        EXCLUSIVE_LOCKS_REQUIRED(!m_msg_process_queue_mutex);
+
     /** Account for the total size of a sent message in the per msg type connection stats. */
     void AccountForSentBytes(const std::string& msg_type, size_t sent_bytes)
         EXCLUSIVE_LOCKS_REQUIRED(cs_vSend)
@@ -1112,6 +1177,12 @@ private:
     std::list<CNetMessage> m_msg_quorum_queue GUARDED_BY(m_msg_process_queue_mutex);
     size_t m_msg_quorum_queue_size GUARDED_BY(m_msg_process_queue_mutex){0};
     size_t m_quorum_msg_count_since_normal GUARDED_BY(m_msg_process_queue_mutex){0};
+    size_t m_msg_dispatch_queue_size GUARDED_BY(m_msg_process_queue_mutex){0};
+
+    void UpdatePauseRecv() EXCLUSIVE_LOCKS_REQUIRED(m_msg_process_queue_mutex)
+    {
+        fPauseRecv = (m_msg_quorum_queue_size + m_msg_process_queue_size + m_msg_dispatch_queue_size) > m_recv_flood_size;
+    }
 
     // Our address, as reported by the peer
     CService addrLocal GUARDED_BY(m_addr_local_mutex);
@@ -1478,10 +1549,18 @@ public:
     // also returns QWATCH nodes
     std::vector<NodeId> GetMasternodeQuorumNodes(Consensus::LLMQType llmqType, const uint256& quorumHash) const EXCLUSIVE_LOCKS_REQUIRED(!m_nodes_mutex);
     void RemoveMasternodeQuorumNodes(Consensus::LLMQType llmqType, const uint256& quorumHash);
-    bool IsMasternodeQuorumNode(const CNode* pnode, const CDeterministicMNList& tip_mn_list) const;
+    bool IsMasternodeQuorumNode(const CNode* pnode) const EXCLUSIVE_LOCKS_REQUIRED(!m_masternode_services_mutex);
     bool IsMasternodeQuorumRelayMember(const uint256& protxHash);
     void AddPendingProbeConnections(const Uint256HashSet& proTxHashes);
 
+    /** Rebuild the index of masternode services from the tip MN list */
+    void SetMasternodeServices(const CDeterministicMNList& mn_list) EXCLUSIVE_LOCKS_REQUIRED(!m_masternode_services_mutex);
+    /** Apply the changes of the MN list to the index of masternode services */
+    void UpdateMasternodeServices(const CDeterministicMNList& old_mn_list, const CDeterministicMNListDiff& diff)
+        EXCLUSIVE_LOCKS_REQUIRED(!m_masternode_services_mutex);
+    /** The proTxHash of the masternode registered with a service in the tip MN list, null if there is none */
+    uint256 GetMasternodeByService(const CService& addr) const EXCLUSIVE_LOCKS_REQUIRED(!m_masternode_services_mutex);
+
     size_t GetNodeCount(ConnectionDirection) const EXCLUSIVE_LOCKS_REQUIRED(!m_nodes_mutex);
     std::map<CNetAddr, LocalServiceInfo> getNetLocalAddresses() const;
     size_t GetMaxOutboundNodeCount();
@@ -1578,9 +1657,9 @@ private:
     void ProcessAddrFetch()
         EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_nodes_mutex, !m_unused_i2p_sessions_mutex,
                                  !mutexMsgProc, !cs_mapSocketToNode);
-    void ThreadOpenConnections(const std::vector<std::string> connect, CDeterministicMNManager& dmnman)
+    void ThreadOpenConnections(const std::vector<std::string> connect)
         EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_added_nodes_mutex, !m_nodes_mutex, !m_reconnections_mutex,
-                                 !m_unused_i2p_sessions_mutex, !mutexMsgProc, !cs_mapSocketToNode);
+                                 !m_unused_i2p_sessions_mutex, !mutexMsgProc, !cs_mapSocketToNode, !m_masternode_services_mutex);
     void ThreadMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!m_nodes_mutex, !mutexMsgProc);
     void ThreadI2PAcceptIncoming(CMasternodeSync& mn_sync) EXCLUSIVE_LOCKS_REQUIRED(!m_nodes_mutex, !mutexMsgProc, !cs_mapSocketToNode);
     void AcceptConnection(const ListenSocket& hListenSocket, CMasternodeSync& mn_sync)
@@ -1798,8 +1877,17 @@ private:
     mutable RecursiveMutex cs_vPendingMasternodes;
     std::map<std::pair<Consensus::LLMQType, uint256>, Uint256HashSet> masternodeQuorumNodes GUARDED_BY(cs_vPendingMasternodes);
     std::map<std::pair<Consensus::LLMQType, uint256>, Uint256HashSet> masternodeQuorumRelayMembers GUARDED_BY(cs_vPendingMasternodes);
+    // Number of quorums in masternodeQuorumNodes/masternodeQuorumRelayMembers a masternode is part of. Kept in sync with
+    // the sets above so that membership checks and the quorum connection queue don't have to walk every quorum.
+    Uint256HashMap<size_t> m_quorum_node_refs GUARDED_BY(cs_vPendingMasternodes);
+    Uint256HashMap<size_t> m_quorum_relay_refs GUARDED_BY(cs_vPendingMasternodes);
     Uint256HashSet masternodePendingProbes GUARDED_BY(cs_vPendingMasternodes);
 
+    mutable Mutex m_masternode_services_mutex;
+    //! Service of every masternode in the tip MN list, kept up to date from MN list diffs
+    std::unordered_map<CService, uint256, CServiceHash> m_masternode_services GUARDED_BY(m_masternode_services_mutex);
+    bool m_masternode_services_initialized GUARDED_BY(m_masternode_services_mutex){false};
+
     mutable Mutex cs_mapSocketToNode;
     std::unordered_map<SOCKET, CNode*> mapSocketToNode GUARDED_BY(cs_mapSocketToNode);
 
@@ -2024,7 +2112,8 @@ inline bool IsQuorumPriorityMessage(const std::string& msg_type)
     }
     // High-level lock messages (ChainLocks, InstantSend locks)
     if (msg_type == NetMsgType::CLSIG ||
-        msg_type == NetMsgType::ISDLOCK) {
+        msg_type == NetMsgType::ISDLOCK ||
+        msg_type == NetMsgType::ISDLOCKCMPCT) {
         return true;
     }
     return false;
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <net_dispatcher.h>
+
+#include <logging.h>
+#include <net.h>
+#include <net_processing.h>
+#include <util/strencodings.h>
+#include <util/thread.h>
+
+#include <optional>
+#include <typeinfo>
+
+NetHandlerDispatcher::NetHandlerDispatcher(NetHandler& handler, std::string thread_name, const std::vector<std::string>& msg_types) :
+    m_handler{handler},
+    m_thread_name{std::move(thread_name)},
+    m_msg_types{msg_types.begin(), msg_types.end()}
+{
+}
+
+NetHandlerDispatcher::~NetHandlerDispatcher()
+{
+    Interrupt();
+    Stop();
+}
+
+void NetHandlerDispatcher::Enqueue(CNode& node, const std::string& msg_type, const CDataStream& vRecv)
+{
+    const size_t size = vRecv.size();
+    node.AddRef();
+    node.AccountForDispatchedMsg(size);
+    {
+        LOCK(m_mutex);
+        m_queues[node.GetId()].push_back(Item{&node, msg_type, vRecv, size});
+    }
+    m_cond.notify_one();
+}
+
+void NetHandlerDispatcher::Start()
+{
+    WITH_LOCK(m_mutex, m_interrupted = false);
+    m_thread = std::thread(&util::TraceThread, m_thread_name.c_str(), [this] { ThreadMain(); });
+}
+
+void NetHandlerDispatcher::Interrupt()
+{
+    WITH_LOCK(m_mutex, m_interrupted = true);
+    m_cond.notify_all();
+}
+
+void NetHandlerDispatcher::Stop()
+{
+    Interrupt();
+    if (m_thread.joinable()) m_thread.join();
+    // Drop whatever is left and give the nodes back to CConnman
+    std::map<NodeId, std::deque<Item>> queues = WITH_LOCK(m_mutex, return std::move(m_queues));
+    for (auto& [_, queue] : queues) {
+        for (auto& item : queue) {
+            Release(item);
+        }
+    }
+}
+
+void NetHandlerDispatcher::Release(Item& item)
+{
+    item.node->AccountForDispatchedMsg(-int64_t(item.size));
+    item.node->Release();
+}
+
+void NetHandlerDispatcher::ThreadMain()
+{
+    while (true) {
+        std::optional<Item> item;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_cond.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_interrupted || !m_queues.empty(); });
+            if (m_interrupted) return;
+            // Serve the peer following the one served last
+            auto it = m_queues.upper_bound(m_last_peer);
+            if (it == m_queues.end()) it = m_queues.begin();
+            m_last_peer = it->first;
+            item.emplace(std::move(it->second.front()));
+            it->second.pop_front();
+            if (it->second.empty()) m_queues.erase(it);
+        }
+        if (!item->node->fDisconnect) {
+            try {
+                m_handler.ProcessMessage(*item->node, item->msg_type, item->vRecv);
+            } catch (const std::exception& e) {
+                LogPrint(BCLog::NET, "%s(%s, %u bytes): Exception '%s' (%s) caught\n", __func__, SanitizeString(item->msg_type), item->size, e.what(), typeid(e).name());
+            } catch (...) {
+                LogPrint(BCLog::NET, "%s(%s, %u bytes): Unknown exception caught\n", __func__, SanitizeString(item->msg_type), item->size);
+            }
+        }
+        Release(*item);
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NET_DISPATCHER_H
+#define BITCOIN_NET_DISPATCHER_H
+
+#include <net_types.h>
+#include <streams.h>
+#include <sync.h>
+#include <threadsafety.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CNode;
+class NetHandler;
+
+/**
+ * Runs ProcessMessage() of a single NetHandler for the message types it asked to
+ * have dispatched. Messages are queued per peer and served round-robin, so one
+ * peer flooding a handler can't starve the others. Queued bytes count towards
+ * the receive flood limit of the sending peer, which pauses reading from it via
+ * fPauseRecv until the dispatch thread catches up.
+ */
+class NetHandlerDispatcher
+{
+public:
+    NetHandlerDispatcher(NetHandler& handler, std::string thread_name, const std::vector<std::string>& msg_types);
+    ~NetHandlerDispatcher();
+
+    bool IsDispatched(const std::string& msg_type) const { return m_msg_types.count(msg_type) > 0; }
+
+    /** Queue a message of `node`, which is referenced until the message has been processed or dropped */
+    void Enqueue(CNode& node, const std::string& msg_type, const CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    void Start() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Join the dispatch thread and drop the messages it didn't get to */
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Item {
+        CNode* node;
+        std::string msg_type;
+        CDataStream vRecv;
+        size_t size;
+    };
+
+    static void Release(Item& item);
+    void ThreadMain() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    NetHandler& m_handler;
+    const std::string m_thread_name;
+    const std::set<std::string> m_msg_types;
+
+    Mutex m_mutex;
+    std::condition_variable m_cond;
+    std::map<NodeId, std::deque<Item>> m_queues GUARDED_BY(m_mutex);
+    NodeId m_last_peer GUARDED_BY(m_mutex){-1};
+    bool m_interrupted GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+};
+
+#endif // BITCOIN_NET_DISPATCHER_H
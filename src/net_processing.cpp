@@ -10,19 +10,23 @@
 #include <blockencodings.h>
 #include <blockfilter.h>
 #include <chainparams.h>
+#include <ctpl_stl.h>
 #include <consensus/amount.h>
 #include <consensus/validation.h>
 #include <hash.h>
 #include <index/blockfilterindex.h>
 #include <index/txindex.h>
 #include <merkleblock.h>
+#include <net_dispatcher.h>
 #include <net_types.h>
 #include <netbase.h>
 #include <netmessagemaker.h>
 #include <node/blockstorage.h>
 #include <node/txreconciliation.h>
+#include <objectrequest.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
+#include <pow.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <random.h>
@@ -66,12 +70,17 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <future>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <set>
+#include <thread>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 using node::ReadBlockFromDisk;
@@ -155,6 +164,8 @@ static constexpr double BLOCK_DOWNLOAD_TIMEOUT_PER_PEER = 0.5;
 static const unsigned int MAX_BLOCKS_TO_ANNOUNCE = 8;
 /** Maximum number of unconnecting headers announcements before DoS score */
 static const int MAX_UNCONNECTING_HEADERS = 10;
+/** Maximum number of threads, besides the message handler, that hash a HEADERS message */
+static constexpr int MAX_HEADERS_HASH_THREADS{7};
 /** Minimum blocks required to signal NODE_NETWORK_LIMITED */
 static const unsigned int NODE_NETWORK_LIMITED_MIN_BLOCKS = 288;
 /** Average delay between local address broadcasts */
@@ -403,6 +414,13 @@ struct Peer {
     /** Whether we've sent this peer a getheaders in response to an inv prior to initial-headers-sync completing */
     bool m_inv_triggered_getheaders_before_sync GUARDED_BY(NetEventsInterface::g_msgproc_mutex){false};
 
+    Mutex m_mnauth_mutex;
+    /** MNAUTH of the peer waiting for its signature to be verified. No other messages of the peer are processed
+     *  until it is, later messages may rely on the peer being authenticated. */
+    std::optional<CMNAuth::Pending> m_mnauth_pending GUARDED_BY(m_mnauth_mutex);
+    /** Result of the verification of m_mnauth_pending, std::nullopt while it is in progress */
+    std::optional<bool> m_mnauth_valid GUARDED_BY(m_mnauth_mutex);
+
     /** Protects m_getdata_requests **/
     Mutex m_getdata_requests_mutex;
     /** Work queue of items requested by this peer **/
@@ -509,69 +527,6 @@ struct CNodeState {
     //! Time of last new block announcement
     int64_t m_last_block_announcement{0};
 
-    /*
-     * State associated with objects download.
-     *
-     * Tx download algorithm:
-     *
-     *   When inv comes in, queue up (process_time, inv) inside the peer's
-     *   CNodeState (m_object_process_time) as long as m_object_announced for the peer
-     *   isn't too big (MAX_PEER_OBJECT_ANNOUNCEMENTS).
-     *
-     *   The process_time for a objects is set to nNow for outbound peers,
-     *   nNow + 2 seconds for inbound peers. This is the time at which we'll
-     *   consider trying to request the objects from the peer in
-     *   SendMessages(). The delay for inbound peers is to allow outbound peers
-     *   a chance to announce before we request from inbound peers, to prevent
-     *   an adversary from using inbound connections to blind us to a
-     *   objects (InvBlock).
-     *
-     *   When we call SendMessages() for a given peer,
-     *   we will loop over the objects in m_object_process_time, looking
-     *   at the objects whose process_time <= nNow. We'll request each
-     *   such objects that we don't have already and that hasn't been
-     *   requested from another peer recently, up until we hit the
-     *   MAX_PEER_OBJECT_IN_FLIGHT limit for the peer. Then we'll update
-     *   g_already_asked_for for each requested inv, storing the time of the
-     *   GETDATA request. We use g_already_asked_for to coordinate objects
-     *   requests amongst our peers.
-     *
-     *   For objects that we still need but we have already recently
-     *   requested from some other peer, we'll reinsert (process_time, inv)
-     *   back into the peer's m_object_process_time at the point in the future at
-     *   which the most recent GETDATA request would time out (ie
-     *   GetObjectInterval + the request time stored in g_already_asked_for).
-     *   We add an additional delay for inbound peers, again to prefer
-     *   attempting download from outbound peers first.
-     *   We also add an extra small random delay up to 2 seconds
-     *   to avoid biasing some peers over others. (e.g., due to fixed ordering
-     *   of peer processing in ThreadMessageHandler).
-     *
-     *   When we receive a objects from a peer, we remove the inv from the
-     *   peer's m_object_in_flight set and from their recently announced set
-     *   (m_object_announced).  We also clear g_already_asked_for for that entry, so
-     *   that if somehow the objects is not accepted but also not added to
-     *   the reject filter, then we will eventually redownload from other
-     *   peers.
-     */
-    struct ObjectDownloadState {
-        /* Track when to attempt download of announced objects (process
-         * time in micros -> inv)
-         */
-        std::multimap<std::chrono::microseconds, CInv> m_object_process_time;
-
-        //! Store all the objects a peer has recently announced
-        std::set<CInv> m_object_announced;
-
-        //! Store objects which were requested by us, with timestamp
-        std::map<CInv, std::chrono::microseconds> m_object_in_flight;
-
-        //! Periodically check for stuck getdata requests
-        std::chrono::microseconds m_check_expiry_timer{0};
-    };
-
-    ObjectDownloadState m_object_download;
-
     //! Whether this peer is an inbound connection
     const bool m_is_inbound;
 
@@ -640,7 +595,7 @@ public:
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, g_msgproc_mutex);
     void UpdateLastBlockAnnounceTime(NodeId node, int64_t time_in_seconds) override;
     bool IsBanned(NodeId pnode) override EXCLUSIVE_LOCKS_REQUIRED(cs_main, !m_peer_mutex);
-    size_t GetRequestedObjectCount(NodeId nodeid) const override EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    size_t GetRequestedObjectCount(NodeId nodeid) const override;
 
     /** Implements external handlers logic */
     void AddExtraHandler(std::unique_ptr<NetHandler>&& handler) override;
@@ -653,7 +608,7 @@ public:
     /** Implement PeerManagerInternal */
     void PeerMisbehaving(const NodeId pnode, const int howmuch, const std::string& message = "") override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     bool PeerIsBanned(const NodeId node_id) override EXCLUSIVE_LOCKS_REQUIRED(cs_main, !m_peer_mutex);
-    void PeerEraseObjectRequest(const NodeId nodeid, const CInv& inv) override EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    void PeerEraseObjectRequest(const NodeId nodeid, const CInv& inv) override;
     void PeerPushInventory(NodeId nodeid, const CInv& inv) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void PeerRelayInv(const CInv& inv) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void PeerRelayInvFiltered(const CInv& inv, const CTransaction& relatedTx) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
@@ -662,7 +617,7 @@ public:
     void PeerRelayTransaction(const uint256& txid) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void PeerRelayRecoveredSig(const llmq::CRecoveredSig& sig, bool proactive_relay) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void PeerAskPeersForTransaction(const uint256& txid) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
-    size_t PeerGetRequestedObjectCount(NodeId nodeid) const override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, ::cs_main);
+    size_t PeerGetRequestedObjectCount(NodeId nodeid) const override;
     void PeerPostProcessMessage(MessageProcessingResult&& ret) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
 
 private:
@@ -680,14 +635,18 @@ private:
      */
     void RelayInvFiltered(const CInv& inv, const uint256& relatedTxHash) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
 
-    void EraseObjectRequest(NodeId nodeid, const CInv& inv) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    void EraseObjectRequest(NodeId nodeid, const CInv& inv);
 
-    void RequestObject(NodeId nodeid, const CInv& inv, std::chrono::microseconds current_time, bool fForce = false)
-        EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    void RequestObject(NodeId nodeid, const CInv& inv, std::chrono::microseconds current_time, bool fForce = false);
 
     /** Helper to process result of external handlers of message */
     void PostProcessMessage(MessageProcessingResult&& ret, NodeId node) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
 
+    /** Verify the signature of an MNAUTH on the BLS worker, where concurrent MNAUTHs of many peers are batched */
+    void VerifyMNAuth(CNode& pfrom, Peer& peer, CMNAuth::Pending&& mnauth) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+    /** Complete a pending MNAUTH of the peer, returns false if its verification is still in progress */
+    bool ProcessPendingMNAuth(CNode& pfrom, Peer& peer) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+
     /** Consider evicting an outbound peer based on the amount of time they've been behind our tip */
     void ConsiderEviction(CNode& pto, Peer& peer, std::chrono::seconds time_in_seconds) EXCLUSIVE_LOCKS_REQUIRED(cs_main, g_msgproc_mutex);
 
@@ -758,10 +717,12 @@ private:
      */
     bool ProcessOrphanTx(NodeId node_id)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, cs_main);
-    /** Process a single headers message from a peer. */
+    /** Process a single headers message from a peer.
+     *  @param[in] hashes The hashes of the headers if already known, computed (in parallel) otherwise */
     void ProcessHeadersMessage(CNode& pfrom, Peer& peer,
                                const std::vector<CBlockHeader>& headers,
-                               bool via_compact_block)
+                               bool via_compact_block,
+                               std::vector<uint256> hashes = {})
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, g_msgproc_mutex);
     [[nodiscard]] MessageProcessingResult ProcessPlatformBanMessage(NodeId node, std::string_view msg_type, CDataStream& vRecv)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, g_msgproc_mutex);
@@ -773,7 +734,7 @@ private:
     void HandleFewUnconnectingHeaders(CNode& pfrom, Peer& peer, const std::vector<CBlockHeader>& headers)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, g_msgproc_mutex);
     /** Return true if the headers connect to each other, false otherwise */
-    bool CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers) const;
+    bool CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers, const std::vector<uint256>& hashes) const;
     /** Request further headers from this peer with a given locator.
      * We don't issue a getheaders message if we have a recent one outstanding.
      * This returns true if a getheaders is actually sent, and false otherwise.
@@ -839,6 +800,9 @@ private:
     /** Whether this node is running in -blocksonly mode */
     const bool m_ignore_incoming_txs;
 
+    /** Workers that help hashing large HEADERS messages, see HashHeaders() */
+    ctpl::thread_pool m_headers_hash_pool;
+
     bool RejectIncomingTxs(const CNode& peer) const;
 
     /** Whether we've completed initial sync yet, for determining when to turn
@@ -1094,6 +1058,47 @@ private:
     /** Storage for orphan information */
     TxOrphanage m_orphanage;
 
+    /*
+     * Objects download (transactions and Dash specific inventory).
+     *
+     *   When inv comes in, schedule it in m_object_requests at process_time,
+     *   as long as the peer doesn't have too many announcements
+     *   (MAX_PEER_OBJECT_ANNOUNCEMENTS).
+     *
+     *   The process_time for a objects is set to nNow for outbound peers,
+     *   nNow + 2 seconds for inbound peers. This is the time at which we'll
+     *   consider trying to request the objects from the peer in
+     *   SendMessages(). The delay for inbound peers is to allow outbound peers
+     *   a chance to announce before we request from inbound peers, to prevent
+     *   an adversary from using inbound connections to blind us to a
+     *   objects (InvBlock).
+     *
+     *   When we call SendMessages() for a given peer, we take the objects
+     *   scheduled up to nNow in process_time order. We'll request each
+     *   such objects that we don't have already and that hasn't been
+     *   requested from another peer recently, up until we hit the
+     *   MAX_PEER_OBJECT_IN_FLIGHT limit for the peer. The tracker remembers
+     *   the time of the GETDATA request, which we use to coordinate objects
+     *   requests amongst our peers.
+     *
+     *   For objects that we still need but we have already recently
+     *   requested from some other peer, we'll reschedule them at the point in
+     *   the future at which the most recent GETDATA request would time out (ie
+     *   GetObjectInterval + the last request time). We add an additional delay
+     *   for inbound peers, again to prefer attempting download from outbound
+     *   peers first. We also add an extra small random delay up to 2 seconds
+     *   to avoid biasing some peers over others. (e.g., due to fixed ordering
+     *   of peer processing in ThreadMessageHandler).
+     *
+     *   When we receive a objects from a peer, we forget the peer's
+     *   announcement and the last request time, so that if somehow the
+     *   objects is not accepted but also not added to the reject filter, then
+     *   we will eventually redownload from other peers.
+     *
+     *   The tracker has its own lock, so none of this requires cs_main.
+     */
+    ObjectRequestTracker m_object_requests{MAX_PEER_OBJECT_ANNOUNCEMENTS};
+
     void AddToCompactExtraTransactions(const CTransactionRef& tx) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
 
     /** Orphan/conflicted/etc transactions that are kept for compact block reconstruction.
@@ -1104,12 +1109,10 @@ private:
     size_t vExtraTxnForCompactIt GUARDED_BY(g_msgproc_mutex) = 0;
 
     std::vector<std::unique_ptr<NetHandler>> m_handlers;
+    /** Dispatch threads of the handlers that asked for them, destroyed before the handlers */
+    std::unordered_map<const NetHandler*, std::unique_ptr<NetHandlerDispatcher>> m_handler_dispatchers;
 };
 
-// Keeps track of the time (in microseconds) when transactions were requested last time
-unordered_limitedmap<uint256, std::chrono::microseconds, StaticSaltedHasher> g_already_asked_for(MAX_INV_SZ, MAX_INV_SZ * 2);
-unordered_limitedmap<uint256, std::chrono::microseconds, StaticSaltedHasher> g_erased_object_requests(MAX_INV_SZ, MAX_INV_SZ * 2);
-
 const CNodeState* PeerManagerImpl::State(NodeId pnode) const EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
     std::map<NodeId, CNodeState>::const_iterator it = m_node_states.find(pnode);
@@ -1549,39 +1552,8 @@ void PeerManagerImpl::PushNodeVersion(CNode& pnode, const Peer& peer)
 
 void PeerManagerImpl::EraseObjectRequest(NodeId nodeid, const CInv& inv)
 {
-    AssertLockHeld(cs_main);
-
-    CNodeState* state = State(nodeid);
-    if (state == nullptr)
-        return;
-
     LogPrint(BCLog::NET, "%s -- inv=(%s)\n", __func__, inv.ToString());
-    g_already_asked_for.erase(inv.hash);
-    g_erased_object_requests.insert(std::make_pair(inv.hash, GetTime<std::chrono::microseconds>()));
-
-    state->m_object_download.m_object_announced.erase(inv);
-    state->m_object_download.m_object_in_flight.erase(inv);
-}
-
-std::chrono::microseconds GetObjectRequestTime(const CInv& inv) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
-{
-    AssertLockHeld(cs_main);
-    auto it = g_already_asked_for.find(inv.hash);
-    if (it != g_already_asked_for.end()) {
-        return it->second;
-    }
-    return {};
-}
-
-void UpdateObjectRequestTime(const CInv& inv, std::chrono::microseconds request_time) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
-{
-    AssertLockHeld(cs_main);
-    auto it = g_already_asked_for.find(inv.hash);
-    if (it == g_already_asked_for.end()) {
-        g_already_asked_for.insert(std::make_pair(inv.hash, request_time));
-    } else {
-        g_already_asked_for.update(it, request_time);
-    }
+    m_object_requests.ForgetObject(nodeid, inv, GetTime<std::chrono::microseconds>());
 }
 
 std::chrono::microseconds GetObjectInterval(int invType)
@@ -1613,11 +1585,10 @@ std::chrono::microseconds GetObjectRandomDelay(int invType)
     return {};
 }
 
-std::chrono::microseconds CalculateObjectGetDataTime(const CInv& inv, std::chrono::microseconds current_time, bool is_masternode, bool use_inbound_delay) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+std::chrono::microseconds CalculateObjectGetDataTime(const CInv& inv, std::chrono::microseconds last_request_time, std::chrono::microseconds current_time,
+                                                      bool is_masternode, bool use_inbound_delay)
 {
-    AssertLockHeld(cs_main);
     std::chrono::microseconds process_time;
-    const auto last_request_time = GetObjectRequestTime(inv);
     // First time requesting this tx
     if (last_request_time.count() == 0) {
         process_time = current_time;
@@ -1635,33 +1606,21 @@ std::chrono::microseconds CalculateObjectGetDataTime(const CInv& inv, std::chron
 
 void PeerManagerImpl::RequestObject(NodeId nodeid, const CInv& inv, std::chrono::microseconds current_time, bool fForce)
 {
-    AssertLockHeld(cs_main);
-
-    CNodeState* state = State(nodeid);
-    if (state == nullptr)
-        return;
+    // Calculate the time to try requesting this transaction. Use
+    // fPreferredDownload as a proxy for outbound peers.
+    std::chrono::microseconds process_time = CalculateObjectGetDataTime(inv, m_object_requests.GetLastRequestTime(inv.hash), current_time,
+                                                                        /*is_masternode=*/m_nodeman != nullptr,
+                                                                        !m_object_requests.IsPreferred(nodeid));
 
-    CNodeState::ObjectDownloadState& peer_download_state = state->m_object_download;
-    if (peer_download_state.m_object_announced.size() >= MAX_PEER_OBJECT_ANNOUNCEMENTS ||
-            peer_download_state.m_object_process_time.size() >= MAX_PEER_OBJECT_ANNOUNCEMENTS ||
-            peer_download_state.m_object_announced.count(inv)) {
+    if (!m_object_requests.ReceivedInv(nodeid, inv, process_time)) {
         // Too many queued announcements from this peer, or we already have
         // this announcement
         return;
     }
-    peer_download_state.m_object_announced.insert(inv);
-
-    // Calculate the time to try requesting this transaction. Use
-    // fPreferredDownload as a proxy for outbound peers.
-    std::chrono::microseconds process_time = CalculateObjectGetDataTime(inv, current_time, /*is_masternode=*/m_nodeman != nullptr,
-                                                                        !state->fPreferredDownload);
-
-    peer_download_state.m_object_process_time.emplace(process_time, inv);
 
     if (fForce) {
         // make sure this object is actually requested ASAP
-        g_erased_object_requests.erase(inv.hash);
-        g_already_asked_for.erase(inv.hash);
+        m_object_requests.ForceRequest(inv.hash);
     }
 
     LogPrint(BCLog::NET, "%s -- inv=(%s), current_time=%d, process_time=%d, delta=%d\n", __func__, inv.ToString(), current_time.count(), process_time.count(), (process_time - current_time).count());
@@ -1669,13 +1628,7 @@ void PeerManagerImpl::RequestObject(NodeId nodeid, const CInv& inv, std::chrono:
 
 size_t PeerManagerImpl::GetRequestedObjectCount(NodeId nodeid) const
 {
-    AssertLockHeld(cs_main);
-
-    const CNodeState* state = State(nodeid);
-    if (state == nullptr)
-        return 0;
-
-    return state->m_object_download.m_object_process_time.size();
+    return m_object_requests.CountScheduled(nodeid);
 }
 
 void PeerManagerImpl::AddExtraHandler(std::unique_ptr<NetHandler>&& handler)
@@ -1684,6 +1637,9 @@ void PeerManagerImpl::AddExtraHandler(std::unique_ptr<NetHandler>&& handler)
     if (auto i = dynamic_cast<CValidationInterface*>(handler.get()); i != nullptr) {
         RegisterValidationInterface(i);
     }
+    if (auto msg_types = handler->GetDispatchedMessageTypes(); !msg_types.empty()) {
+        m_handler_dispatchers.emplace(handler.get(), std::make_unique<NetHandlerDispatcher>(*handler, handler->GetDispatchThreadName(), msg_types));
+    }
     m_handlers.emplace_back(std::move(handler));
 }
 
@@ -1691,6 +1647,7 @@ void PeerManagerImpl::RemoveHandlers()
 {
     InterruptHandlers();
     StopHandlers();
+    m_handler_dispatchers.clear();
     m_handlers.clear();
 }
 
@@ -1698,6 +1655,9 @@ void PeerManagerImpl::StartHandlers()
 {
     for (auto& handler : m_handlers) {
         handler->Start();
+        if (auto it = m_handler_dispatchers.find(handler.get()); it != m_handler_dispatchers.end()) {
+            it->second->Start();
+        }
     }
 }
 
@@ -1707,6 +1667,9 @@ void PeerManagerImpl::StopHandlers()
         if (auto i = dynamic_cast<CValidationInterface*>(handler.get()); i != nullptr) {
             UnregisterValidationInterface(i);
         }
+        if (auto it = m_handler_dispatchers.find(handler.get()); it != m_handler_dispatchers.end()) {
+            it->second->Stop();
+        }
         handler->Stop();
     }
 }
@@ -1714,6 +1677,9 @@ void PeerManagerImpl::StopHandlers()
 void PeerManagerImpl::InterruptHandlers()
 {
     for (auto& handler : m_handlers) {
+        if (auto it = m_handler_dispatchers.find(handler.get()); it != m_handler_dispatchers.end()) {
+            it->second->Interrupt();
+        }
         handler->Interrupt();
     }
 }
@@ -1794,6 +1760,7 @@ void PeerManagerImpl::FinalizeNode(const CNode& node) {
         mapBlocksInFlight.erase(entry.pindex->GetBlockHash());
     }
     m_orphanage.EraseForPeer(nodeid);
+    m_object_requests.DisconnectedPeer(nodeid);
     if (m_txreconciliation) m_txreconciliation->ForgetPeer(nodeid);
     m_num_preferred_download_peers -= state->fPreferredDownload;
     m_peers_downloading_from -= (state->nBlocksInFlight != 0);
@@ -2104,6 +2071,9 @@ PeerManagerImpl::PeerManagerImpl(const CChainParams& chainparams, CConnman& conn
     if (gArgs.GetBoolArg("-txreconciliation", DEFAULT_TXRECONCILIATION_ENABLE)) {
         m_txreconciliation = std::make_unique<TxReconciliationTracker>(TXRECONCILIATION_VERSION);
     }
+
+    m_headers_hash_pool.resize(std::clamp(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0, MAX_HEADERS_HASH_THREADS));
+    RenameThreadPool(m_headers_hash_pool, "hdrhash");
 }
 
 void PeerManagerImpl::StartScheduledTasks(CScheduler& scheduler)
@@ -2189,7 +2159,12 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
 
     uint256 hashBlock(pblock->GetHash());
     const std::shared_future<CSerializedNetMsg> lazy_ser{
-        std::async(std::launch::deferred, [&] { return msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock); })};
+        std::async(std::launch::deferred, [&] {
+            // Serialized once and shared by every peer it is announced to
+            auto msg{msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock)};
+            msg.MakeShared();
+            return msg;
+        })};
 
     {
         LOCK(m_most_recent_block_mutex);
@@ -2200,7 +2175,6 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
 
     m_connman.ForEachNode([this, pindex, &lazy_ser, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
         AssertLockHeld(::cs_main);
-        // TODO: Avoid the repeated-serialization here
         if (pnode->fDisconnect)
             return;
         ProcessBlockAvailability(pnode->GetId());
@@ -2427,7 +2401,6 @@ void PeerManagerImpl::AskPeersForTransaction(const uint256& txid)
     }
     {
         CInv inv(MSG_TX, txid);
-        LOCK(cs_main);
         for (PeerRef& peer : peersToAsk) {
             LogPrintf("PeerManagerImpl::%s -- txid=%s: asking other peer %d for correct TX\n", __func__,
                       txid.ToString(), peer->m_id);
@@ -2496,10 +2469,13 @@ void PeerManagerImpl::RelayDSQ(const CCoinJoinQueue& queue)
             }
         }
     }
+    if (nodes_send_all.empty()) return;
+    // The serialization of a queue does not depend on the peer's version, build it once for all of them
+    auto msg{CNetMsgMaker(PROTOCOL_VERSION).Make(NetMsgType::DSQUEUE, queue)};
+    msg.MakeShared();
     for (auto nodeId : nodes_send_all) {
         m_connman.ForNode(nodeId, [&](CNode* pnode) -> bool {
-            CNetMsgMaker msgMaker(pnode->GetCommonVersion());
-            m_connman.PushMessage(pnode, msgMaker.Make(NetMsgType::DSQUEUE, queue));
+            m_connman.PushMessage(pnode, msg.Copy());
             return true;
         });
     }
@@ -2588,13 +2564,15 @@ void PeerManagerImpl::_RelayTransaction(const uint256& txid)
 void PeerManagerImpl::RelayRecoveredSig(const llmq::CRecoveredSig& sig, bool proactive_relay)
 {
     if (proactive_relay) {
-        // We were the peer that recovered this; avoid a bunch of `inv` -> `GetData` spam by proactively sending
-        m_connman.ForEachNode([this, &sig](CNode* pnode) -> bool {
+        // We were the peer that recovered this; avoid a bunch of `inv` -> `GetData` spam by proactively sending.
+        // The message is serialized once and its payload shared between all receiving peers.
+        auto msg{CNetMsgMaker(PROTOCOL_VERSION).Make(NetMsgType::QSIGREC, sig)};
+        msg.MakeShared();
+        m_connman.ForEachNode([this, &msg](CNode* pnode) -> bool {
             // Skip nodes that don't want recovered signatures
             PeerRef peer = GetPeerRef(pnode->GetId());
             if (peer == nullptr || !peer->m_wants_recsigs) return true;
-            CNetMsgMaker msgMaker(pnode->GetCommonVersion());
-            m_connman.PushMessage(pnode, msgMaker.Make(NetMsgType::QSIGREC, sig));
+            m_connman.PushMessage(pnode, msg.Copy());
             return true;
         });
         return;
@@ -2949,7 +2927,12 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
         if (!push && inv.type == MSG_ISDLOCK) {
             instantsend::InstantSendLock o;
             if (m_llmq_ctx->isman->GetInstantSendLockByHash(inv.hash, o)) {
-                m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::ISDLOCK, o));
+                // Peers that know the locked transaction can rebuild the inputs themselves
+                if (pfrom.GetCommonVersion() >= COMPACT_ISDLOCK_VERSION && IsInvInFilter(peer, o.txid)) {
+                    m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::ISDLOCKCMPCT, instantsend::CompactInstantSendLock{o}));
+                } else {
+                    m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::ISDLOCK, o));
+                }
                 push = true;
             }
         }
@@ -3064,14 +3047,12 @@ void PeerManagerImpl::HandleFewUnconnectingHeaders(CNode& pfrom, Peer& peer,
     }
 }
 
-bool PeerManagerImpl::CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers) const
+bool PeerManagerImpl::CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers, const std::vector<uint256>& hashes) const
 {
-    uint256 hashLastBlock;
-    for (const CBlockHeader& header : headers) {
-        if (!hashLastBlock.IsNull() && header.hashPrevBlock != hashLastBlock) {
+    for (size_t i = 1; i < headers.size(); ++i) {
+        if (headers[i].hashPrevBlock != hashes[i - 1]) {
             return false;
         }
-        hashLastBlock = header.GetHash();
     }
     return true;
 }
@@ -3221,7 +3202,8 @@ void PeerManagerImpl::UpdatePeerStateForReceivedHeaders(CNode& pfrom,
 
 void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
                                             const std::vector<CBlockHeader>& headers,
-                                            bool via_compact_block)
+                                            bool via_compact_block,
+                                            std::vector<uint256> hashes)
 {
     const CNetMsgMaker msgMaker(pfrom.GetCommonVersion());
     size_t nCount = headers.size();
@@ -3248,18 +3230,33 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
         return;
     }
 
+    // Pre-validate the batch without holding cs_main: every header is hashed once, here or
+    // while it was decompressed, and its proof of work checked. Only the contextual checks
+    // and the block index insertion in ProcessNewBlockHeaders are left to do under the lock.
+    if (hashes.size() != nCount) {
+        hashes = HashHeaders(headers, &m_headers_hash_pool);
+    }
+    for (size_t i = 0; i < nCount; ++i) {
+        if (!CheckProofOfWork(hashes[i], headers[i].nBits, m_chainparams.GetConsensus())) {
+            BlockValidationState state;
+            state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "high-hash", "proof of work failed");
+            MaybePunishNodeForBlock(pfrom.GetId(), state, via_compact_block, "invalid header received");
+            return;
+        }
+    }
+
     // At this point, the headers connect to something in our block index.
-    if (!CheckHeadersAreContinuous(headers)) {
+    if (!CheckHeadersAreContinuous(headers, hashes)) {
         Misbehaving(peer, 20, "non-continuous headers sequence");
         return;
     }
 
     // If we don't have the last header, then this peer will have given us
     // something new (if these headers are valid).
-    bool received_new_header{WITH_LOCK(::cs_main, return m_chainman.m_blockman.LookupBlockIndex(headers.back().GetHash()) == nullptr)};
+    bool received_new_header{WITH_LOCK(::cs_main, return m_chainman.m_blockman.LookupBlockIndex(hashes.back()) == nullptr)};
 
     BlockValidationState state;
-    if (!m_chainman.ProcessNewBlockHeaders(headers, state, &pindexLast)) {
+    if (!m_chainman.ProcessNewBlockHeaders(headers, state, &pindexLast, hashes)) {
         if (state.IsInvalid()) {
             MaybePunishNodeForBlock(pfrom.GetId(), state, via_compact_block, "invalid header received");
             return;
@@ -3601,7 +3598,7 @@ void PeerManagerImpl::PostProcessMessage(MessageProcessingResult&& result, NodeI
         if (peer) Misbehaving(*peer, result.m_error->score, result.m_error->message);
     }
     if (result.m_to_erase) {
-        WITH_LOCK(cs_main, EraseObjectRequest(node, result.m_to_erase.value()));
+        EraseObjectRequest(node, result.m_to_erase.value());
     }
     for (const auto& tx : result.m_transactions) {
         WITH_LOCK(cs_main, _RelayTransaction(tx));
@@ -3877,6 +3874,7 @@ void PeerManagerImpl::ProcessMessage(
             CNodeState* state = State(pfrom.GetId());
             state->fPreferredDownload = (!pfrom.IsInboundConn() || pfrom.HasPermission(NetPermissionFlags::NoBan)) && !pfrom.IsAddrFetchConn() && CanServeBlocks(*peer);
             m_num_preferred_download_peers += state->fPreferredDownload;
+            m_object_requests.SetPreferred(pfrom.GetId(), state->fPreferredDownload);
         }
 
         // Attempt to initialize address relay for outbound peers and use result
@@ -3994,8 +3992,7 @@ void PeerManagerImpl::ProcessMessage(
             // Tell our peer that he should send us CoinJoin queue messages
             m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::SENDDSQUEUE, true));
             // Tell our peer that he should send us intra-quorum messages
-            const auto tip_mn_list = Assert(m_dmnman)->GetListAtChainTip();
-            if (m_llmq_ctx->qman->IsWatching() && m_connman.IsMasternodeQuorumNode(&pfrom, tip_mn_list)) {
+            if (m_llmq_ctx->qman->IsWatching() && m_connman.IsMasternodeQuorumNode(&pfrom)) {
                 m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::QWATCH));
             }
         }
@@ -4631,10 +4628,7 @@ void PeerManagerImpl::ProcessMessage(
         AddKnownInv(*peer, txid);
 
         CInv inv(nInvType, tx.GetHash());
-        {
-            LOCK(cs_main);
-            EraseObjectRequest(pfrom.GetId(), inv);
-        }
+        EraseObjectRequest(pfrom.GetId(), inv);
 
         // Process custom logic, no matter if tx will be accepted to mempool later or not
         if (nInvType == MSG_DSTX) {
@@ -5074,6 +5068,7 @@ void PeerManagerImpl::ProcessMessage(
         peer->m_last_getheaders_timestamp = {};
 
         std::vector<CBlockHeader> headers;
+        std::vector<uint256> hashes;
 
         // Bypass the normal CBlock deserialization, as we don't want to risk deserializing 2000 full blocks.
         unsigned int nCount = ReadCompactSize(vRecv);
@@ -5089,16 +5084,21 @@ void PeerManagerImpl::ProcessMessage(
                 ReadCompactSize(vRecv); // ignore tx count; assume it is 0.
             }
         } else if (msg_type == NetMsgType::HEADERS2) {
+            // A compressed header usually omits hashPrevBlock, so each header's hash is needed to
+            // restore the next one and the batch can only be hashed serially. Keep these hashes.
+            headers.reserve(nCount);
+            hashes.reserve(nCount);
             std::list<int32_t> last_unique_versions;
             for (unsigned int n = 0; n < nCount; n++) {
                 CompressibleBlockHeader block_header_compressed;
                 vRecv >> block_header_compressed;
-                block_header_compressed.Uncompress(headers, last_unique_versions);
+                block_header_compressed.Uncompress(headers, last_unique_versions, hashes.empty() ? nullptr : &hashes.back());
                 headers.push_back(block_header_compressed);
+                hashes.push_back(headers.back().GetHash());
             }
         }
 
-        return ProcessHeadersMessage(pfrom, *peer, headers, /*via_compact_block=*/false);
+        return ProcessHeadersMessage(pfrom, *peer, headers, /*via_compact_block=*/false, std::move(hashes));
     }
 
     if (msg_type == NetMsgType::BLOCK)
@@ -5408,7 +5408,7 @@ void PeerManagerImpl::ProcessMessage(
 
         uint256 hash = spork.GetHash();
         CInv spork_inv{MSG_SPORK, hash};
-        WITH_LOCK(::cs_main, EraseObjectRequest(pfrom.GetId(), spork_inv));
+        EraseObjectRequest(pfrom.GetId(), spork_inv);
         auto opt_signer = m_sporkman.GetValidSporkSigner(spork);
         if (!opt_signer) {
             Misbehaving(*peer, 100, strprintf("invalid spork received. peer=%d", pfrom.GetId()));
@@ -5463,20 +5463,11 @@ void PeerManagerImpl::ProcessMessage(
             return;
         }
 
-        LOCK(cs_main);
-        CNodeState *state = State(pfrom.GetId());
         for (CInv &inv : vInv) {
             if (inv.IsKnownType()) {
                 // If we receive a NOTFOUND message for a txid we requested, erase
                 // it from our data structures for this peer.
-                auto in_flight_it = state->m_object_download.m_object_in_flight.find(inv);
-                if (in_flight_it == state->m_object_download.m_object_in_flight.end()) {
-                    // Skip any further work if this is a spurious NOTFOUND
-                    // message.
-                    continue;
-                }
-                state->m_object_download.m_object_in_flight.erase(in_flight_it);
-                state->m_object_download.m_object_announced.erase(inv);
+                m_object_requests.ReceivedNotFound(pfrom.GetId(), inv);
             }
         }
         return;
@@ -5497,7 +5488,11 @@ void PeerManagerImpl::ProcessMessage(
         if (m_cj_walletman) {
             PostProcessMessage(m_cj_walletman->processMessage(pfrom, m_chainman.ActiveChainstate(), m_connman, m_mempool, msg_type, vRecv), pfrom.GetId());
         }
-        PostProcessMessage(CMNAuth::ProcessMessage(pfrom, peer->m_their_services, m_connman, m_mn_metaman, m_nodeman, m_mn_sync, m_dmnman->GetListAtChainTip(), msg_type, vRecv), pfrom.GetId());
+        std::optional<CMNAuth::Pending> mnauth;
+        PostProcessMessage(CMNAuth::ProcessMessage(pfrom, peer->m_their_services, m_mn_sync, m_dmnman->GetListAtChainTip(), msg_type, vRecv, mnauth), pfrom.GetId());
+        if (mnauth) {
+            VerifyMNAuth(pfrom, *peer, std::move(*mnauth));
+        }
         PostProcessMessage(m_llmq_ctx->quorum_block_processor->ProcessMessage(pfrom, msg_type, vRecv), pfrom.GetId());
         PostProcessMessage(ProcessPlatformBanMessage(pfrom.GetId(), msg_type, vRecv), pfrom.GetId());
 
@@ -5506,13 +5501,18 @@ void PeerManagerImpl::ProcessMessage(
                 chainlock::ChainLockSig clsig;
                 vRecv >> clsig;
                 const uint256& hash = ::SerializeHash(clsig);
-                WITH_LOCK(::cs_main, EraseObjectRequest(pfrom.GetId(), CInv{MSG_CLSIG, hash}));
+                EraseObjectRequest(pfrom.GetId(), CInv{MSG_CLSIG, hash});
                 PostProcessMessage(m_clhandler.ProcessNewChainLock(pfrom.GetId(), clsig, *m_llmq_ctx->qman, hash), pfrom.GetId());
             }
             return; // CLSIG
         }
 
         for (const auto& handler : m_handlers) {
+            if (auto it = m_handler_dispatchers.find(handler.get());
+                it != m_handler_dispatchers.end() && it->second->IsDispatched(msg_type)) {
+                it->second->Enqueue(pfrom, msg_type, vRecv);
+                continue;
+            }
             handler->ProcessMessage(pfrom, msg_type, vRecv);
         }
         return;
@@ -5563,6 +5563,52 @@ bool PeerManagerImpl::MaybeDiscourageAndDisconnect(CNode& pnode, Peer& peer)
     return true;
 }
 
+void PeerManagerImpl::VerifyMNAuth(CNode& pfrom, Peer& peer, CMNAuth::Pending&& mnauth)
+{
+    if (bls::bls_legacy_scheme.load()) {
+        // CBLSWorker verifies in the global scheme while MNAUTH is always signed with the basic one
+        const bool valid{mnauth.sig.VerifyInsecure(mnauth.pubKeyOperator, mnauth.signHash, false)};
+        PostProcessMessage(CMNAuth::ProcessVerified(pfrom, m_connman, m_mn_metaman, m_nodeman, m_dmnman->GetListAtChainTip(), mnauth, valid), pfrom.GetId());
+        return;
+    }
+
+    const auto sig{mnauth.sig};
+    const auto pubkey{mnauth.pubKeyOperator};
+    const auto sign_hash{mnauth.signHash};
+    {
+        LOCK(peer.m_mnauth_mutex);
+        peer.m_mnauth_pending = std::move(mnauth);
+        peer.m_mnauth_valid.reset();
+    }
+    // The result is picked up by ProcessMessages, wake up the message handler so that it doesn't sit in its wait
+    // until an unrelated message arrives. Only hold a weak reference to the peer, verification might still be in
+    // progress when the peer (or we) disconnect.
+    std::weak_ptr<Peer> weak_peer{GetPeerRef(peer.m_id)};
+    m_llmq_ctx->bls_worker->AsyncVerifySig(sig, pubkey, sign_hash, [weak_peer, &connman = m_connman](bool valid) {
+        if (const auto peer = weak_peer.lock()) {
+            WITH_LOCK(peer->m_mnauth_mutex, peer->m_mnauth_valid = valid);
+            connman.WakeMessageHandler();
+        }
+    }, [weak_peer] { return weak_peer.expired(); });
+}
+
+bool PeerManagerImpl::ProcessPendingMNAuth(CNode& pfrom, Peer& peer)
+{
+    CMNAuth::Pending mnauth;
+    bool valid;
+    {
+        LOCK(peer.m_mnauth_mutex);
+        if (!peer.m_mnauth_pending) return true;
+        if (!peer.m_mnauth_valid) return false;
+        mnauth = std::move(*peer.m_mnauth_pending);
+        valid = *peer.m_mnauth_valid;
+        peer.m_mnauth_pending.reset();
+        peer.m_mnauth_valid.reset();
+    }
+    PostProcessMessage(CMNAuth::ProcessVerified(pfrom, m_connman, m_mn_metaman, m_nodeman, m_dmnman->GetListAtChainTip(), mnauth, valid), pfrom.GetId());
+    return !pfrom.fDisconnect;
+}
+
 bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interruptMsgProc)
 {
     AssertLockHeld(g_msgproc_mutex);
@@ -5595,6 +5641,8 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
         if (!peer->m_getdata_requests.empty()) return true;
     }
 
+    if (!ProcessPendingMNAuth(*pfrom, *peer)) return false;
+
     // Don't bother if send buffer is too full to respond anyway
     if (pfrom->fPauseSend) return false;
 
@@ -6527,38 +6575,19 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         // were unresponsive in the past.
         // Eventually we should consider disconnecting peers, but this is
         // conservative.
-        if (state.m_object_download.m_check_expiry_timer <= current_time) {
-            for (auto it=state.m_object_download.m_object_in_flight.begin(); it != state.m_object_download.m_object_in_flight.end();) {
-                if (it->second <= current_time - GetObjectExpiryInterval(it->first.type)) {
-                    LogPrint(BCLog::NET, "timeout of inflight object %s from peer=%d\n", it->first.ToString(), pto->GetId());
-                    state.m_object_download.m_object_announced.erase(it->first);
-                    state.m_object_download.m_object_in_flight.erase(it++);
-                } else {
-                    ++it;
-                }
-            }
-            // On average, we do this check every GetObjectExpiryInterval. Randomize
-            // so that we're not doing this for all peers at the same time.
-            state.m_object_download.m_check_expiry_timer = current_time + GetObjectExpiryInterval(MSG_TX)/2 + GetRandMicros(GetObjectExpiryInterval(MSG_TX));
+        // Requests are kept ordered by expiry, so this only touches the expired ones.
+        for (const CInv& inv : m_object_requests.ExpireRequests(pto->GetId(), current_time)) {
+            LogPrint(BCLog::NET, "timeout of inflight object %s from peer=%d\n", inv.ToString(), pto->GetId());
         }
 
         // DASH this code also handles non-TXs (Dash specific messages)
-        auto& object_process_time = state.m_object_download.m_object_process_time;
-        while (!object_process_time.empty() && object_process_time.begin()->first <= current_time && state.m_object_download.m_object_in_flight.size() < MAX_PEER_OBJECT_IN_FLIGHT) {
-            const CInv inv = object_process_time.begin()->second;
-            // Erase this entry from object_process_time (it may be added back for
-            // processing at a later time, see below)
-            object_process_time.erase(object_process_time.begin());
-            if (g_erased_object_requests.count(inv.hash)) {
-                LogPrint(BCLog::NET, "%s -- GETDATA skipping inv=(%s), peer=%d\n", __func__, inv.ToString(), pto->GetId());
-                state.m_object_download.m_object_announced.erase(inv);
-                state.m_object_download.m_object_in_flight.erase(inv);
-                continue;
-            }
+        const bool is_preferred{m_object_requests.IsPreferred(pto->GetId())};
+        while (const auto next = m_object_requests.NextDue(pto->GetId(), current_time, MAX_PEER_OBJECT_IN_FLIGHT)) {
+            const CInv inv = *next;
             if (!AlreadyHave(inv)) {
                 // If this object was last requested more than GetObjectInterval ago,
                 // then request.
-                const auto last_request_time = GetObjectRequestTime(inv);
+                const auto last_request_time = m_object_requests.GetLastRequestTime(inv.hash);
                 if (last_request_time <= current_time - GetObjectInterval(inv.type)) {
                     LogPrint(BCLog::NET, "Requesting %s peer=%d\n", inv.ToString(), pto->GetId());
                     vGetData.push_back(inv);
@@ -6566,21 +6595,19 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                         m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::GETDATA, vGetData));
                         vGetData.clear();
                     }
-                    UpdateObjectRequestTime(inv, current_time);
-                    state.m_object_download.m_object_in_flight.emplace(inv, current_time);
+                    m_object_requests.RequestedObject(pto->GetId(), inv, current_time, current_time + GetObjectExpiryInterval(inv.type));
                 } else {
                     // This object is in flight from someone else; queue
                     // up processing to happen after the download times out
                     // (with a slight delay for inbound peers, to prefer
                     // requests to outbound peers).
-                    const auto next_process_time = CalculateObjectGetDataTime(inv, current_time, is_masternode, !state.fPreferredDownload);
-                    object_process_time.emplace(next_process_time, inv);
+                    const auto next_process_time = CalculateObjectGetDataTime(inv, last_request_time, current_time, is_masternode, !is_preferred);
+                    m_object_requests.Reschedule(pto->GetId(), inv, next_process_time);
                     LogPrint(BCLog::NET, "%s -- GETDATA re-queue inv=(%s), next_process_time=%d, delta=%d, peer=%d\n", __func__, inv.ToString(), next_process_time.count(), (next_process_time - current_time).count(), pto->GetId());
                 }
             } else {
                 // We have already seen this object, no need to download.
-                state.m_object_download.m_object_announced.erase(inv);
-                state.m_object_download.m_object_in_flight.erase(inv);
+                m_object_requests.DropAnnouncement(pto->GetId(), inv);
                 LogPrint(BCLog::NET, "%s -- GETDATA already seen inv=(%s), peer=%d\n", __func__, inv.ToString(), pto->GetId());
             }
         }
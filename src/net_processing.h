@@ -91,6 +91,13 @@ public:
 
     virtual void ProcessMessage(CNode& pfrom, const std::string& msg_type, CDataStream& vRecv) {}
 
+    // Message types returned here are passed to ProcessMessage() from a dedicated dispatch thread named
+    // GetDispatchThreadName() instead of the message handler thread, so that slow bulk processing in one
+    // handler doesn't hold up latency-sensitive messages of the others. ProcessMessage() must be thread-safe
+    // for these types. Messages of other types are still delivered synchronously.
+    virtual std::vector<std::string> GetDispatchedMessageTypes() const { return {}; }
+    virtual std::string GetDispatchThreadName() const { return {}; }
+
     // It returns true, if NetHandler has a responsibility about having this type of inventory and has corresponding data.
     virtual bool AlreadyHave(const CInv& inv) { return false; }
 
@@ -11,7 +11,8 @@
 
 namespace node {
 //! Metadata describing a serialized version of a UTXO set from which an
-//! assumeutxo CChainState can be constructed.
+//! assumeutxo CChainState can be constructed. It is followed by the coins
+//! and then by the evo state at the base block (see CEvoSnapshot).
 class SnapshotMetadata
 {
 public:
@@ -0,0 +1,270 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <objectrequest.h>
+
+#include <limitedmap.h>
+#include <logging.h>
+#include <net.h>
+#include <saltedhasher.h>
+#include <sync.h>
+
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/tag.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+/** A peer's announcement of an inv */
+struct Announcement {
+    CInv m_inv;
+    NodeId m_peer;
+    /** Whether a getdata for it was sent to the peer */
+    bool m_in_flight;
+    /** The process time while scheduled, the expiry of the request while in flight */
+    std::chrono::microseconds m_time;
+};
+
+struct ByPeerInv {};
+struct ByPeerStateTime {};
+
+using AnnouncementIndex = boost::multi_index_container<
+    Announcement,
+    boost::multi_index::indexed_by<
+        boost::multi_index::ordered_unique<
+            boost::multi_index::tag<ByPeerInv>,
+            boost::multi_index::composite_key<
+                Announcement,
+                boost::multi_index::member<Announcement, NodeId, &Announcement::m_peer>,
+                boost::multi_index::member<Announcement, CInv, &Announcement::m_inv>>>,
+        boost::multi_index::ordered_non_unique<
+            boost::multi_index::tag<ByPeerStateTime>,
+            boost::multi_index::composite_key<
+                Announcement,
+                boost::multi_index::member<Announcement, NodeId, &Announcement::m_peer>,
+                boost::multi_index::member<Announcement, bool, &Announcement::m_in_flight>,
+                boost::multi_index::member<Announcement, std::chrono::microseconds, &Announcement::m_time>>>>>;
+
+struct PeerInfo {
+    size_t m_total{0};
+    size_t m_in_flight{0};
+    bool m_preferred{false};
+};
+} // anonymous namespace
+
+class ObjectRequestTracker::Impl
+{
+    const size_t m_max_peer_announcements;
+
+    mutable Mutex m_mutex;
+    AnnouncementIndex m_index GUARDED_BY(m_mutex);
+    std::unordered_map<NodeId, PeerInfo> m_peer_info GUARDED_BY(m_mutex);
+    //! The time objects were last requested from any peer
+    unordered_limitedmap<uint256, std::chrono::microseconds, StaticSaltedHasher> m_last_request GUARDED_BY(m_mutex){MAX_INV_SZ, MAX_INV_SZ * 2};
+    //! Objects that were received (or otherwise dealt with) recently, and should not be requested anymore
+    unordered_limitedmap<uint256, std::chrono::microseconds, StaticSaltedHasher> m_erased GUARDED_BY(m_mutex){MAX_INV_SZ, MAX_INV_SZ * 2};
+
+    void Erase(AnnouncementIndex::index<ByPeerInv>::type::iterator it) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        auto info_it = m_peer_info.find(it->m_peer);
+        assert(info_it != m_peer_info.end() && info_it->second.m_total > 0);
+        --info_it->second.m_total;
+        if (it->m_in_flight) --info_it->second.m_in_flight;
+        m_index.get<ByPeerInv>().erase(it);
+    }
+
+    void Erase(AnnouncementIndex::index<ByPeerStateTime>::type::iterator it) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        Erase(m_index.project<ByPeerInv>(it));
+    }
+
+public:
+    explicit Impl(size_t max_peer_announcements) : m_max_peer_announcements{max_peer_announcements} {}
+
+    void SetPreferred(NodeId peer, bool preferred) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_peer_info[peer].m_preferred = preferred;
+    }
+
+    bool IsPreferred(NodeId peer) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto it = m_peer_info.find(peer);
+        return it != m_peer_info.end() && it->second.m_preferred;
+    }
+
+    bool ReceivedInv(NodeId peer, const CInv& inv, std::chrono::microseconds process_time) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto& info = m_peer_info[peer];
+        if (info.m_total >= m_max_peer_announcements) return false;
+        if (!m_index.emplace(Announcement{inv, peer, /*m_in_flight=*/false, process_time}).second) return false;
+        ++info.m_total;
+        return true;
+    }
+
+    void ForceRequest(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_erased.erase(hash);
+        m_last_request.erase(hash);
+    }
+
+    void ForgetObject(NodeId peer, const CInv& inv, std::chrono::microseconds now) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_last_request.erase(inv.hash);
+        m_erased.insert(std::make_pair(inv.hash, now));
+        if (auto it = m_index.get<ByPeerInv>().find(std::make_tuple(peer, inv)); it != m_index.get<ByPeerInv>().end()) {
+            Erase(it);
+        }
+    }
+
+    void ReceivedNotFound(NodeId peer, const CInv& inv) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (auto it = m_index.get<ByPeerInv>().find(std::make_tuple(peer, inv)); it != m_index.get<ByPeerInv>().end() && it->m_in_flight) {
+            Erase(it);
+        }
+    }
+
+    void DisconnectedPeer(NodeId peer) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto& index = m_index.get<ByPeerInv>();
+        index.erase(index.lower_bound(std::make_tuple(peer)), index.upper_bound(std::make_tuple(peer)));
+        m_peer_info.erase(peer);
+    }
+
+    size_t CountScheduled(NodeId peer) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto it = m_peer_info.find(peer);
+        return it == m_peer_info.end() ? 0 : it->second.m_total - it->second.m_in_flight;
+    }
+
+    std::chrono::microseconds GetLastRequestTime(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto it = m_last_request.find(hash);
+        return it == m_last_request.end() ? std::chrono::microseconds{0} : it->second;
+    }
+
+    std::vector<CInv> ExpireRequests(NodeId peer, std::chrono::microseconds now) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        std::vector<CInv> expired;
+        auto& index = m_index.get<ByPeerStateTime>();
+        auto it = index.lower_bound(std::make_tuple(peer, true));
+        while (it != index.end() && it->m_peer == peer && it->m_time <= now) {
+            expired.push_back(it->m_inv);
+            Erase(it++);
+        }
+        return expired;
+    }
+
+    std::optional<CInv> NextDue(NodeId peer, std::chrono::microseconds now, size_t max_in_flight) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto info_it = m_peer_info.find(peer);
+        if (info_it == m_peer_info.end()) return std::nullopt;
+        auto& index = m_index.get<ByPeerStateTime>();
+        auto it = index.lower_bound(std::make_tuple(peer, false));
+        while (info_it->second.m_in_flight < max_in_flight && it != index.end() && it->m_peer == peer && !it->m_in_flight && it->m_time <= now) {
+            if (m_erased.count(it->m_inv.hash)) {
+                LogPrint(BCLog::NET, "%s -- GETDATA skipping inv=(%s), peer=%d\n", __func__, it->m_inv.ToString(), peer);
+                Erase(it++);
+                continue;
+            }
+            return it->m_inv;
+        }
+        return std::nullopt;
+    }
+
+    void RequestedObject(NodeId peer, const CInv& inv, std::chrono::microseconds now, std::chrono::microseconds expiry) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto last_it = m_last_request.find(inv.hash);
+        if (last_it == m_last_request.end()) {
+            m_last_request.insert(std::make_pair(inv.hash, now));
+        } else {
+            m_last_request.update(last_it, now);
+        }
+        auto it = m_index.get<ByPeerInv>().find(std::make_tuple(peer, inv));
+        if (it == m_index.get<ByPeerInv>().end()) return;
+        if (!it->m_in_flight) ++m_peer_info[peer].m_in_flight;
+        m_index.get<ByPeerInv>().modify(it, [&](Announcement& ann) {
+            ann.m_in_flight = true;
+            ann.m_time = expiry;
+        });
+    }
+
+    void Reschedule(NodeId peer, const CInv& inv, std::chrono::microseconds process_time) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto it = m_index.get<ByPeerInv>().find(std::make_tuple(peer, inv));
+        if (it == m_index.get<ByPeerInv>().end()) return;
+        if (it->m_in_flight) --m_peer_info[peer].m_in_flight;
+        m_index.get<ByPeerInv>().modify(it, [&](Announcement& ann) {
+            ann.m_in_flight = false;
+            ann.m_time = process_time;
+        });
+    }
+
+    void DropAnnouncement(NodeId peer, const CInv& inv) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (auto it = m_index.get<ByPeerInv>().find(std::make_tuple(peer, inv)); it != m_index.get<ByPeerInv>().end()) {
+            Erase(it);
+        }
+    }
+};
+
+ObjectRequestTracker::ObjectRequestTracker(size_t max_peer_announcements) :
+    m_impl{std::make_unique<Impl>(max_peer_announcements)}
+{
+}
+
+ObjectRequestTracker::~ObjectRequestTracker() = default;
+
+void ObjectRequestTracker::SetPreferred(NodeId peer, bool preferred) { m_impl->SetPreferred(peer, preferred); }
+bool ObjectRequestTracker::IsPreferred(NodeId peer) const { return m_impl->IsPreferred(peer); }
+bool ObjectRequestTracker::ReceivedInv(NodeId peer, const CInv& inv, std::chrono::microseconds process_time)
+{
+    return m_impl->ReceivedInv(peer, inv, process_time);
+}
+void ObjectRequestTracker::ForceRequest(const uint256& hash) { m_impl->ForceRequest(hash); }
+void ObjectRequestTracker::ForgetObject(NodeId peer, const CInv& inv, std::chrono::microseconds now)
+{
+    m_impl->ForgetObject(peer, inv, now);
+}
+void ObjectRequestTracker::ReceivedNotFound(NodeId peer, const CInv& inv) { m_impl->ReceivedNotFound(peer, inv); }
+void ObjectRequestTracker::DisconnectedPeer(NodeId peer) { m_impl->DisconnectedPeer(peer); }
+size_t ObjectRequestTracker::CountScheduled(NodeId peer) const { return m_impl->CountScheduled(peer); }
+std::chrono::microseconds ObjectRequestTracker::GetLastRequestTime(const uint256& hash) const
+{
+    return m_impl->GetLastRequestTime(hash);
+}
+std::vector<CInv> ObjectRequestTracker::ExpireRequests(NodeId peer, std::chrono::microseconds now)
+{
+    return m_impl->ExpireRequests(peer, now);
+}
+std::optional<CInv> ObjectRequestTracker::NextDue(NodeId peer, std::chrono::microseconds now, size_t max_in_flight)
+{
+    return m_impl->NextDue(peer, now, max_in_flight);
+}
+void ObjectRequestTracker::RequestedObject(NodeId peer, const CInv& inv, std::chrono::microseconds now, std::chrono::microseconds expiry)
+{
+    m_impl->RequestedObject(peer, inv, now, expiry);
+}
+void ObjectRequestTracker::Reschedule(NodeId peer, const CInv& inv, std::chrono::microseconds process_time)
+{
+    m_impl->Reschedule(peer, inv, process_time);
+}
+void ObjectRequestTracker::DropAnnouncement(NodeId peer, const CInv& inv) { m_impl->DropAnnouncement(peer, inv); }
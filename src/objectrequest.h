@@ -0,0 +1,91 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_OBJECTREQUEST_H
+#define BITCOIN_OBJECTREQUEST_H
+
+#include <net_types.h>
+#include <protocol.h>
+#include <uint256.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * Tracks announcements of inventory (transactions and Dash objects like governance
+ * objects/votes, islocks, chainlocks, recovered sigs and DSTXes) and the getdata
+ * requests we send for them.
+ *
+ * For every peer, an announced inv is either scheduled, meaning we will consider
+ * requesting it once its process time has passed, or in flight, meaning we asked the
+ * peer for it and are waiting for it until the request expires. Scheduling policy (when
+ * to request what from whom) is left to the caller, which can query the last time an
+ * object was requested from any peer to coordinate requests between peers.
+ *
+ * All announcements are kept in a single index ordered by peer, state and time, so
+ * finding the next object to request or the expired requests of a peer is
+ * O(log n) instead of a walk over every in flight object.
+ *
+ * The tracker is protected by its own lock, none of its methods require cs_main.
+ */
+class ObjectRequestTracker
+{
+    class Impl;
+    const std::unique_ptr<Impl> m_impl;
+
+public:
+    explicit ObjectRequestTracker(size_t max_peer_announcements);
+    ~ObjectRequestTracker();
+
+    /** Set whether we prefer downloading from a peer (outbound and similar connections) */
+    void SetPreferred(NodeId peer, bool preferred);
+    bool IsPreferred(NodeId peer) const;
+
+    /** A peer announced an inv, schedule requesting it at process_time.
+     *  Returns false if the peer already announced it or has too many announcements. */
+    bool ReceivedInv(NodeId peer, const CInv& inv, std::chrono::microseconds process_time);
+
+    /** Request the object again as soon as possible, even if it was recently requested or received */
+    void ForceRequest(const uint256& hash);
+
+    /** We received the object (or don't need it anymore): forget the peer's announcement and
+     *  don't request it from other peers which announced it too. */
+    void ForgetObject(NodeId peer, const CInv& inv, std::chrono::microseconds now);
+
+    /** The peer does not have the object, drop the request if it was in flight */
+    void ReceivedNotFound(NodeId peer, const CInv& inv);
+
+    /** Drop everything related to a peer */
+    void DisconnectedPeer(NodeId peer);
+
+    /** Number of announcements of the peer that were not requested yet */
+    size_t CountScheduled(NodeId peer) const;
+
+    /** The last time the object was requested from any peer, zero if never (or not recently) */
+    std::chrono::microseconds GetLastRequestTime(const uint256& hash) const;
+
+    /** Drop the requests of a peer that expired by now, returns them */
+    std::vector<CInv> ExpireRequests(NodeId peer, std::chrono::microseconds now);
+
+    /**
+     * The scheduled announcement of a peer with the earliest process time if that time has come,
+     * and the peer has less than max_in_flight requests in flight. Announcements of objects that
+     * were forgotten in the meantime are dropped. The caller is expected to resolve the returned
+     * announcement with RequestedObject, Reschedule or DropAnnouncement.
+     */
+    std::optional<CInv> NextDue(NodeId peer, std::chrono::microseconds now, size_t max_in_flight);
+
+    /** We sent a getdata for the object to the peer, waiting for it until expiry */
+    void RequestedObject(NodeId peer, const CInv& inv, std::chrono::microseconds now, std::chrono::microseconds expiry);
+
+    /** Reconsider requesting the object from the peer at process_time */
+    void Reschedule(NodeId peer, const CInv& inv, std::chrono::microseconds process_time);
+
+    /** Forget the peer's announcement, e.g. because we already have the object */
+    void DropAnnouncement(NodeId peer, const CInv& inv);
+};
+
+#endif // BITCOIN_OBJECTREQUEST_H
@@ -92,7 +92,8 @@ void CompressibleBlockHeader::Compress(const std::vector<CompressibleBlockHeader
     }
 }
 
-void CompressibleBlockHeader::Uncompress(const std::vector<CBlockHeader>& previous_blocks, std::list<int32_t>& last_unique_versions)
+void CompressibleBlockHeader::Uncompress(const std::vector<CBlockHeader>& previous_blocks, std::list<int32_t>& last_unique_versions,
+                                         const uint256* last_block_hash)
 {
     if (previous_blocks.empty()) {
         // First block in chain is always uncompressed
@@ -119,7 +120,7 @@ void CompressibleBlockHeader::Uncompress(const std::vector<CBlockHeader>& previo
 
     // Uncompress prev block hash
     if (bit_field.IsCompressed(CompressedHeaderBitField::Flag::PREV_BLOCK_HASH)) {
-        hashPrevBlock = last_block.GetHash();
+        hashPrevBlock = last_block_hash ? *last_block_hash : last_block.GetHash();
     }
 
     // Uncompress timestamp
@@ -180,7 +180,9 @@ struct CompressibleBlockHeader : CBlockHeader {
 
     void Compress(const std::vector<CompressibleBlockHeader>& previous_blocks, std::list<int32_t>& last_unique_versions);
 
-    void Uncompress(const std::vector<CBlockHeader>& previous_blocks, std::list<int32_t>& last_unique_versions);
+    /** @param[in] last_block_hash Optional, the already known hash of previous_blocks.back() */
+    void Uncompress(const std::vector<CBlockHeader>& previous_blocks, std::list<int32_t>& last_unique_versions,
+                    const uint256* last_block_hash = nullptr);
 };
 
 class CBlock : public CBlockHeader
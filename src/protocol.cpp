@@ -84,6 +84,7 @@ MAKE_MSG(QGETDATA, "qgetdata");
 MAKE_MSG(QDATA, "qdata");
 MAKE_MSG(CLSIG, "clsig");
 MAKE_MSG(ISDLOCK, "isdlock");
+MAKE_MSG(ISDLOCKCMPCT, "isdlockcmpct");
 MAKE_MSG(MNAUTH, "mnauth");
 MAKE_MSG(GETHEADERS2, "getheaders2");
 MAKE_MSG(SENDHEADERS2, "sendheaders2");
@@ -166,6 +167,7 @@ const static std::string allNetMessageTypes[] = {
     NetMsgType::QDATA,
     NetMsgType::CLSIG,
     NetMsgType::ISDLOCK,
+    NetMsgType::ISDLOCKCMPCT,
     NetMsgType::MNAUTH,
     NetMsgType::GETHEADERS2,
     NetMsgType::SENDHEADERS2,
@@ -292,6 +292,12 @@ extern const char* QGETDATA;
 extern const char* QDATA;
 extern const char* CLSIG;
 extern const char* ISDLOCK;
+/**
+ * Contains an ISDLOCK without its inputs, which the receiver rebuilds from the
+ * locked transaction. Sent in response to a getdata for MSG_ISDLOCK when the
+ * peer is known to have the transaction.
+ */
+extern const char* ISDLOCKCMPCT;
 extern const char* MNAUTH;
 extern const char* GETHEADERS2;
 extern const char* SENDHEADERS2;
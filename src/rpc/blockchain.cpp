@@ -9,6 +9,7 @@
 #include <blockfilter.h>
 #include <chain.h>
 #include <chainparams.h>
+#include <clientversion.h>
 #include <coins.h>
 #include <consensus/amount.h>
 #include <core_io.h>
@@ -53,8 +54,10 @@
 #include <evo/assetlocktx.h>
 #include <evo/cbtx.h>
 #include <evo/evodb.h>
+#include <evo/evosnapshot.h>
 #include <evo/mnhftx.h>
 #include <evo/specialtx.h>
+#include <evo/specialtxman.h>
 #include <instantsend/instantsend.h>
 #include <llmq/context.h>
 
@@ -2688,7 +2691,7 @@ static RPCHelpMan dumptxoutset()
 {
     return RPCHelpMan{
         "dumptxoutset",
-        "Write the serialized UTXO set to disk.",
+        "Write the serialized UTXO set and the evo state (masternode list, active quorums and credit pool) at its base block to disk.",
         {
             {"path", RPCArg::Type::STR, RPCArg::Optional::NO, "Path to the output file. If relative, will be prefixed by datadir."},
         },
@@ -2750,6 +2753,7 @@ UniValue CreateUTXOSnapshot(
     std::unique_ptr<CCoinsViewCursor> pcursor;
     std::optional<CCoinsStats> maybe_stats;
     const CBlockIndex* tip;
+    CEvoSnapshot evo_snapshot;
 
     {
         // We need to lock cs_main to ensure that the coinsdb isn't written to
@@ -2775,6 +2779,14 @@ UniValue CreateUTXOSnapshot(
 
         pcursor = chainstate.CoinsDB().Cursor();
         tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
+
+        CBlock block;
+        if (!ReadBlockFromDisk(block, tip, Params().GetConsensus())) {
+            throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read the snapshot base block");
+        }
+        if (!chainstate.ChainHelper().special_tx->CreateEvoSnapshot(block, tip, evo_snapshot)) {
+            throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read the evo state at the snapshot base block");
+        }
     }
 
     LOG_TIME_SECONDS(strprintf("writing UTXO snapshot at height %s (%s) to file %s (via %s)",
@@ -2800,6 +2812,9 @@ UniValue CreateUTXOSnapshot(
         pcursor->Next();
     }
 
+    // The evo state contains network addresses and masternode types which are versioned
+    OverrideStream<AutoFile>{&afile, SER_DISK, CLIENT_VERSION} << evo_snapshot;
+
     afile.fclose();
 
     UniValue result(UniValue::VOBJ);
@@ -655,7 +655,7 @@ static RPCHelpMan getnetworkinfo()
                         {RPCResult::Type::NUM, "connections_mn_in", "the number of inbound verified mn connections"},
                         {RPCResult::Type::NUM, "connections_mn_out", "the number of outbound verified mn connections"},
                         {RPCResult::Type::BOOL, "networkactive", "whether p2p networking is enabled"},
-                        {RPCResult::Type::STR, "socketevents", "the socket events mode, either kqueue, epoll, poll or select"},
+                        {RPCResult::Type::STR, "socketevents", "the socket events mode, either kqueue, epoll, io_uring, poll or select"},
                         {RPCResult::Type::ARR, "networks", "information per network",
                         {
                             {RPCResult::Type::OBJ, "", "",
@@ -5,6 +5,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <clientversion.h>
 #include <consensus/consensus.h>
 #include <evo/mnauth.h>
 #include <httpserver.h>
@@ -27,9 +28,11 @@
 #include <rpc/server_util.h>
 #include <rpc/util.h>
 #include <scheduler.h>
+#include <streams.h>
 #include <txmempool.h>
 #include <univalue.h>
 #include <util/check.h>
+#include <util/strencodings.h>
 #include <util/system.h>
 #include <validation.h>
 
@@ -380,6 +383,63 @@ static bool getAddressesFromParams(const UniValue& params, std::vector<std::pair
     return true;
 }
 
+/** Maximum number of entries of one page of getaddressutxos/getaddressdeltas */
+static constexpr size_t MAX_ADDRESS_PAGE_SIZE{100000};
+
+/** The "limit" of a paginated address query, 0 if the results are not paginated */
+static size_t getAddressPageLimit(const UniValue& params)
+{
+    if (!params[0].isObject()) return 0;
+    const UniValue& limit_value = params[0].get_obj().find_value("limit");
+    if (limit_value.isNull()) return 0;
+    const int64_t limit{limit_value.getInt<int64_t>()};
+    if (limit <= 0 || static_cast<uint64_t>(limit) > MAX_ADDRESS_PAGE_SIZE) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Limit is expected to be between 1 and %d", MAX_ADDRESS_PAGE_SIZE));
+    }
+    return static_cast<size_t>(limit);
+}
+
+/** The "cursor" of a paginated address query, which is the serialized index key of the last entry of the previous page */
+template <typename Key>
+static std::optional<Key> getAddressPageCursor(const UniValue& params)
+{
+    if (!params[0].isObject()) return std::nullopt;
+    const UniValue& cursor_value = params[0].get_obj().find_value("cursor");
+    if (cursor_value.isNull()) return std::nullopt;
+    CDataStream ss(ParseHexV(cursor_value, "cursor"), SER_DISK, CLIENT_VERSION);
+    Key key;
+    try {
+        ss >> key;
+    } catch (const std::ios_base::failure&) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+    }
+    if (!ss.empty()) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+    }
+    return key;
+}
+
+template <typename Key>
+static std::string encodeAddressPageCursor(const Key& key)
+{
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << key;
+    return HexStr(ss);
+}
+
+/** Position of the address a cursor belongs to, pages continue with the address the previous page ended in */
+template <typename Key>
+static size_t getAddressPageStart(const std::vector<std::pair<uint160, AddressType>>& addresses, const std::optional<Key>& cursor)
+{
+    if (!cursor) return 0;
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        if (addresses[i].first == cursor->m_address_bytes && addresses[i].second == cursor->m_address_type) {
+            return i;
+        }
+    }
+    throw JSONRPCError(RPC_INVALID_PARAMETER, "Cursor does not belong to the requested addresses");
+}
+
 static RPCHelpMan getaddressmempool()
 {
     return RPCHelpMan{"getaddressmempool",
@@ -464,7 +524,10 @@ static RPCHelpMan getaddressmempool()
 static RPCHelpMan getaddressutxos()
 {
     return RPCHelpMan{"getaddressutxos",
-        "\nReturns all unspent outputs for an address (requires addressindex to be enabled).\n",
+        "\nReturns all unspent outputs for an address (requires addressindex to be enabled).\n"
+        "Large results can be paged through by passing an object with \"addresses\", \"limit\" (the maximum number\n"
+        "of outputs per page, at most " + ToString(MAX_ADDRESS_PAGE_SIZE) + ") and \"cursor\" (the cursor returned with the previous page).\n"
+        "Paged outputs are ordered by txid instead of height.\n",
         {
             {"addresses", RPCArg::Type::ARR, RPCArg::Default{UniValue::VARR}, "",
                 {
@@ -472,7 +535,8 @@ static RPCHelpMan getaddressutxos()
                 },
             },
         },
-        RPCResult{
+        {
+            RPCResult{"if \"limit\" is not set",
             RPCResult::Type::ARR, "", "",
             {
                 {RPCResult::Type::OBJ, "", "",
@@ -485,8 +549,22 @@ static RPCHelpMan getaddressutxos()
                     {RPCResult::Type::NUM, "height", "The block height"},
                 }},
             }},
+            RPCResult{"if \"limit\" is set",
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::ARR, "utxos", "",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::ELISION, "", "Same output as without \"limit\""},
+                    }},
+                }},
+                {RPCResult::Type::STR_HEX, "cursor", /*optional=*/true, "The cursor of the next page, not set on the last page"},
+            }},
+        },
         RPCExamples{
             HelpExampleCli("getaddressutxos", "'{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"]}'")
+    + HelpExampleCli("getaddressutxos", "'{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"], \"limit\": 1000}'")
     + HelpExampleRpc("getaddressutxos", "{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"]}")
         },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
@@ -504,15 +582,32 @@ static RPCHelpMan getaddressutxos()
         throw JSONRPCError(RPC_MISC_ERROR, strprintf("Address index is syncing. Current height: %d", g_addressindex->GetSummary().best_block_height));
     }
 
+    const size_t limit{getAddressPageLimit(request.params)};
+    const auto cursor{getAddressPageCursor<CAddressUnspentKey>(request.params)};
+    if (cursor && limit == 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Cursor requires a limit");
+    }
+
     std::vector<CAddressUnspentIndexEntry> unspentOutputs;
 
-    for (const auto& address : addresses) {
+    // Read one more output than requested to find out whether there is a next page
+    const size_t first{getAddressPageStart(addresses, cursor)};
+    for (size_t i = first; i < addresses.size(); ++i) {
+        if (limit > 0 && unspentOutputs.size() > limit) break;
+        const auto& address{addresses[i]};
         if (!g_addressindex->GetAddressUnspentIndex(address.first, address.second, unspentOutputs,
-                                    /* height_sort = */ true)) {
+                                    /* height_sort = */ limit == 0, i == first ? cursor : std::nullopt,
+                                    limit > 0 ? limit + 1 - unspentOutputs.size() : 0)) {
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
         }
     }
 
+    std::optional<CAddressUnspentKey> next_cursor;
+    if (limit > 0 && unspentOutputs.size() > limit) {
+        unspentOutputs.resize(limit);
+        next_cursor = unspentOutputs.back().first;
+    }
+
     UniValue result(UniValue::VARR);
 
     for (const auto& [unspentKey, unspentValue] : unspentOutputs) {
@@ -531,6 +626,15 @@ static RPCHelpMan getaddressutxos()
         result.push_back(output);
     }
 
+    if (limit > 0) {
+        UniValue page(UniValue::VOBJ);
+        page.pushKV("utxos", result);
+        if (next_cursor) {
+            page.pushKV("cursor", encodeAddressPageCursor(*next_cursor));
+        }
+        return page;
+    }
+
     return result;
 },
     };
@@ -539,7 +643,9 @@ static RPCHelpMan getaddressutxos()
 static RPCHelpMan getaddressdeltas()
 {
     return RPCHelpMan{"getaddressdeltas",
-        "\nReturns all changes for an address (requires addressindex to be enabled).\n",
+        "\nReturns all changes for an address (requires addressindex to be enabled).\n"
+        "Large results can be paged through by passing an object with \"addresses\", \"limit\" (the maximum number\n"
+        "of changes per page, at most " + ToString(MAX_ADDRESS_PAGE_SIZE) + ") and \"cursor\" (the cursor returned with the previous page).\n",
         {
             {"addresses", RPCArg::Type::ARR, RPCArg::Default{UniValue::VARR}, "",
                 {
@@ -547,7 +653,8 @@ static RPCHelpMan getaddressdeltas()
                 },
             },
         },
-        RPCResult{
+        {
+            RPCResult{"if \"limit\" is not set",
             RPCResult::Type::ARR, "", "",
             {
                 {RPCResult::Type::OBJ, "", "",
@@ -560,8 +667,22 @@ static RPCHelpMan getaddressdeltas()
                     {RPCResult::Type::STR, "address", "The base58check encoded address"},
                 }},
             }},
+            RPCResult{"if \"limit\" is set",
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::ARR, "deltas", "",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::ELISION, "", "Same output as without \"limit\""},
+                    }},
+                }},
+                {RPCResult::Type::STR_HEX, "cursor", /*optional=*/true, "The cursor of the next page, not set on the last page"},
+            }},
+        },
         RPCExamples{
             HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"]}'")
+    + HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"], \"limit\": 1000}'")
     + HelpExampleRpc("getaddressdeltas", "{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"]}")
         },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
@@ -596,14 +717,31 @@ static RPCHelpMan getaddressdeltas()
         throw JSONRPCError(RPC_MISC_ERROR, strprintf("Address index is syncing. Current height: %d", g_addressindex->GetSummary().best_block_height));
     }
 
-    for (const auto& address : addresses) {
+    const size_t limit{getAddressPageLimit(request.params)};
+    const auto cursor{getAddressPageCursor<CAddressIndexKey>(request.params)};
+    if (cursor && limit == 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Cursor requires a limit");
+    }
+
+    // Read one more change than requested to find out whether there is a next page
+    const size_t first{getAddressPageStart(addresses, cursor)};
+    for (size_t i = first; i < addresses.size(); ++i) {
+        if (limit > 0 && addressIndex.size() > limit) break;
+        const auto& address{addresses[i]};
         if (start <= 0 || end <= 0) { start = 0; end = 0; }
         if (!g_addressindex->GetAddressIndex(address.first, address.second,
-                                             addressIndex, start, end)) {
+                                             addressIndex, start, end, i == first ? cursor : std::nullopt,
+                                             limit > 0 ? limit + 1 - addressIndex.size() : 0)) {
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
         }
     }
 
+    std::optional<CAddressIndexKey> next_cursor;
+    if (limit > 0 && addressIndex.size() > limit) {
+        addressIndex.resize(limit);
+        next_cursor = addressIndex.back().first;
+    }
+
     UniValue result(UniValue::VARR);
 
     for (const auto& [indexKey, indexDelta] : addressIndex) {
@@ -622,6 +760,15 @@ static RPCHelpMan getaddressdeltas()
         result.push_back(delta);
     }
 
+    if (limit > 0) {
+        UniValue page(UniValue::VOBJ);
+        page.pushKV("deltas", result);
+        if (next_cursor) {
+            page.pushKV("cursor", encodeAddressPageCursor(*next_cursor));
+        }
+        return page;
+    }
+
     return result;
 },
     };
@@ -645,6 +792,9 @@ static RPCHelpMan getaddressbalance()
                     {RPCResult::Type::NUM, "balance_immature", "The current immature balance in duffs"},
                     {RPCResult::Type::NUM, "balance_spendable", "The current spendable balance in duffs"},
                     {RPCResult::Type::NUM, "received", "The total number of duffs received (including change)"},
+                    {RPCResult::Type::NUM, "tx_count", "The number of transactions touching the address(es), summed per address"},
+                    {RPCResult::Type::NUM, "first_seen_height", /*optional=*/true, "The lowest height of a block touching the address(es)"},
+                    {RPCResult::Type::NUM, "last_seen_height", /*optional=*/true, "The highest height of a block touching the address(es)"},
                 }},
         RPCExamples{
             HelpExampleCli("getaddressbalance", "'{\"addresses\": [\"" + EXAMPLE_ADDRESS[0] + "\"]}'")
@@ -658,8 +808,6 @@ static RPCHelpMan getaddressbalance()
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
     }
 
-    std::vector<CAddressIndexEntry> addressIndex;
-
     if (!g_addressindex) {
         throw JSONRPCError(RPC_MISC_ERROR, "Address index is not enabled. Start with -addressindex to enable.");
     }
@@ -668,41 +816,53 @@ static RPCHelpMan getaddressbalance()
         throw JSONRPCError(RPC_MISC_ERROR, strprintf("Address index is syncing. Current height: %d", g_addressindex->GetSummary().best_block_height));
     }
 
-    int nHeight;
+    CAmount balance = 0;
+    CAmount balance_spendable = 0;
+    CAmount balance_immature = 0;
+    CAmount received = 0;
+    uint64_t tx_count = 0;
+    std::optional<int32_t> first_seen_height;
+    std::optional<int32_t> last_seen_height;
+
     {
         LOCK(::cs_main);
+        const int nHeight = g_addressindex->GetSummary().best_block_height;
+        // Only coinbase outputs of the last COINBASE_MATURITY blocks can be immature
+        const int immature_start = std::max(1, nHeight - COINBASE_MATURITY + 1);
         for (const auto& address : addresses) {
+            const CAddressSummary summary{g_addressindex->GetAddressSummary(address.first, address.second)};
+            if (summary.IsNull()) continue;
+            balance += summary.m_balance;
+            received += summary.m_received;
+            tx_count += summary.m_tx_count;
+            first_seen_height = std::min(first_seen_height.value_or(summary.m_first_height), summary.m_first_height);
+            last_seen_height = std::max(last_seen_height.value_or(summary.m_last_height), summary.m_last_height);
+
+            if (summary.m_last_height < immature_start) continue;
+            std::vector<CAddressIndexEntry> addressIndex;
             if (!g_addressindex->GetAddressIndex(address.first, address.second, addressIndex,
-                                                 /*start=*/0, /*end=*/0)) {
+                                                 immature_start, std::max(nHeight, immature_start))) {
                 throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
             }
+            for (const auto& [indexKey, indexDelta] : addressIndex) {
+                if (indexKey.m_block_tx_pos == 0 && nHeight - indexKey.m_block_height < COINBASE_MATURITY) {
+                    balance_immature += indexDelta;
+                }
+            }
         }
-        nHeight = g_addressindex->GetSummary().best_block_height;
-    }
-
-
-    CAmount balance = 0;
-    CAmount balance_spendable = 0;
-    CAmount balance_immature = 0;
-    CAmount received = 0;
-
-    for (const auto& [indexKey, indexDelta] : addressIndex) {
-        if (indexDelta > 0) {
-            received += indexDelta;
-        }
-        if (indexKey.m_block_tx_pos == 0 && nHeight - indexKey.m_block_height < COINBASE_MATURITY) {
-            balance_immature += indexDelta;
-        } else {
-            balance_spendable += indexDelta;
-        }
-        balance += indexDelta;
     }
+    balance_spendable = balance - balance_immature;
 
     UniValue result(UniValue::VOBJ);
     result.pushKV("balance", balance);
     result.pushKV("balance_immature", balance_immature);
     result.pushKV("balance_spendable", balance_spendable);
     result.pushKV("received", received);
+    result.pushKV("tx_count", tx_count);
+    if (first_seen_height) {
+        result.pushKV("first_seen_height", *first_seen_height);
+        result.pushKV("last_seen_height", *last_seen_height);
+    }
 
     return result;
 
@@ -0,0 +1,353 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <clientversion.h>
+#include <hash.h>
+#include <index/addressindex.h>
+#include <index/spentindex.h>
+#include <index/timestampindex.h>
+#include <key.h>
+#include <random.h>
+#include <script/standard.h>
+#include <streams.h>
+#include <test/util/index.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace addressindex_tests {
+class TestAddressIndexDB
+{
+public:
+    using DB = AddressIndex::DB;
+
+    static bool ReadBucket(DB& db, const uint160& address_hash, int32_t height, CAddressIndexBucket& bucket)
+    {
+        return db.ReadBucket(AddressType::P2PK_OR_P2PKH, address_hash, height, bucket);
+    }
+};
+} // namespace addressindex_tests
+
+using addressindex_tests::TestAddressIndexDB;
+
+//! Height the open bucket of an address is stored at
+static constexpr int32_t OPEN_BUCKET_HEIGHT{std::numeric_limits<int32_t>::max()};
+
+static uint160 MakeAddressHash(uint8_t n)
+{
+    uint160 address_hash;
+    *address_hash.begin() = n;
+    return address_hash;
+}
+
+static CAddressIndexEntry MakeEntry(const uint160& address_hash, int32_t height, uint32_t tx_pos, const uint256& tx_hash,
+                                    uint32_t tx_index, CAmount amount)
+{
+    return {CAddressIndexKey(AddressType::P2PK_OR_P2PKH, address_hash, height, tx_pos, tx_hash, tx_index, amount < 0), amount};
+}
+
+//! One single output transaction per height in [first, last]
+static std::vector<CAddressIndexEntry> MakeHistory(const uint160& address_hash, int32_t first, int32_t last)
+{
+    std::vector<CAddressIndexEntry> entries;
+    for (int32_t height = first; height <= last; ++height) {
+        entries.push_back(MakeEntry(address_hash, height, 1, ArithToUint256(height), 0, COIN));
+    }
+    return entries;
+}
+
+static std::vector<CAddressIndexEntry> ReadHistory(TestAddressIndexDB::DB& db, const uint160& address_hash)
+{
+    std::vector<CAddressIndexEntry> entries;
+    BOOST_REQUIRE(db.ReadAddressIndex(address_hash, AddressType::P2PK_OR_P2PKH, entries));
+    return entries;
+}
+
+static CAddressSummary ReadSummary(TestAddressIndexDB::DB& db, const uint160& address_hash)
+{
+    CAddressSummary summary;
+    db.ReadAddressSummary(address_hash, AddressType::P2PK_OR_P2PKH, summary);
+    return summary;
+}
+
+BOOST_AUTO_TEST_SUITE(addressindex_tests)
+
+BOOST_FIXTURE_TEST_CASE(bucket_serialization, BasicTestingSetup)
+{
+    const uint160 address_hash{MakeAddressHash(1)};
+    const uint256 txid1{GetRandHash()}, txid2{GetRandHash()}, txid3{GetRandHash()};
+
+    CAddressIndexBucket bucket;
+    bucket.m_last_height = 1000000;
+    bucket.m_entries = {
+        MakeEntry(address_hash, 5, 1, txid1, 0, 0),
+        MakeEntry(address_hash, 5, 1, txid1, 3, -MAX_MONEY),
+        MakeEntry(address_hash, 5, 2, txid2, 1, 123456789),
+        MakeEntry(address_hash, 1000000, 7, txid3, 70000, -1),
+    };
+
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << bucket;
+    CAddressIndexBucket decoded;
+    ss >> decoded;
+    BOOST_CHECK(ss.empty());
+    BOOST_CHECK_EQUAL(decoded.m_last_height, bucket.m_last_height);
+    // The address is only part of the database key
+    decoded.SetAddress(AddressType::P2PK_OR_P2PKH, address_hash);
+    BOOST_CHECK(SerializeHash(decoded.m_entries) == SerializeHash(bucket.m_entries));
+
+    // Entries of one transaction store its hash once
+    CAddressIndexBucket split{bucket};
+    split.m_entries[1].first.m_block_tx_pos = 3;
+    CDataStream ss_split(SER_DISK, CLIENT_VERSION);
+    ss_split << split;
+    BOOST_CHECK_EQUAL(ss_split.size(), ::GetSerializeSize(bucket, CLIENT_VERSION) + uint256::size());
+}
+
+BOOST_FIXTURE_TEST_CASE(bucket_sealing, BasicTestingSetup)
+{
+    TestAddressIndexDB::DB db(1 << 20, true);
+    const uint160 address_hash{MakeAddressHash(1)}, other_hash{MakeAddressHash(2)};
+    const int32_t full_height{static_cast<int32_t>(MAX_BUCKET_ENTRIES)};
+
+    // A full bucket stays open until an entry of a later block arrives
+    BOOST_REQUIRE(db.WriteBatch(MakeHistory(address_hash, 1, full_height), {}));
+    CAddressIndexBucket bucket;
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, address_hash, OPEN_BUCKET_HEIGHT, bucket));
+    BOOST_CHECK_EQUAL(bucket.m_entries.size(), MAX_BUCKET_ENTRIES);
+    BOOST_CHECK(!TestAddressIndexDB::ReadBucket(db, address_hash, full_height, bucket));
+
+    // It is then sealed under the height of its last entry
+    BOOST_REQUIRE(db.WriteBatch({MakeEntry(address_hash, full_height + 1, 1, uint256::ONE, 0, COIN),
+                                 MakeEntry(address_hash, full_height + 1, 1, uint256::ONE, 1, COIN)}, {}));
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, address_hash, full_height, bucket));
+    BOOST_CHECK_EQUAL(bucket.m_entries.size(), MAX_BUCKET_ENTRIES);
+    BOOST_CHECK_EQUAL(bucket.m_entries.back().first.m_block_height, full_height);
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, address_hash, OPEN_BUCKET_HEIGHT, bucket));
+    BOOST_CHECK_EQUAL(bucket.m_entries.size(), 2U);
+    BOOST_CHECK_EQUAL(bucket.m_last_height, full_height + 1);
+
+    const auto history{ReadHistory(db, address_hash)};
+    BOOST_REQUIRE_EQUAL(history.size(), MAX_BUCKET_ENTRIES + 2);
+    BOOST_CHECK(std::is_sorted(history.begin(), history.end(), [](const auto& a, const auto& b) {
+        return CAddressIndexKeyCompare{}(a.first, b.first);
+    }));
+    const CAddressSummary summary{ReadSummary(db, address_hash)};
+    BOOST_CHECK_EQUAL(summary.m_tx_count, MAX_BUCKET_ENTRIES + 1);
+    BOOST_CHECK_EQUAL(summary.m_balance, static_cast<CAmount>(MAX_BUCKET_ENTRIES + 2) * COIN);
+    BOOST_CHECK_EQUAL(summary.m_last_height, full_height + 1);
+
+    // The entries of one block are never split across buckets
+    auto entries{MakeHistory(other_hash, 1, full_height - 1)};
+    entries.push_back(MakeEntry(other_hash, full_height, 1, uint256::ONE, 0, COIN));
+    entries.push_back(MakeEntry(other_hash, full_height, 1, uint256::ONE, 1, COIN));
+    BOOST_REQUIRE(db.WriteBatch(entries, {}));
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, other_hash, OPEN_BUCKET_HEIGHT, bucket));
+    BOOST_CHECK_EQUAL(bucket.m_entries.size(), MAX_BUCKET_ENTRIES + 1);
+    BOOST_CHECK(!TestAddressIndexDB::ReadBucket(db, other_hash, full_height, bucket));
+}
+
+BOOST_FIXTURE_TEST_CASE(bucket_rewind_reopen, BasicTestingSetup)
+{
+    TestAddressIndexDB::DB db(1 << 20, true);
+    const uint160 address_hash{MakeAddressHash(1)};
+    const int32_t full_height{static_cast<int32_t>(MAX_BUCKET_ENTRIES)};
+    const auto entries{MakeHistory(address_hash, 1, full_height + 1)};
+    BOOST_REQUIRE(db.WriteBatch(entries, {}));
+    CAddressIndexBucket bucket;
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, address_hash, full_height, bucket));
+
+    // Rewinding the block after the sealed bucket leaves the open bucket empty
+    BOOST_REQUIRE(db.RewindBatch(full_height + 1, {entries.back()}, {}));
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, address_hash, OPEN_BUCKET_HEIGHT, bucket));
+    BOOST_CHECK(bucket.m_entries.empty());
+    BOOST_CHECK_EQUAL(bucket.m_last_height, full_height);
+    BOOST_CHECK_EQUAL(ReadHistory(db, address_hash).size(), MAX_BUCKET_ENTRIES);
+    CAddressSummary summary{ReadSummary(db, address_hash)};
+    BOOST_CHECK_EQUAL(summary.m_tx_count, MAX_BUCKET_ENTRIES);
+    BOOST_CHECK_EQUAL(summary.m_last_height, full_height);
+
+    // Rewinding the last block of the sealed bucket reopens it
+    BOOST_REQUIRE(db.RewindBatch(full_height, {entries[full_height - 1]}, {}));
+    BOOST_CHECK(!TestAddressIndexDB::ReadBucket(db, address_hash, full_height, bucket));
+    BOOST_REQUIRE(TestAddressIndexDB::ReadBucket(db, address_hash, OPEN_BUCKET_HEIGHT, bucket));
+    BOOST_CHECK_EQUAL(bucket.m_entries.size(), MAX_BUCKET_ENTRIES - 1);
+    BOOST_CHECK_EQUAL(bucket.m_last_height, full_height - 1);
+    summary = ReadSummary(db, address_hash);
+    BOOST_CHECK_EQUAL(summary.m_tx_count, MAX_BUCKET_ENTRIES - 1);
+    BOOST_CHECK_EQUAL(summary.m_balance, static_cast<CAmount>(MAX_BUCKET_ENTRIES - 1) * COIN);
+    BOOST_CHECK_EQUAL(summary.m_last_height, full_height - 1);
+
+    // Reconnecting the block appends to the reopened bucket
+    BOOST_REQUIRE(db.WriteBatch({entries[full_height - 1]}, {}));
+    BOOST_CHECK_EQUAL(ReadHistory(db, address_hash).size(), MAX_BUCKET_ENTRIES);
+    BOOST_CHECK_EQUAL(ReadSummary(db, address_hash).m_last_height, full_height);
+
+    // Rewinding everything leaves no history
+    for (int32_t height = full_height; height > 0; --height) {
+        BOOST_REQUIRE(db.RewindBatch(height, {entries[height - 1]}, {}));
+    }
+    BOOST_CHECK(ReadHistory(db, address_hash).empty());
+    BOOST_CHECK(ReadSummary(db, address_hash).IsNull());
+}
+
+BOOST_FIXTURE_TEST_CASE(bucket_replay, BasicTestingSetup)
+{
+    TestAddressIndexDB::DB db(1 << 20, true);
+    const uint160 address_hash{MakeAddressHash(1)};
+    BOOST_REQUIRE(db.WriteBatch(MakeHistory(address_hash, 1, 3), {}));
+
+    // A batch written again after an unclean shutdown only appends the blocks after m_last_height
+    BOOST_REQUIRE(db.WriteBatch(MakeHistory(address_hash, 2, 5), {}));
+    const auto history{ReadHistory(db, address_hash)};
+    BOOST_REQUIRE_EQUAL(history.size(), 5U);
+    for (size_t i = 0; i < history.size(); ++i) {
+        BOOST_CHECK_EQUAL(history[i].first.m_block_height, static_cast<int32_t>(i + 1));
+    }
+    const CAddressSummary summary{ReadSummary(db, address_hash)};
+    BOOST_CHECK_EQUAL(summary.m_tx_count, 5U);
+    BOOST_CHECK_EQUAL(summary.m_balance, 5 * COIN);
+    BOOST_CHECK_EQUAL(summary.m_first_height, 1);
+    BOOST_CHECK_EQUAL(summary.m_last_height, 5);
+
+    // Replaying the whole history changes nothing
+    BOOST_REQUIRE(db.WriteBatch(MakeHistory(address_hash, 1, 5), {}));
+    BOOST_CHECK(SerializeHash(ReadHistory(db, address_hash)) == SerializeHash(history));
+    BOOST_CHECK_EQUAL(ReadSummary(db, address_hash).m_tx_count, 5U);
+}
+
+BOOST_FIXTURE_TEST_CASE(batched_sync_matches_serial, TestChain100Setup)
+{
+    auto& chainstate = m_node.chainman->ActiveChainstate();
+
+    // Indexes started now write the blocks mined below one at a time
+    AddressIndex address_serial(1 << 20, true);
+    SpentIndex spent_serial(1 << 20, true);
+    TimestampIndex timestamp_serial(1 << 20, true);
+    for (BaseIndex* index : {(BaseIndex*)&address_serial, (BaseIndex*)&spent_serial, (BaseIndex*)&timestamp_serial}) {
+        BOOST_REQUIRE(index->Start(chainstate));
+        IndexWaitSynced(*index);
+    }
+
+    CKey key1, key2;
+    key1.MakeNewKey(/*fCompressed=*/true);
+    key2.MakeNewKey(/*fCompressed=*/true);
+    const CScript coinbase_script{GetScriptForRawPubKey(coinbaseKey.GetPubKey())};
+    std::vector<COutPoint> spent;
+    CTransactionRef prev_tx;
+    int prev_height{0};
+    for (int i = 0; i < 20; ++i) {
+        std::vector<CMutableTransaction> txs;
+        // Pay a mature coinbase to key1 and move what key1 got in the previous block on to key2
+        txs.push_back(CreateValidMempoolTransaction(m_coinbase_txns[i], 0, i + 1, coinbaseKey,
+                                                    GetScriptForDestination(PKHash(key1.GetPubKey())), 10 * COIN,
+                                                    /*submit=*/false));
+        spent.emplace_back(m_coinbase_txns[i]->GetHash(), 0);
+        if (prev_tx) {
+            txs.push_back(CreateValidMempoolTransaction(prev_tx, 0, prev_height, key1,
+                                                        GetScriptForDestination(PKHash(key2.GetPubKey())), 5 * COIN,
+                                                        /*submit=*/false));
+            spent.emplace_back(prev_tx->GetHash(), 0);
+        }
+        prev_tx = MakeTransactionRef(txs.front());
+        CreateAndProcessBlock(txs, coinbase_script);
+        prev_height = WITH_LOCK(::cs_main, return chainstate.m_chain.Height());
+    }
+
+    // Indexes started afterwards catch up with the whole chain in batches
+    AddressIndex address_batched(1 << 20, true);
+    SpentIndex spent_batched(1 << 20, true);
+    TimestampIndex timestamp_batched(1 << 20, true);
+    for (BaseIndex* index : {(BaseIndex*)&address_batched, (BaseIndex*)&spent_batched, (BaseIndex*)&timestamp_batched}) {
+        BOOST_REQUIRE(index->Start(chainstate));
+        IndexWaitSynced(*index);
+    }
+    for (BaseIndex* index : {(BaseIndex*)&address_serial, (BaseIndex*)&spent_serial, (BaseIndex*)&timestamp_serial}) {
+        BOOST_REQUIRE(index->BlockUntilSyncedToCurrentChain());
+    }
+
+    for (const CKey* key : {&coinbaseKey, &key1, &key2}) {
+        const uint160 address_hash{key->GetPubKey().GetID()};
+
+        std::vector<CAddressIndexEntry> history_serial, history_batched;
+        BOOST_REQUIRE(address_serial.GetAddressIndex(address_hash, AddressType::P2PK_OR_P2PKH, history_serial));
+        BOOST_REQUIRE(address_batched.GetAddressIndex(address_hash, AddressType::P2PK_OR_P2PKH, history_batched));
+        BOOST_CHECK(!history_serial.empty());
+        BOOST_CHECK(SerializeHash(history_serial) == SerializeHash(history_batched));
+
+        std::vector<CAddressUnspentIndexEntry> unspent_serial, unspent_batched;
+        BOOST_REQUIRE(address_serial.GetAddressUnspentIndex(address_hash, AddressType::P2PK_OR_P2PKH, unspent_serial));
+        BOOST_REQUIRE(address_batched.GetAddressUnspentIndex(address_hash, AddressType::P2PK_OR_P2PKH, unspent_batched));
+        BOOST_CHECK(!unspent_serial.empty());
+        BOOST_CHECK(SerializeHash(unspent_serial) == SerializeHash(unspent_batched));
+
+        const CAddressSummary summary_serial{address_serial.GetAddressSummary(address_hash, AddressType::P2PK_OR_P2PKH)};
+        const CAddressSummary summary_batched{address_batched.GetAddressSummary(address_hash, AddressType::P2PK_OR_P2PKH)};
+        BOOST_CHECK(!summary_serial.IsNull());
+        BOOST_CHECK(SerializeHash(summary_serial) == SerializeHash(summary_batched));
+    }
+
+    for (const COutPoint& outpoint : spent) {
+        CSpentIndexValue value_serial, value_batched;
+        BOOST_REQUIRE(spent_serial.GetSpentInfo({outpoint.hash, outpoint.n}, value_serial));
+        BOOST_REQUIRE(spent_batched.GetSpentInfo({outpoint.hash, outpoint.n}, value_batched));
+        BOOST_CHECK(SerializeHash(value_serial) == SerializeHash(value_batched));
+    }
+
+    std::vector<uint256> hashes_serial, hashes_batched;
+    BOOST_REQUIRE(timestamp_serial.GetBlockHashes(std::numeric_limits<uint32_t>::max(), 0, hashes_serial));
+    BOOST_REQUIRE(timestamp_batched.GetBlockHashes(std::numeric_limits<uint32_t>::max(), 0, hashes_batched));
+    // Every block but genesis
+    BOOST_CHECK_EQUAL(hashes_serial.size(), static_cast<size_t>(prev_height));
+    BOOST_CHECK(hashes_serial == hashes_batched);
+
+    // Shutdown sequence (c.f. Shutdown() in init.cpp)
+    SyncWithValidationInterfaceQueue();
+    for (BaseIndex* index : {(BaseIndex*)&address_serial, (BaseIndex*)&spent_serial, (BaseIndex*)&timestamp_serial,
+                             (BaseIndex*)&address_batched, (BaseIndex*)&spent_batched, (BaseIndex*)&timestamp_batched}) {
+        index->Stop();
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(unspent_paging, BasicTestingSetup)
+{
+    TestAddressIndexDB::DB db(1 << 20, true);
+    const uint160 address_hash{MakeAddressHash(1)};
+    const uint256 txid{GetRandHash()};
+
+    // Output indexes are stored little-endian, so 256 sorts between 0 and 1 in the database
+    std::vector<CAddressUnspentIndexEntry> outputs;
+    for (uint32_t n = 0; n < 300; ++n) {
+        outputs.emplace_back(CAddressUnspentKey(AddressType::P2PK_OR_P2PKH, address_hash, txid, n),
+                             CAddressUnspentValue(COIN, CScript() << OP_TRUE, 1));
+    }
+    BOOST_REQUIRE(db.UpdateAddressUnspentIndex(outputs));
+
+    std::vector<uint32_t> indexes;
+    std::optional<CAddressUnspentKey> after;
+    while (true) {
+        std::vector<CAddressUnspentIndexEntry> page;
+        BOOST_REQUIRE(db.ReadAddressUnspentIndex(address_hash, AddressType::P2PK_OR_P2PKH, page, /*height_sort=*/false,
+                                                 after, /*limit=*/50));
+        if (page.empty()) break;
+        for (const auto& [key, _] : page) {
+            indexes.push_back(key.m_tx_index);
+        }
+        after = page.back().first;
+    }
+    BOOST_CHECK_EQUAL(indexes.size(), outputs.size());
+    std::sort(indexes.begin(), indexes.end());
+    for (uint32_t n = 0; n < indexes.size(); ++n) {
+        BOOST_CHECK_EQUAL(indexes[n], n);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
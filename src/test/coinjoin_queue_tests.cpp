@@ -188,4 +188,75 @@ BOOST_AUTO_TEST_CASE(queuemanager_getqueueitem_marks_tried_once)
     BOOST_CHECK(!man.GetQueueItemAndTry(picked2));
 }
 
+BOOST_AUTO_TEST_CASE(queuemanager_lookups)
+{
+    CoinJoinQueueManager man;
+    const int denom = CoinJoin::AmountToDenomination(CoinJoin::GetSmallestDenomination());
+    const int64_t now = GetAdjustedTime();
+    const COutPoint mn_a(uint256S("31"), 0);
+    const COutPoint mn_b(uint256S("32"), 0);
+    CCoinJoinQueue dsq = MakeQueue(denom, now, false, mn_a);
+    man.AddQueue(dsq);
+
+    BOOST_CHECK(man.HasQueue(dsq.GetHash()));
+    BOOST_CHECK(man.GetQueueFromHash(dsq.GetHash()) == dsq);
+    BOOST_CHECK(!man.HasQueue(uint256::ONE));
+    BOOST_CHECK(!man.GetQueueFromHash(uint256::ONE).has_value());
+
+    BOOST_CHECK(man.HasQueueFromMasternode(mn_a, false));
+    BOOST_CHECK(!man.HasQueueFromMasternode(mn_a, true));
+    BOOST_CHECK(!man.HasQueueFromMasternode(mn_b, false));
+    BOOST_CHECK_EQUAL(man.TryHasQueueFromMasternode(mn_a).value(), true);
+    BOOST_CHECK_EQUAL(man.TryHasQueueFromMasternode(mn_b).value(), false);
+
+    // Exact duplicate and same readiness from the same masternode are rejected, the other readiness is not
+    BOOST_CHECK_EQUAL(man.TryCheckDuplicate(dsq).value(), true);
+    BOOST_CHECK_EQUAL(man.TryCheckDuplicate(MakeQueue(denom, now + 1, false, mn_a)).value(), true);
+    BOOST_CHECK_EQUAL(man.TryCheckDuplicate(MakeQueue(denom, now, true, mn_a)).value(), false);
+    BOOST_CHECK_EQUAL(man.TryCheckDuplicate(MakeQueue(denom, now, false, mn_b)).value(), false);
+
+    // Adding the same queue twice doesn't create a second entry
+    man.AddQueue(dsq);
+    BOOST_CHECK_EQUAL(man.GetQueueSize(), 1);
+
+    man.SetNull();
+    BOOST_CHECK_EQUAL(man.GetQueueSize(), 0);
+    BOOST_CHECK(!man.HasQueue(dsq.GetHash()));
+    BOOST_CHECK(!man.HasQueueFromMasternode(mn_a, false));
+}
+
+BOOST_AUTO_TEST_CASE(queuemanager_getqueueitem_order_and_bounds)
+{
+    CoinJoinQueueManager man;
+    const int denom = CoinJoin::AmountToDenomination(CoinJoin::GetSmallestDenomination());
+    const int64_t now = GetAdjustedTime();
+    // From the future, not usable yet
+    man.AddQueue(MakeQueue(denom, now + COINJOIN_QUEUE_TIMEOUT + 10, false, COutPoint(uint256S("41"), 0)));
+    // Already tried before it was added
+    CCoinJoinQueue tried = MakeQueue(denom, now - 3, false, COutPoint(uint256S("42"), 0));
+    tried.fTried = true;
+    man.AddQueue(tried);
+    man.AddQueue(MakeQueue(denom, now - 1, false, COutPoint(uint256S("43"), 0)));
+    man.AddQueue(MakeQueue(denom, now - 2, false, COutPoint(uint256S("44"), 0)));
+    // Too old
+    man.AddQueue(MakeQueue(denom, now - COINJOIN_QUEUE_TIMEOUT - 10, false, COutPoint(uint256S("45"), 0)));
+
+    // Oldest usable queue first
+    CCoinJoinQueue picked;
+    BOOST_CHECK(man.GetQueueItemAndTry(picked));
+    BOOST_CHECK(picked.masternodeOutpoint == COutPoint(uint256S("44"), 0));
+    BOOST_CHECK(picked.fTried);
+    BOOST_CHECK(man.GetQueueItemAndTry(picked));
+    BOOST_CHECK(picked.masternodeOutpoint == COutPoint(uint256S("43"), 0));
+    BOOST_CHECK(!man.GetQueueItemAndTry(picked));
+
+    // Both out of bounds queues are removed, tried queues are kept until they time out
+    BOOST_CHECK_EQUAL(man.GetQueueSize(), 5);
+    man.CheckQueue();
+    BOOST_CHECK_EQUAL(man.GetQueueSize(), 3);
+    BOOST_CHECK(!man.HasQueueFromMasternode(COutPoint(uint256S("41"), 0), false));
+    BOOST_CHECK(!man.HasQueueFromMasternode(COutPoint(uint256S("45"), 0), false));
+    BOOST_CHECK(man.HasQueueFromMasternode(COutPoint(uint256S("42"), 0), false));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
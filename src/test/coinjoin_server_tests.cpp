@@ -0,0 +1,119 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <active/masternode.h>
+#include <bls/bls.h>
+#include <coinjoin/common.h>
+#include <coinjoin/server.h>
+#include <key.h>
+#include <llmq/context.h>
+#include <script/sign.h>
+#include <script/signingprovider.h>
+#include <script/standard.h>
+#include <uint256.h>
+#include <util/check.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace coinjoin_server_tests {
+class TestCoinJoinServer
+{
+public:
+    static void AddEntry(CCoinJoinServer& server, CCoinJoinEntry entry)
+    {
+        LOCK(server.cs_coinjoin);
+        server.vecEntries.emplace_back(std::move(entry));
+    }
+
+    static CMutableTransaction BuildFinalTransaction(CCoinJoinServer& server)
+    {
+        LOCK(server.cs_coinjoin);
+        server.BuildFinalTransaction();
+        return server.finalMutableTransaction;
+    }
+
+    static CMutableTransaction GetFinalTransaction(CCoinJoinServer& server)
+    {
+        LOCK(server.cs_coinjoin);
+        return server.finalMutableTransaction;
+    }
+
+    static bool AddScriptSig(CCoinJoinServer& server, const CTxIn& txin) { return server.AddScriptSig(txin); }
+    static bool IsSignaturesComplete(CCoinJoinServer& server) { return server.IsSignaturesComplete(); }
+};
+} // namespace coinjoin_server_tests
+
+BOOST_FIXTURE_TEST_SUITE(coinjoin_server_tests, TestingSetup)
+
+static CCoinJoinEntry MakeEntry(const CKey& key, const COutPoint& prevout)
+{
+    const CScript script{GetScriptForDestination(PKHash(key.GetPubKey()))};
+    CCoinJoinEntry entry;
+    entry.vecTxDSIn.emplace_back(CTxIn(prevout), script, /*nRounds=*/0);
+    entry.vecTxOut.emplace_back(CoinJoin::GetSmallestDenomination(), script);
+    return entry;
+}
+
+static CTxIn SignInput(const CKey& key, const CMutableTransaction& tx, const COutPoint& prevout)
+{
+    FillableSigningProvider keystore;
+    BOOST_REQUIRE(keystore.AddKey(key));
+    CMutableTransaction txSigned{tx};
+    for (size_t i = 0; i < txSigned.vin.size(); ++i) {
+        if (txSigned.vin[i].prevout != prevout) continue;
+        BOOST_REQUIRE(SignSignature(keystore, GetScriptForDestination(PKHash(key.GetPubKey())), txSigned, i, /*amount=*/0, SIGHASH_ALL));
+        return txSigned.vin[i];
+    }
+    BOOST_FAIL("input not found");
+    return {};
+}
+
+BOOST_AUTO_TEST_CASE(dssignfinaltx_signatures)
+{
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    CActiveMasternodeManager mn_activeman(*Assert(m_node.connman), *Assert(m_node.dmnman), sk);
+    CCoinJoinServer server(m_node.peerman.get(), *Assert(m_node.chainman), *Assert(m_node.connman), *Assert(m_node.dmnman),
+                           *Assert(m_node.dstxman), *Assert(m_node.mn_metaman), *Assert(m_node.mempool), mn_activeman,
+                           *Assert(m_node.mn_sync), *Assert(m_node.llmq_ctx)->isman);
+
+    // Same prevout hash, so BIP69 orders the inputs by index and the final transaction
+    // has them in the opposite order of the entries
+    CKey key1, key2;
+    key1.MakeNewKey(/*fCompressed=*/true);
+    key2.MakeNewKey(/*fCompressed=*/true);
+    const COutPoint prevout1{uint256::ONE, 1};
+    const COutPoint prevout2{uint256::ONE, 0};
+    TestCoinJoinServer::AddEntry(server, MakeEntry(key1, prevout1));
+    TestCoinJoinServer::AddEntry(server, MakeEntry(key2, prevout2));
+
+    const CMutableTransaction txFinal{TestCoinJoinServer::BuildFinalTransaction(server)};
+    BOOST_REQUIRE_EQUAL(txFinal.vin.size(), 2U);
+    BOOST_CHECK(txFinal.vin[0].prevout == prevout2);
+    BOOST_CHECK(!TestCoinJoinServer::IsSignaturesComplete(server));
+
+    // A signature for the transaction in entry order doesn't commit to the final transaction
+    CMutableTransaction txUnsorted;
+    txUnsorted.vin = {CTxIn(prevout1), CTxIn(prevout2)};
+    txUnsorted.vout = txFinal.vout;
+    BOOST_CHECK(!TestCoinJoinServer::AddScriptSig(server, SignInput(key1, txUnsorted, prevout1)));
+    // Neither does one made with another key
+    BOOST_CHECK(!TestCoinJoinServer::AddScriptSig(server, SignInput(key2, txFinal, prevout1)));
+    BOOST_CHECK(TestCoinJoinServer::GetFinalTransaction(server).vin[1].scriptSig.empty());
+
+    // Valid signatures are stored in the final transaction
+    const CTxIn txin1{SignInput(key1, txFinal, prevout1)};
+    BOOST_CHECK(TestCoinJoinServer::AddScriptSig(server, txin1));
+    BOOST_CHECK(TestCoinJoinServer::GetFinalTransaction(server).vin[1].scriptSig == txin1.scriptSig);
+    // and only accepted once
+    BOOST_CHECK(!TestCoinJoinServer::AddScriptSig(server, txin1));
+    BOOST_CHECK(!TestCoinJoinServer::IsSignaturesComplete(server));
+
+    BOOST_CHECK(TestCoinJoinServer::AddScriptSig(server, SignInput(key2, txFinal, prevout2)));
+    BOOST_CHECK(TestCoinJoinServer::IsSignaturesComplete(server));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1084,6 +1084,44 @@ BOOST_AUTO_TEST_CASE(ccoins_flush_behavior)
     }
 }
 
+BOOST_AUTO_TEST_CASE(ccoins_sync_and_uncache)
+{
+    CCoinsViewDB base{"test", /*nCacheSize=*/ 1 << 23, /*fMemory=*/ true, /*fWipe=*/ false};
+    CCoinsViewCacheTest cache{&base};
+
+    std::vector<COutPoint> outpoints;
+    for (uint32_t height = 1; height <= 10; ++height) {
+        Coin coin = MakeCoin();
+        coin.nHeight = height;
+        outpoints.emplace_back(InsecureRand256(), 0);
+        cache.AddCoin(outpoints.back(), std::move(coin), /*possible_overwrite=*/false);
+    }
+    cache.SetBestBlock(InsecureRand256());
+    // Fill up the pool resource of the map so that keeping the erased entries' memory would show
+    std::vector<COutPoint> spent;
+    for (int i = 0; i < 10000; ++i) {
+        spent.emplace_back(InsecureRand256(), 0);
+        cache.AddCoin(spent.back(), MakeCoin(), /*possible_overwrite=*/false);
+    }
+    for (const auto& outpoint : spent) {
+        cache.SpendCoin(outpoint);
+    }
+    const size_t usage_before{cache.DynamicMemoryUsage()};
+
+    BOOST_CHECK(cache.SyncAndUncache(/*max_height=*/6));
+    cache.SelfTest();
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 4U);
+    BOOST_CHECK(cache.DynamicMemoryUsage() < usage_before / 2);
+    for (size_t i = 0; i < outpoints.size(); ++i) {
+        // Everything was written, only the coins above max_height are still cached (and clean)
+        BOOST_CHECK(base.HaveCoin(outpoints[i]));
+        BOOST_CHECK_EQUAL(cache.HaveCoinInCache(outpoints[i]), i >= 6);
+        if (i >= 6) {
+            BOOST_CHECK_EQUAL(cache.map().at(outpoints[i]).flags, 0);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(coins_resource_is_used)
 {
     CCoinsMapMemoryResource resource;
@@ -7,31 +7,76 @@
 #include <chainparams.h>
 #include <consensus/validation.h>
 #include <deploymentstatus.h>
+#include <evo/chainhelper.h>
+#include <evo/creditpool.h>
 #include <evo/deterministicmns.h>
+#include <evo/evodb.h>
+#include <evo/evosnapshot.h>
+#include <evo/mnauth.h>
 #include <evo/providertx.h>
 #include <evo/simplifiedmns.h>
 #include <evo/specialtx.h>
 #include <evo/specialtxman.h>
+#include <llmq/blockprocessor.h>
 #include <llmq/context.h>
+#include <llmq/net_quorum.h>
+#include <llmq/options.h>
+#include <llmq/quorumsman.h>
+#include <llmq/snapshot.h>
+#include <llmq/utils.h>
+#include <masternode/meta.h>
+#include <masternode/sync.h>
 #include <messagesigner.h>
+#include <net_processing.h>
+#include <netmessagemaker.h>
 #include <node/transaction.h>
+#include <node/blockstorage.h>
 #include <policy/policy.h>
 #include <script/interpreter.h>
 #include <script/sign.h>
 #include <script/signingprovider.h>
 #include <script/standard.h>
+#include <streams.h>
+#include <test/util/llmq_tests.h>
+#include <test/util/net.h>
 #include <test/util/txmempool.h>
 #include <txmempool.h>
 #include <validation.h>
+#include <validationinterface.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <future>
+#include <set>
 #include <vector>
 
 using node::GetTransaction;
+using node::ReadBlockFromDisk;
 
 using SimpleUTXOMap = std::map<COutPoint, std::pair<int, CAmount>>;
 
+namespace evo_deterministicmns_tests {
+class TestQuorumBlockProcessor
+{
+public:
+    static bool ProcessCommitment(llmq::CQuorumBlockProcessor& qblockman, const CBlockIndex* pindex,
+                                  const llmq::CFinalCommitment& qc, BlockValidationState& state)
+        EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        return qblockman.ProcessCommitment(pindex->nHeight, pindex->GetBlockHash(), qc, state, /*fJustCheck=*/true);
+    }
+
+    static size_t GetNumCommitmentsRequired(llmq::CQuorumBlockProcessor& qblockman, const Consensus::LLMQParams& params,
+                                            int nHeight) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        return qblockman.GetNumCommitmentsRequired(params, nHeight);
+    }
+};
+} // namespace evo_deterministicmns_tests
+
+using evo_deterministicmns_tests::TestQuorumBlockProcessor;
+
 static SimpleUTXOMap BuildSimpleUtxoMap(const std::vector<CTransactionRef>& txs)
 {
     SimpleUTXOMap utxos;
@@ -999,6 +1044,95 @@ void FuncTestMempoolDualProregtx(TestChainSetup& setup)
     BOOST_CHECK(testPool.existsProviderTxConflict(CTransaction(tx_reg2)));
 }
 
+template <typename ProTx, typename Func>
+static CTransaction ModifyProTxPayload(CMutableTransaction tx, Func&& modify)
+{
+    auto proTx = *Assert(GetTxPayload<ProTx>(tx));
+    modify(proTx);
+    SetTxPayload(tx, proTx);
+    return CTransaction(tx);
+}
+
+void FuncTestMempoolProTxProperties(TestChainSetup& setup)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    const auto& mempool = *Assert(setup.m_node.mempool);
+
+    const CScript coinbase_pk = GetScriptForRawPubKey(setup.coinbaseKey.GetPubKey());
+    auto utxos = BuildSimpleUtxoMap(setup.m_coinbase_txns);
+
+    // A mined MN to update
+    CKey ownerKeyMined;
+    CBLSSecretKey operatorKeyMined;
+    auto tx_reg_mined = CreateProRegTx(chainman.ActiveChain(), mempool, utxos, 1, GenerateRandomAddress(), setup.coinbaseKey, ownerKeyMined, operatorKeyMined);
+    setup.CreateAndProcessBlock({tx_reg_mined}, coinbase_pk);
+    setup.m_node.dmnman->UpdatedBlockTip(WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip()));
+    const uint256 proTxHashMined{tx_reg_mined.GetHash()};
+
+    CKey ownerKey, ownerKeyOther;
+    CBLSSecretKey operatorKey, operatorKeyOther;
+    const auto tx_reg = CreateProRegTx(chainman.ActiveChain(), mempool, utxos, 2, GenerateRandomAddress(), setup.coinbaseKey, ownerKey, operatorKey);
+    const auto tx_reg_other = CreateProRegTx(chainman.ActiveChain(), mempool, utxos, 3, GenerateRandomAddress(), setup.coinbaseKey, ownerKeyOther, operatorKeyOther);
+    const auto proRegTx = *Assert(GetTxPayload<CProRegTx>(tx_reg));
+
+    // ProRegTxs claiming one of the properties of tx_reg each
+    const auto tx_same_service = ModifyProTxPayload<CProRegTx>(tx_reg_other, [&](CProRegTx& proTx) { proTx.netInfo = proRegTx.netInfo; });
+    const auto tx_same_owner = ModifyProTxPayload<CProRegTx>(tx_reg_other, [&](CProRegTx& proTx) { proTx.keyIDOwner = proRegTx.keyIDOwner; });
+    const auto tx_same_operator = ModifyProTxPayload<CProRegTx>(tx_reg_other, [&](CProRegTx& proTx) { proTx.pubKeyOperator = proRegTx.pubKeyOperator; });
+    const auto tx_same_collateral = ModifyProTxPayload<CProRegTx>(tx_reg_other, [&](CProRegTx& proTx) { proTx.collateralOutpoint = COutPoint(tx_reg.GetHash(), proRegTx.collateralOutpoint.n); });
+    const std::vector<CTransaction> reg_conflicts{tx_same_service, tx_same_owner, tx_same_operator, tx_same_collateral};
+
+    // Updates of the mined MN claiming the service or the operator key of tx_reg
+    const CTransaction tx_up_serv_conflict{CreateProUpServTx(chainman.ActiveChain(), mempool, utxos, proTxHashMined, operatorKeyMined, 2, CScript(), setup.coinbaseKey)};
+    const auto tx_up_serv = CreateProUpServTx(chainman.ActiveChain(), mempool, utxos, proTxHashMined, operatorKeyMined, 4, CScript(), setup.coinbaseKey);
+    const CTransaction tx_up_reg_conflict{CreateProUpRegTx(chainman.ActiveChain(), mempool, utxos, proTxHashMined, ownerKeyMined, operatorKey.GetPublicKey(), ownerKeyMined.GetPubKey().GetID(), GenerateRandomAddress(), setup.coinbaseKey)};
+    const CTransaction tx_up_reg{CreateProUpRegTx(chainman.ActiveChain(), mempool, utxos, proTxHashMined, ownerKeyMined, operatorKeyOther.GetPublicKey(), ownerKeyMined.GetPubKey().GetID(), GenerateRandomAddress(), setup.coinbaseKey)};
+
+    CTxMemPool testPool;
+    testPool.ConnectManagers(setup.m_node.dmnman.get(), setup.m_node.llmq_ctx->isman.get());
+    TestMemPoolEntryHelper entry;
+    LOCK2(cs_main, testPool.cs);
+
+    const auto check_conflicts = [&](bool expected) {
+        for (const auto& tx : reg_conflicts) {
+            BOOST_CHECK_EQUAL(testPool.existsProviderTxConflict(tx), expected);
+        }
+        BOOST_CHECK_EQUAL(testPool.existsProviderTxConflict(tx_up_serv_conflict), expected);
+        BOOST_CHECK_EQUAL(testPool.existsProviderTxConflict(tx_up_reg_conflict), expected);
+        BOOST_CHECK(!testPool.existsProviderTxConflict(CTransaction(tx_reg_other)));
+        BOOST_CHECK(!testPool.existsProviderTxConflict(tx_up_reg));
+    };
+    check_conflicts(/*expected=*/false);
+
+    // Every unique property of a ProRegTx in the mempool is claimed, no matter which kind of ProTx conflicts with it
+    testPool.addUnchecked(entry.FromTx(tx_reg));
+    check_conflicts(/*expected=*/true);
+
+    // but a MN may keep its own service
+    BOOST_CHECK(!testPool.existsProviderTxConflict(CTransaction(CreateProUpServTx(chainman.ActiveChain(), mempool, utxos, tx_reg.GetHash(), operatorKey, 2, CScript(), setup.coinbaseKey))));
+
+    // The service of a ProUpServTx is claimed as well
+    testPool.addUnchecked(entry.FromTx(tx_up_serv));
+    const auto tx_reg_on_up_serv = ModifyProTxPayload<CProRegTx>(tx_reg_other, [&](CProRegTx& proTx) { proTx.netInfo = Assert(GetTxPayload<CProUpServTx>(tx_up_serv))->netInfo; });
+    BOOST_CHECK(testPool.existsProviderTxConflict(tx_reg_on_up_serv));
+
+    // The properties are released when the transactions leave the mempool
+    testPool.removeRecursive(CTransaction(tx_reg), MemPoolRemovalReason::MANUAL);
+    testPool.removeRecursive(CTransaction(tx_up_serv), MemPoolRemovalReason::MANUAL);
+    BOOST_CHECK_EQUAL(testPool.size(), 0U);
+    check_conflicts(/*expected=*/false);
+    BOOST_CHECK(!testPool.existsProviderTxConflict(tx_reg_on_up_serv));
+
+    // A block with a ProTx claiming one of the properties evicts the conflicting mempool transaction
+    for (const auto& tx : reg_conflicts) {
+        testPool.addUnchecked(entry.FromTx(tx_reg));
+        BOOST_CHECK_EQUAL(testPool.size(), 1U);
+        testPool.removeForBlock({MakeTransactionRef(tx)}, chainman.ActiveChain().Height() + 1);
+        BOOST_CHECK_EQUAL(testPool.size(), 0U);
+        check_conflicts(/*expected=*/false);
+    }
+}
+
 void FuncVerifyDB(TestChainSetup& setup)
 {
     auto& chainman = *Assert(setup.m_node.chainman.get());
@@ -1177,6 +1311,425 @@ static void SmlCache(TestChainSetup& setup)
     BOOST_CHECK_EQUAL(mn_list_1.to_sml()->mnList.size(), 1); // Still one MN but with updated data
 }
 
+//! Records the state of the chain whenever the masternode list is rolled back
+class MNListUndoRecorder final : public CValidationInterface
+{
+public:
+    MNListUndoRecorder(ChainstateManager& chainman, CEvoDB& evodb) : m_chainman{chainman}, m_evodb{evodb} {}
+
+    void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) override
+    {
+        if (!undo) return;
+        // Sent synchronously while the blocks are being disconnected
+        LOCK(::cs_main);
+        m_tips.emplace_back(m_chainman.ActiveChain().Tip());
+        m_coins_best_blocks.emplace_back(m_chainman.ActiveChainstate().CoinsTip().GetBestBlock());
+        m_evodb_usages.emplace_back(m_evodb.GetMemoryUsage());
+    }
+
+    ChainstateManager& m_chainman;
+    CEvoDB& m_evodb;
+    std::vector<const CBlockIndex*> m_tips;
+    std::vector<uint256> m_coins_best_blocks;
+    std::vector<size_t> m_evodb_usages;
+};
+
+static void FuncDeepReorg(TestChainSetup& setup, int depth)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    auto& dmnman = *Assert(setup.m_node.dmnman);
+    auto& evodb = *Assert(setup.m_node.evodb);
+
+    const CScript coinbase_pk = GetScriptForRawPubKey(setup.coinbaseKey.GetPubKey());
+    auto utxos = BuildSimpleUtxoMap(setup.m_coinbase_txns);
+    const CBlockIndex* pindexFork = WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip());
+
+    // Mine the chain which will win the reorg, then switch away from it
+    std::vector<uint256> winning_hashes;
+    for (int i = 0; i < depth + 1; ++i) {
+        winning_hashes.emplace_back(setup.CreateAndProcessBlock({}, coinbase_pk).GetHash());
+    }
+    CBlockIndex* pindexWinning = WITH_LOCK(::cs_main, return chainman.m_blockman.LookupBlockIndex(winning_hashes[0]));
+    BlockValidationState state;
+    BOOST_REQUIRE(chainman.ActiveChainstate().InvalidateBlock(state, pindexWinning));
+    BOOST_REQUIRE(WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip()) == pindexFork);
+
+    // Register a masternode on a shorter chain
+    CKey ownerKey;
+    CBLSSecretKey operatorKey;
+    auto tx_reg = CreateProRegTx(chainman.ActiveChain(), *(setup.m_node.mempool), utxos, 1, GenerateRandomAddress(), setup.coinbaseKey, ownerKey, operatorKey);
+    setup.CreateAndProcessBlock({tx_reg}, coinbase_pk);
+    for (int i = 1; i < depth; ++i) {
+        setup.CreateAndProcessBlock({}, coinbase_pk);
+    }
+    const CBlockIndex* pindexOldTip = WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip());
+    BOOST_CHECK(dmnman.GetListForBlock(pindexOldTip).HasMN(tx_reg.GetHash()));
+
+    MNListUndoRecorder recorder{chainman, evodb};
+    RegisterValidationInterface(&recorder);
+    const size_t evodb_usage{evodb.GetMemoryUsage()};
+    WITH_LOCK(::cs_main, chainman.ActiveChainstate().ResetBlockFailureFlags(pindexWinning));
+    BOOST_REQUIRE(chainman.ActiveChainstate().ActivateBestChain(state));
+    UnregisterValidationInterface(&recorder);
+
+    // The masternode list is rolled back once per batch of up to MAX_DISCONNECT_BATCH_DEPTH blocks
+    std::vector<const CBlockIndex*> batch_tips;
+    for (int nHeight = pindexOldTip->nHeight; nHeight > pindexFork->nHeight; nHeight -= MAX_DISCONNECT_BATCH_DEPTH) {
+        batch_tips.emplace_back(pindexOldTip->GetAncestor(nHeight));
+    }
+    BOOST_CHECK(recorder.m_tips == batch_tips);
+    if (depth <= MAX_DISCONNECT_BATCH_DEPTH) {
+        // Nothing was committed before all blocks were disconnected
+        BOOST_CHECK(recorder.m_coins_best_blocks[0] == pindexOldTip->GetBlockHash());
+        BOOST_CHECK_EQUAL(recorder.m_evodb_usages[0], evodb_usage);
+    }
+
+    const CBlockIndex* tip = WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip());
+    BOOST_CHECK_EQUAL(tip->GetBlockHash(), winning_hashes.back());
+    BOOST_CHECK(evodb.VerifyBestBlock(tip->GetBlockHash()));
+    const auto mn_list = dmnman.GetListForBlock(tip);
+    BOOST_CHECK(!mn_list.HasMN(tx_reg.GetHash()));
+    BOOST_CHECK_EQUAL(mn_list.GetCounts().total(), dmnman.GetListForBlock(pindexFork).GetCounts().total());
+}
+
+static void FuncQuorumConnections(TestChainSetup& setup)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    auto& dmnman = *Assert(setup.m_node.dmnman);
+    const auto& sporkman = *Assert(setup.m_node.sporkman);
+    const auto& llmq_params = *Assert(Params().GetLLMQ(Consensus::LLMQType::LLMQ_TEST));
+
+    const CScript coinbase_pk = GetScriptForRawPubKey(setup.coinbaseKey.GetPubKey());
+    auto utxos = BuildSimpleUtxoMap(setup.m_coinbase_txns);
+    for (int port = 1; port <= llmq_params.size; ++port) {
+        CKey ownerKey;
+        CBLSSecretKey operatorKey;
+        auto tx = CreateProRegTx(chainman.ActiveChain(), *(setup.m_node.mempool), utxos, port, GenerateRandomAddress(), setup.coinbaseKey, ownerKey, operatorKey);
+        setup.CreateAndProcessBlock({tx}, coinbase_pk);
+    }
+    // Mine up to a quorum base block which sees all of them
+    const int registered_height{WITH_LOCK(::cs_main, return chainman.ActiveChain().Height())};
+    while (WITH_LOCK(::cs_main, return chainman.ActiveChain().Height()) % llmq_params.dkgInterval != 0 ||
+           WITH_LOCK(::cs_main, return chainman.ActiveChain().Height()) < registered_height + 8) {
+        setup.CreateAndProcessBlock({}, coinbase_pk);
+    }
+
+    const llmq::UtilParameters util_params{dmnman, *setup.m_node.llmq_ctx->qsnapman, chainman,
+                                           WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip())};
+    const auto members = llmq::utils::GetAllQuorumMembers(llmq_params.type, util_params);
+    BOOST_REQUIRE_EQUAL(members.size(), size_t(llmq_params.size));
+    const auto is_member = [&](const uint256& protx_hash) {
+        return std::ranges::any_of(members, [&](const auto& dmn) { return dmn->proTxHash == protx_hash; });
+    };
+
+    // A member connects to (and relays from) other members only
+    const uint256 my_protx_hash{members[0]->proTxHash};
+    const auto member_connections = llmq::CalcQuorumConnections(llmq_params, sporkman, util_params, my_protx_hash,
+                                                                /*is_masternode=*/true, /*quorums_watch=*/false);
+    BOOST_REQUIRE(member_connections);
+    BOOST_CHECK(!member_connections->relay_members.empty());
+    for (const auto& set : {member_connections->connections, member_connections->relay_members}) {
+        BOOST_CHECK(!set.contains(my_protx_hash));
+        BOOST_CHECK(std::ranges::all_of(set, is_member));
+    }
+
+    // Others only want connections to the quorum if they are watching it
+    const uint256 other_protx_hash{GetRandHash()};
+    BOOST_CHECK(!llmq::CalcQuorumConnections(llmq_params, sporkman, util_params, other_protx_hash,
+                                             /*is_masternode=*/true, /*quorums_watch=*/false));
+    BOOST_CHECK(!llmq::CalcQuorumConnections(llmq_params, sporkman, util_params, uint256{},
+                                             /*is_masternode=*/false, /*quorums_watch=*/false));
+    const auto watch_connections = llmq::CalcQuorumConnections(llmq_params, sporkman, util_params, uint256{},
+                                                               /*is_masternode=*/false, /*quorums_watch=*/true);
+    BOOST_REQUIRE(watch_connections);
+    BOOST_CHECK_EQUAL(watch_connections->connections.size(), 1U);
+    BOOST_CHECK(std::ranges::all_of(watch_connections->connections, is_member));
+    BOOST_CHECK(watch_connections->relay_members == watch_connections->connections);
+}
+
+static void FuncMnAuth(TestChainSetup& setup)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    auto& connman = static_cast<ConnmanTestMsg&>(*setup.m_node.connman);
+    auto& peerman = *Assert(setup.m_node.peerman);
+    auto& bls_worker = *Assert(setup.m_node.llmq_ctx->bls_worker);
+
+    const CScript coinbase_pk = GetScriptForRawPubKey(setup.coinbaseKey.GetPubKey());
+    auto utxos = BuildSimpleUtxoMap(setup.m_coinbase_txns);
+    CKey ownerKey;
+    CBLSSecretKey operatorKey;
+    auto tx_reg = CreateProRegTx(chainman.ActiveChain(), *(setup.m_node.mempool), utxos, 1, GenerateRandomAddress(), setup.coinbaseKey, ownerKey, operatorKey);
+    setup.CreateAndProcessBlock({tx_reg}, coinbase_pk);
+    setup.m_node.dmnman->UpdatedBlockTip(WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip()));
+    BOOST_REQUIRE(setup.m_node.dmnman->GetListAtChainTip().HasMN(tx_reg.GetHash()));
+    // MNAUTH is only processed with an up to date masternode list
+    setup.m_node.mn_sync->SwitchToNextAsset();
+    BOOST_REQUIRE(setup.m_node.mn_sync->IsBlockchainSynced());
+    BOOST_REQUIRE(setup.m_node.mn_metaman->LoadCache(/*load_cache=*/false));
+
+    LOCK(NetEventsInterface::g_msgproc_mutex);
+    auto* node = new CNode(/*id=*/0, /*sock=*/nullptr, CAddress{CService{}, NODE_NONE}, /*nKeyedNetGroupIn=*/0,
+                           /*nLocalHostNonceIn=*/0, CAddress{}, /*addrNameIn=*/"", ConnectionType::INBOUND,
+                           /*inbound_onion=*/false);
+    connman.AddTestNode(*node);
+    connman.Handshake(*node, /*successfully_connected=*/true, ServiceFlags(NODE_NETWORK | NODE_BLOOM),
+                      ServiceFlags(NODE_NETWORK | NODE_BLOOM), PROTOCOL_VERSION, /*relay_txs=*/true);
+    // Nothing reads from the node, make sure it isn't throttled by what we sent during the handshake
+    connman.FlushSendBuffer(*node);
+    node->fPauseSend = false;
+
+    CMNAuth mnauth;
+    mnauth.proRegTxHash = tx_reg.GetHash();
+    const uint256 sign_hash{::SerializeHash(std::make_tuple(operatorKey.GetPublicKey(), node->GetSentMNAuthChallenge(),
+                                                            /*fInbound=*/false, node->nVersion.load()))};
+    mnauth.sig = operatorKey.Sign(sign_hash, /*specificLegacyScheme=*/false);
+
+    // Keep the BLS worker busy so that the MNAUTH signature is queued behind this verification
+    std::promise<void> release;
+    const std::shared_future<void> released{release.get_future()};
+    bls_worker.AsyncVerifySig(operatorKey.Sign(uint256::ONE, false), operatorKey.GetPublicKey(), uint256::ONE,
+                              [](bool) {}, [released] { released.wait(); return true; });
+
+    // A duplicate MNAUTH is only processed once the first one completed and gets the peer punished
+    const CNetMsgMaker msg_maker{node->GetCommonVersion()};
+    connman.ReceiveMsgFrom(*node, msg_maker.Make(NetMsgType::MNAUTH, mnauth));
+    connman.ReceiveMsgFrom(*node, msg_maker.Make(NetMsgType::MNAUTH, mnauth));
+    connman.ProcessMessagesOnce(*node);
+    CNodeStateStats stats;
+    for (int i = 0; i < 3; ++i) {
+        BOOST_CHECK(!connman.ProcessMessagesOnce(*node));
+    }
+    BOOST_CHECK(node->GetVerifiedProRegTxHash().IsNull());
+    BOOST_REQUIRE(peerman.GetNodeStateStats(node->GetId(), stats));
+    BOOST_CHECK_EQUAL(stats.m_misbehavior_score, 0);
+
+    // Once verified, the handshake completes before the next message is looked at
+    release.set_value();
+    for (int i = 0; i < 1000 && node->GetVerifiedProRegTxHash().IsNull(); ++i) {
+        connman.ProcessMessagesOnce(*node);
+        UninterruptibleSleep(std::chrono::milliseconds{10});
+    }
+    BOOST_CHECK(node->GetVerifiedProRegTxHash() == tx_reg.GetHash());
+    connman.ProcessMessagesOnce(*node);
+    BOOST_REQUIRE(peerman.GetNodeStateStats(node->GetId(), stats));
+    BOOST_CHECK_EQUAL(stats.m_misbehavior_score, 100);
+
+    peerman.FinalizeNode(*node);
+    connman.ClearTestNodes();
+}
+
+static void FuncEvoSnapshot(TestChainSetup& setup)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    auto& special_tx = *Assert(setup.m_node.chain_helper)->special_tx;
+
+    LOCK(::cs_main);
+    const CBlockIndex* tip = chainman.ActiveChain().Tip();
+    CBlock block;
+    BOOST_REQUIRE(ReadBlockFromDisk(block, tip, chainman.GetConsensus()));
+
+    CEvoSnapshot snapshot;
+    BOOST_REQUIRE(special_tx.CreateEvoSnapshot(block, tip, snapshot));
+    std::string error;
+    BOOST_CHECK(snapshot.Verify(*tip, error));
+
+    // Survives a round trip through the snapshot file format
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << snapshot;
+    CEvoSnapshot snapshot2;
+    ss >> snapshot2;
+    BOOST_CHECK(snapshot2.Verify(*tip, error));
+    BOOST_CHECK(special_tx.LoadEvoSnapshot(snapshot2, tip, error));
+
+    // The coinbase must be committed to by the header of the base block
+    BOOST_CHECK(!snapshot.Verify(*tip->pprev, error));
+    snapshot2 = snapshot;
+    snapshot2.m_base.m_coinbase_branch.emplace_back(uint256::ONE);
+    BOOST_CHECK(!snapshot2.Verify(*tip, error));
+
+    // The state must match the CbTx of the base block
+    snapshot2 = snapshot;
+    snapshot2.m_base.m_mn_list = setup.m_node.dmnman->GetListForBlock(tip->pprev);
+    BOOST_CHECK(!snapshot2.Verify(*tip, error));
+    snapshot2 = snapshot;
+    snapshot2.m_credit_pool.locked += 1;
+    BOOST_CHECK(!snapshot2.Verify(*tip, error));
+    snapshot2 = snapshot;
+    snapshot2.m_commitments.emplace_back(llmq::CFinalCommitment{}, tip->GetBlockHash());
+    BOOST_CHECK(!snapshot2.Verify(*tip, error));
+}
+
+static void FuncSnapshotCommitments(TestChainSetup& setup)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    auto& qblockman = *Assert(setup.m_node.llmq_ctx)->quorum_block_processor;
+    const auto& params = Params().GetLLMQ(Consensus::LLMQType::LLMQ_TEST).value();
+
+    LOCK(::cs_main);
+    const CChain& chain = chainman.ActiveChain();
+    const int cycle_start = (chain.Height() - params.dkgMiningWindowEnd) / params.dkgInterval * params.dkgInterval;
+    const CBlockIndex* pindexBase = chain[cycle_start];
+    const CBlockIndex* pindexMined = chain[cycle_start + params.dkgMiningWindowStart + 1];
+    const CBlockIndex* pindexNext = chain[pindexMined->nHeight + 1];
+
+    // The quorum must be based on an ancestor of the block the commitment was mined in
+    const auto qc = llmq::testutils::CreateValidCommitment(params, pindexBase->GetBlockHash());
+    BOOST_CHECK(!qblockman.CheckSnapshotCommitment(qc, pindexBase->pprev));
+    BOOST_CHECK(!qblockman.CheckSnapshotCommitment(llmq::CFinalCommitment{}, pindexMined));
+    BOOST_REQUIRE(qblockman.CheckSnapshotCommitment(qc, pindexMined));
+    BOOST_CHECK_EQUAL(TestQuorumBlockProcessor::GetNumCommitmentsRequired(qblockman, params, pindexMined->nHeight), 1U);
+
+    // Store the commitment like a snapshot does before background validation reaches the block it was mined in
+    qblockman.AddSnapshotCommitment(qc, pindexMined);
+    BOOST_CHECK(qblockman.HasMinedCommitment(params.type, qc.quorumHash));
+
+    // Background validation still requires the commitment in the block it was mined in, not after it
+    BOOST_CHECK_EQUAL(TestQuorumBlockProcessor::GetNumCommitmentsRequired(qblockman, params, pindexMined->nHeight - 1), 1U);
+    BOOST_CHECK_EQUAL(TestQuorumBlockProcessor::GetNumCommitmentsRequired(qblockman, params, pindexMined->nHeight), 1U);
+    BOOST_CHECK_EQUAL(TestQuorumBlockProcessor::GetNumCommitmentsRequired(qblockman, params, pindexNext->nHeight), 0U);
+
+    // Null commitments before it and the same commitment in the block it was mined in are accepted
+    llmq::CFinalCommitment qcNull;
+    qcNull.llmqType = params.type;
+    qcNull.quorumHash = qc.quorumHash;
+    qcNull.validMembers.resize(params.size);
+    qcNull.signers.resize(params.size);
+    BlockValidationState state;
+    BOOST_CHECK(TestQuorumBlockProcessor::ProcessCommitment(qblockman, pindexMined->pprev, qcNull, state));
+    state = BlockValidationState{};
+    TestQuorumBlockProcessor::ProcessCommitment(qblockman, pindexMined, qc, state);
+    BOOST_CHECK(state.GetRejectReason() != "bad-qc-dup");
+
+    // Anything else still is
+    state = BlockValidationState{};
+    BOOST_CHECK(!TestQuorumBlockProcessor::ProcessCommitment(qblockman, pindexMined->pprev, qc, state));
+    BOOST_CHECK_EQUAL(state.GetRejectReason(), "bad-qc-dup");
+    state = BlockValidationState{};
+    auto qc2 = qc;
+    qc2.quorumVvecHash = uint256::ONE;
+    BOOST_CHECK(!TestQuorumBlockProcessor::ProcessCommitment(qblockman, pindexMined, qc2, state));
+    BOOST_CHECK_EQUAL(state.GetRejectReason(), "bad-qc-dup");
+    state = BlockValidationState{};
+    BOOST_CHECK(!TestQuorumBlockProcessor::ProcessCommitment(qblockman, pindexNext, qc, state));
+    BOOST_CHECK_EQUAL(state.GetRejectReason(), "bad-qc-dup");
+}
+
+static void FuncEvoSnapshotLoad(TestChainSetup& setup)
+{
+    auto& chainman = *Assert(setup.m_node.chainman.get());
+    auto& dmnman = *Assert(setup.m_node.dmnman);
+    auto& llmq_ctx = *Assert(setup.m_node.llmq_ctx);
+    auto& special_tx = *Assert(setup.m_node.chain_helper)->special_tx;
+
+    // Register masternodes over a few DKG cycles, so the lists below the base block differ from the one at it
+    const CScript coinbase_pk = GetScriptForRawPubKey(setup.coinbaseKey.GetPubKey());
+    auto utxos = BuildSimpleUtxoMap(setup.m_coinbase_txns);
+    for (int i = 0; i < 80; ++i) {
+        std::vector<CMutableTransaction> txns;
+        if (i % 6 == 0) {
+            CKey ownerKey;
+            CBLSSecretKey operatorKey;
+            txns.emplace_back(CreateProRegTx(chainman.ActiveChain(), *(setup.m_node.mempool), utxos, 1 + i, GenerateRandomAddress(), setup.coinbaseKey, ownerKey, operatorKey));
+        }
+        setup.CreateAndProcessBlock(txns, coinbase_pk);
+    }
+
+    // An active quorum of a plain and of a rotated type, members of the rotated one are also derived from the previous cycle
+    std::vector<std::pair<Consensus::LLMQType, const CBlockIndex*>> quorums;
+    {
+        LOCK(::cs_main);
+        const CBlockIndex* tip = chainman.ActiveChain().Tip();
+        auto dbTx = setup.m_node.evodb->BeginTransaction();
+        for (const auto llmq_type : {Consensus::LLMQType::LLMQ_TEST, Consensus::LLMQType::LLMQ_TEST_DIP0024}) {
+            const auto& params = Params().GetLLMQ(llmq_type).value();
+            const int cycle_start = (tip->nHeight - params.dkgMiningWindowEnd) / params.dkgInterval * params.dkgInterval;
+            const CBlockIndex* pindexBase = tip->GetAncestor(cycle_start);
+            auto qc = llmq::testutils::CreateValidCommitment(params, pindexBase->GetBlockHash());
+            qc.nVersion = llmq::CFinalCommitment::GetVersion(llmq::IsQuorumRotationEnabled(params, pindexBase), /*is_basic_scheme_active=*/true);
+            llmq_ctx.quorum_block_processor->AddSnapshotCommitment(qc, tip->GetAncestor(cycle_start + params.dkgMiningWindowStart + 1));
+            quorums.emplace_back(llmq_type, pindexBase);
+        }
+        dbTx->Commit();
+    }
+    // The next CbTx commits to them, as if they had been mined with a real DKG
+    setup.CreateAndProcessBlock({}, coinbase_pk);
+
+    LOCK(::cs_main);
+    const CBlockIndex* tip = chainman.ActiveChain().Tip();
+    const auto& rotation_params = Params().GetLLMQ(Consensus::LLMQType::LLMQ_TEST_DIP0024).value();
+    const CBlockIndex* pindexPrevCycle = quorums[1].second->GetAncestor(quorums[1].second->nHeight - rotation_params.dkgInterval);
+    const llmq::UtilParameters util_params{dmnman, *llmq_ctx.qsnapman, chainman, tip};
+    llmq::utils::GetAllQuorumMembers(rotation_params.type, util_params.replace_index(pindexPrevCycle), /*reset_cache=*/true);
+    std::vector<std::vector<CDeterministicMNCPtr>> members;
+    for (const auto& [llmq_type, pindexBase] : quorums) {
+        members.emplace_back(llmq::utils::GetAllQuorumMembers(llmq_type, util_params.replace_index(pindexBase), /*reset_cache=*/true));
+        BOOST_REQUIRE(!members.back().empty());
+    }
+
+    CBlock block;
+    BOOST_REQUIRE(ReadBlockFromDisk(block, tip, chainman.GetConsensus()));
+    CEvoSnapshot snapshot;
+    BOOST_REQUIRE(special_tx.CreateEvoSnapshot(block, tip, snapshot));
+    BOOST_CHECK_EQUAL(snapshot.m_commitments.size(), 2U);
+    BOOST_CHECK_EQUAL(snapshot.m_quorum_snapshots.size(), 2U);
+    std::set<int> list_heights;
+    for (const auto& mn_list : snapshot.m_quorum_mn_lists) {
+        list_heights.emplace(mn_list.m_mn_list.GetHeight());
+    }
+    for (const auto& [_, pindexBase] : quorums) {
+        BOOST_CHECK(list_heights.count(pindexBase->nHeight));
+        BOOST_CHECK(list_heights.count(pindexBase->nHeight - llmq::WORK_DIFF_DEPTH));
+    }
+    BOOST_CHECK(list_heights.count(pindexPrevCycle->nHeight - llmq::WORK_DIFF_DEPTH));
+
+    // A list below the base block must match the CbTx of its own block
+    std::string error;
+    BOOST_CHECK(snapshot.Verify(*tip, error));
+    auto snapshot2 = snapshot;
+    snapshot2.m_quorum_mn_lists[0].m_mn_list = snapshot.m_base.m_mn_list;
+    snapshot2.m_quorum_mn_lists[0].m_mn_list.SetBlockHash(snapshot.m_quorum_mn_lists[0].m_mn_list.GetBlockHash());
+    snapshot2.m_quorum_mn_lists[0].m_mn_list.SetHeight(snapshot.m_quorum_mn_lists[0].m_mn_list.GetHeight());
+    BOOST_CHECK(!snapshot2.Verify(*tip, error));
+    snapshot2 = snapshot;
+    std::swap(snapshot2.m_quorum_mn_lists[0], snapshot2.m_quorum_mn_lists[1]);
+    BOOST_CHECK(!snapshot2.Verify(*tip, error));
+
+    // Load it into an empty evodb, like a node starting from the snapshot file
+    CEvoDB evodb{util::DbWrapperParams{.path = setup.m_node.args->GetDataDirNet(), .memory = true, .wipe = true}};
+    CDeterministicMNManager fresh_dmnman{evodb, *setup.m_node.mn_metaman};
+    llmq::CQuorumSnapshotManager fresh_qsnapman{evodb};
+    llmq::CQuorumBlockProcessor fresh_qblockman{chainman.ActiveChainstate(), fresh_dmnman, evodb, fresh_qsnapman, /*bls_threads=*/0};
+    CCreditPoolManager fresh_cpoolman{evodb, chainman};
+    CSpecialTxProcessor fresh_special_tx{fresh_cpoolman, fresh_dmnman, *setup.m_node.chain_helper->ehf_manager, fresh_qblockman, fresh_qsnapman, chainman,
+                                         chainman.GetConsensus(), *setup.m_node.chainlocks, *llmq_ctx.qman};
+    auto dbTx = evodb.BeginTransaction();
+    BOOST_REQUIRE(fresh_special_tx.LoadEvoSnapshot(snapshot, tip, error));
+    dbTx->Commit();
+
+    BOOST_CHECK(fresh_dmnman.GetListForBlock(tip) == dmnman.GetListForBlock(tip));
+    for (const auto& mn_list : snapshot.m_quorum_mn_lists) {
+        const CBlockIndex* pindex = tip->GetAncestor(mn_list.m_mn_list.GetHeight());
+        BOOST_CHECK(fresh_dmnman.GetListForBlock(pindex) == dmnman.GetListForBlock(pindex));
+    }
+    // The same quorum members are computed from the loaded state
+    const llmq::UtilParameters fresh_util_params{fresh_dmnman, fresh_qsnapman, chainman, tip};
+    for (size_t i = 0; i < quorums.size(); ++i) {
+        const auto& [llmq_type, pindexBase] = quorums[i];
+        BOOST_CHECK(fresh_qblockman.HasMinedCommitment(llmq_type, pindexBase->GetBlockHash()));
+        BOOST_CHECK(llmq::utils::GetAllQuorumMembers(llmq_type, fresh_util_params.replace_index(pindexBase), /*reset_cache=*/true) == members[i]);
+    }
+
+    // Other lists below the base block are unknown until background validation processes their blocks
+    const CBlockIndex* pindexUnknown = tip->pprev;
+    while (list_heights.count(pindexUnknown->nHeight)) {
+        pindexUnknown = pindexUnknown->pprev;
+    }
+    BOOST_CHECK_THROW(fresh_dmnman.GetListForBlock(pindexUnknown), std::runtime_error);
+    // and asking for one does not affect the known ones
+    BOOST_CHECK(fresh_dmnman.GetListForBlock(quorums[0].second) == dmnman.GetListForBlock(quorums[0].second));
+    BOOST_CHECK(fresh_dmnman.GetListForBlock(tip) == dmnman.GetListForBlock(tip));
+}
+
 BOOST_AUTO_TEST_SUITE(evo_dip3_activation_tests)
 
 struct TestChainDIP3BeforeActivationSetup : public TestChainSetup {
@@ -1304,6 +1857,12 @@ BOOST_AUTO_TEST_CASE(test_mempool_dual_proregtx_basic)
     FuncTestMempoolDualProregtx(setup);
 }
 
+BOOST_AUTO_TEST_CASE(test_mempool_protx_properties_basic)
+{
+    TestChainV19Setup setup;
+    FuncTestMempoolProTxProperties(setup);
+}
+
 //This one can be started only with legacy scheme, since inside undo block will switch it back to legacy resulting into an inconsistency
 BOOST_AUTO_TEST_CASE(verify_db_legacy)
 {
@@ -1323,6 +1882,48 @@ BOOST_AUTO_TEST_CASE(test_sml_cache_basic)
     SmlCache(setup);
 }
 
+BOOST_AUTO_TEST_CASE(deep_reorg_basic)
+{
+    TestChainV19Setup setup;
+    FuncDeepReorg(setup, /*depth=*/2);
+}
+
+BOOST_AUTO_TEST_CASE(deep_reorg_batches_basic)
+{
+    TestChainV19Setup setup;
+    FuncDeepReorg(setup, /*depth=*/MAX_DISCONNECT_BATCH_DEPTH + 1);
+}
+
+BOOST_AUTO_TEST_CASE(quorum_connections_basic)
+{
+    TestChainV19Setup setup;
+    FuncQuorumConnections(setup);
+}
+
+BOOST_AUTO_TEST_CASE(mnauth_basic)
+{
+    TestChainV19Setup setup;
+    FuncMnAuth(setup);
+}
+
+BOOST_AUTO_TEST_CASE(evo_snapshot_basic)
+{
+    TestChainV19Setup setup;
+    FuncEvoSnapshot(setup);
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_commitments_basic)
+{
+    TestChainV19Setup setup;
+    FuncSnapshotCommitments(setup);
+}
+
+BOOST_AUTO_TEST_CASE(evo_snapshot_load_basic)
+{
+    TestChainV19Setup setup;
+    FuncEvoSnapshotLoad(setup);
+}
+
 BOOST_AUTO_TEST_CASE(field_bit_migration_validation)
 {
     // Test individual field mappings for ALL 19 fields
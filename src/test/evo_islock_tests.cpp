@@ -106,6 +106,41 @@ BOOST_AUTO_TEST_CASE(deserialize_instantlock_from_realdata2)
     BOOST_CHECK_EQUAL(islock.sig.Get().ToString(), expectedSignatureStr);
 }
 
+BOOST_AUTO_TEST_CASE(compact_islock_reconstruct)
+{
+    CMutableTransaction mtx;
+    mtx.vin.resize(3);
+    mtx.vin[0].prevout = COutPoint(uint256::ONE, 0);
+    mtx.vin[1].prevout = COutPoint(uint256::TWO, 7);
+    mtx.vin[2].prevout = COutPoint(uint256::ONE, 1);
+    mtx.vout.resize(1);
+    const CTransaction tx{mtx};
+
+    instantsend::InstantSendLock islock;
+    for (const auto& in : tx.vin) {
+        islock.inputs.emplace_back(in.prevout);
+    }
+    islock.txid = tx.GetHash();
+    islock.cycleHash = uint256S("0x000000000000000bbd0b1bb95540351e7ee99c5b08efde076b3d712a57ea74d6");
+
+    // The compact form only drops the inputs
+    const instantsend::CompactInstantSendLock cmpct{islock};
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << cmpct;
+    BOOST_CHECK_EQUAL(ss.size(), ::GetSerializeSize(islock, PROTOCOL_VERSION) - 1 - 3 * 36);
+
+    instantsend::CompactInstantSendLock received;
+    ss >> received;
+    const auto rebuilt = received.Reconstruct(tx);
+    BOOST_REQUIRE(rebuilt != nullptr);
+    BOOST_CHECK(::SerializeHash(*rebuilt) == ::SerializeHash(islock));
+    BOOST_CHECK(rebuilt->GetRequestId() == islock.GetRequestId());
+
+    // Any other transaction can't be used to rebuild the lock
+    mtx.vin.pop_back();
+    BOOST_CHECK(received.Reconstruct(CTransaction{mtx}) == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(geninputlockrequestid_basic)
 {
     // Test that GenInputLockRequestId generates consistent hashes for the same outpoint
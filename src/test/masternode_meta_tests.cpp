@@ -0,0 +1,105 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <clientversion.h>
+#include <masternode/meta.h>
+#include <streams.h>
+#include <uint256.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(masternode_meta_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(metainfo_fixed_record_size)
+{
+    CMasternodeMetaInfo info{uint256::ONE};
+    info.AddGovernanceVote(uint256S("aa"));
+    info.AddGovernanceVote(uint256S("bb"));
+    // Governance votes must not affect the size of a record
+    BOOST_CHECK_EQUAL(::GetSerializeSize(info, PROTOCOL_VERSION), CMasternodeMetaInfo::RECORD_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(metastore_roundtrip)
+{
+    const uint256 mn_a{uint256S("0a")};
+    const uint256 mn_b{uint256S("0b")};
+    const uint256 mn_c{uint256S("0c")};
+    const uint256 obj_1{uint256S("f1")};
+    const uint256 obj_2{uint256S("f2")};
+
+    CMasternodeMetaMan metaman;
+    // Insert out of order, records must come out sorted regardless
+    metaman.AddGovernanceVote(mn_c, obj_1);
+    metaman.AddGovernanceVote(mn_a, obj_1);
+    metaman.AddGovernanceVote(mn_a, obj_1);
+    metaman.AddGovernanceVote(mn_a, obj_2);
+    metaman.SetLastOutboundAttempt(mn_b, 100);
+    metaman.SetLastOutboundAttempt(mn_b, 200);
+    metaman.AllowMixing(mn_c);
+    metaman.AddUsedMasternode(mn_b);
+
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << static_cast<const MasternodeMetaStore&>(metaman);
+
+    CMasternodeMetaMan loaded;
+    ss >> static_cast<MasternodeMetaStore&>(loaded);
+    BOOST_CHECK(ss.empty());
+    BOOST_CHECK_EQUAL(loaded.ToString(), metaman.ToString());
+
+    const auto votes_a{loaded.GetInfo(mn_a).GetGovernanceVotes()};
+    BOOST_CHECK_EQUAL(votes_a.size(), 2U);
+    BOOST_CHECK_EQUAL(votes_a.at(obj_1), 2);
+    BOOST_CHECK_EQUAL(votes_a.at(obj_2), 1);
+
+    const auto info_b{loaded.GetInfo(mn_b)};
+    BOOST_CHECK(info_b.GetGovernanceVotes().empty());
+    BOOST_CHECK_EQUAL(info_b.outboundAttemptCount.load(), 2);
+    BOOST_CHECK_EQUAL(info_b.lastOutboundAttempt.load(), 200);
+    BOOST_CHECK_EQUAL(loaded.GetLastOutboundAttempt(mn_b), 200);
+
+    const auto info_c{loaded.GetInfo(mn_c)};
+    BOOST_CHECK_EQUAL(info_c.GetGovernanceVotes().size(), 1U);
+    BOOST_CHECK_EQUAL(info_c.m_last_dsq.load(), 1);
+
+    BOOST_CHECK(loaded.IsUsedMasternode(mn_b));
+    BOOST_CHECK(!loaded.IsUsedMasternode(mn_a));
+}
+
+BOOST_AUTO_TEST_CASE(metastore_lookup_does_not_create)
+{
+    const uint256 mn{uint256S("0d")};
+    CMasternodeMetaMan metaman;
+    BOOST_CHECK(!metaman.OutboundFailedTooManyTimes(mn));
+    BOOST_CHECK(metaman.IsValidForMixingTxes(mn));
+    BOOST_CHECK(!metaman.ResetPlatformBan(mn, 1));
+    BOOST_CHECK_EQUAL(metaman.GetLastOutboundSuccess(mn), 0);
+    BOOST_CHECK(metaman.ToString().find("object count: 0,") != std::string::npos);
+
+    for (int i = 0; i < 6; ++i) {
+        metaman.SetLastOutboundAttempt(mn, i);
+    }
+    BOOST_CHECK(metaman.OutboundFailedTooManyTimes(mn));
+    metaman.SetLastOutboundSuccess(mn, 10);
+    BOOST_CHECK(!metaman.OutboundFailedTooManyTimes(mn));
+    BOOST_CHECK(metaman.ToString().find("object count: 1,") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(metastore_reject_bad_vote_reference)
+{
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    CMasternodeMetaMan metaman;
+    ss << static_cast<const MasternodeMetaStore&>(metaman);
+    std::string version;
+    ss >> version;
+
+    CDataStream bad(SER_DISK, CLIENT_VERSION);
+    // no records, a single vote pointing at record 0
+    bad << version << uint32_t{0} << uint32_t{1} << uint32_t{0} << uint256::ONE << int32_t{1};
+    CMasternodeMetaMan loaded;
+    BOOST_CHECK_THROW(bad >> static_cast<MasternodeMetaStore&>(loaded), std::ios_base::failure);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
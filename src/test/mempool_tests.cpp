@@ -2,7 +2,12 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <coins.h>
+#include <index/addressindex.h>
+#include <index/spentindex.h>
 #include <policy/policy.h>
+#include <script/standard.h>
+#include <test/util/random.h>
 #include <test/util/txmempool.h>
 #include <txmempool.h>
 #include <util/system.h>
@@ -795,4 +800,116 @@ BOOST_AUTO_TEST_CASE(MempoolAncestryTestsDiamond)
     BOOST_CHECK_EQUAL(descendants, 4ULL);
 }
 
+BOOST_AUTO_TEST_CASE(MempoolAddressSpentIndexTest)
+{
+    g_addressindex = std::make_unique<AddressIndex>(1 << 20, /*f_memory=*/true);
+    g_spentindex = std::make_unique<SpentIndex>(1 << 20, /*f_memory=*/true);
+    CTxMemPool& pool = *Assert(m_node.mempool);
+    LOCK2(cs_main, pool.cs);
+    TestMemPoolEntryHelper entry;
+
+    const uint160 hot_address{std::vector<unsigned char>(20, 0x01)}, other_address{std::vector<unsigned char>(20, 0x02)};
+    const CScript hot_script{GetScriptForDestination(PKHash(hot_address))};
+    const CScript other_script{GetScriptForDestination(PKHash(other_address))};
+    CCoinsView dummy;
+    CCoinsViewCache view(&dummy);
+
+    const auto make_tx = [&](const COutPoint& prevout, const CScript& prev_script, std::vector<CTxOut> vout) {
+        view.AddCoin(prevout, Coin(CTxOut(10 * COIN, prev_script), /*nHeightIn=*/1, /*fCoinBaseIn=*/false), /*possible_overwrite=*/false);
+        CMutableTransaction tx;
+        tx.vin.emplace_back(prevout);
+        tx.vout = std::move(vout);
+        return MakeTransactionRef(tx);
+    };
+    const auto add_tx = [&](const CTransactionRef& tx) {
+        const CTxMemPoolEntry e{entry.FromTx(tx)};
+        pool.addUnchecked(e);
+        pool.addAddressIndex(e, view);
+        pool.addSpentIndex(e, view);
+    };
+    const auto get_deltas = [&](const uint160& address) {
+        std::vector<CMempoolAddressDeltaEntry> deltas;
+        pool.getAddressIndex({{AddressType::P2PK_OR_P2PKH, address}}, deltas);
+        return deltas;
+    };
+    const auto get_balance = [&](const uint160& address) {
+        CAmount balance{0};
+        for (const auto& [_, delta] : get_deltas(address)) {
+            balance += delta.m_amount;
+        }
+        return balance;
+    };
+    const auto get_spender = [&](const COutPoint& prevout) {
+        CSpentIndexValue value;
+        return pool.getSpentIndex(CSpentIndexKey(prevout.hash, prevout.n), value) ? value.m_tx_hash : uint256{};
+    };
+
+    // tx1 spends a coin of the hot address, pays both addresses; tx2 spends a coin of the other address
+    const COutPoint prevout1{InsecureRand256(), 0}, prevout2{InsecureRand256(), 1};
+    const auto tx1{make_tx(prevout1, hot_script, {CTxOut(4 * COIN, other_script), CTxOut(5 * COIN, hot_script)})};
+    const auto tx2{make_tx(prevout2, other_script, {CTxOut(9 * COIN, hot_script)})};
+    const size_t usage_before{pool.DynamicMemoryUsage()};
+    add_tx(tx1);
+    // The addresses linked from the entry are accounted for
+    BOOST_CHECK(pool.DynamicMemoryUsage() > usage_before + entry.FromTx(tx1).DynamicMemoryUsage());
+    add_tx(tx2);
+    BOOST_CHECK_EQUAL(get_deltas(hot_address).size(), 3U);
+    BOOST_CHECK_EQUAL(get_balance(hot_address), 4 * COIN);
+    BOOST_CHECK_EQUAL(get_deltas(other_address).size(), 2U);
+    BOOST_CHECK_EQUAL(get_balance(other_address), -6 * COIN);
+    BOOST_CHECK(get_spender(prevout1) == tx1->GetHash());
+    BOOST_CHECK(get_spender(prevout2) == tx2->GetHash());
+    // check() recomputes the inner usage, including the address links, and asserts it matches the cached one
+    pool.check(view, /*spendheight=*/1);
+
+    // Removing a transaction only drops its own deltas
+    pool.removeRecursive(*tx1, MemPoolRemovalReason::MANUAL);
+    BOOST_CHECK_EQUAL(get_deltas(hot_address).size(), 1U);
+    BOOST_CHECK_EQUAL(get_balance(hot_address), 9 * COIN);
+    BOOST_CHECK_EQUAL(get_balance(other_address), -10 * COIN);
+    BOOST_CHECK(get_spender(prevout1).IsNull());
+    BOOST_CHECK(get_spender(prevout2) == tx2->GetHash());
+    pool.check(view, /*spendheight=*/1);
+
+    // Many transactions of the hot address, one from the middle is mined
+    std::vector<CTransactionRef> hot_txs;
+    for (int i = 0; i < 100; ++i) {
+        hot_txs.emplace_back(make_tx(COutPoint{InsecureRand256(), 0}, other_script, {CTxOut(1 * COIN, hot_script)}));
+        add_tx(hot_txs.back());
+    }
+    pool.removeForBlock({hot_txs[50]}, /*nBlockHeight=*/1);
+    const auto deltas{get_deltas(hot_address)};
+    BOOST_CHECK_EQUAL(deltas.size(), 100U);
+    BOOST_CHECK(std::none_of(deltas.begin(), deltas.end(), [&](const auto& delta) { return delta.first.m_tx_hash == hot_txs[50]->GetHash(); }));
+    BOOST_CHECK(get_spender(hot_txs[50]->vin[0].prevout).IsNull());
+    BOOST_CHECK(get_spender(hot_txs[49]->vin[0].prevout) == hot_txs[49]->GetHash());
+    pool.check(view, /*spendheight=*/1);
+
+    // Reorg: the block with tx2 is connected, disconnected again and a conflicting block is connected instead
+    pool.removeForBlock({tx2}, /*nBlockHeight=*/2);
+    BOOST_CHECK_EQUAL(get_balance(hot_address), 99 * COIN);
+    BOOST_CHECK(get_spender(prevout2).IsNull());
+    add_tx(tx2);
+    BOOST_CHECK_EQUAL(get_balance(hot_address), 108 * COIN);
+    BOOST_CHECK(get_spender(prevout2) == tx2->GetHash());
+    CMutableTransaction tx2_conflict;
+    tx2_conflict.vin.emplace_back(prevout2);
+    tx2_conflict.vout.emplace_back(10 * COIN, CScript() << OP_TRUE);
+    pool.removeForBlock({MakeTransactionRef(tx2_conflict)}, /*nBlockHeight=*/2);
+    BOOST_CHECK_EQUAL(get_balance(hot_address), 99 * COIN);
+    BOOST_CHECK(get_spender(prevout2).IsNull());
+    pool.check(view, /*spendheight=*/1);
+
+    // Once everything is gone, so are the indexes
+    pool.removeForBlock(hot_txs, /*nBlockHeight=*/3);
+    BOOST_CHECK_EQUAL(pool.size(), 0U);
+    BOOST_CHECK(get_deltas(hot_address).empty());
+    BOOST_CHECK(get_deltas(other_address).empty());
+    BOOST_CHECK(get_spender(hot_txs[0]->vin[0].prevout).IsNull());
+    pool.check(view, /*spendheight=*/1);
+
+    g_addressindex.reset();
+    g_spentindex.reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
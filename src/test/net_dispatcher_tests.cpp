@@ -0,0 +1,133 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <net_dispatcher.h>
+
+#include <net.h>
+#include <net_processing.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+class RecordingHandler final : public NetHandler
+{
+public:
+    explicit RecordingHandler(PeerManagerInternal* peer_manager) : NetHandler(peer_manager) {}
+
+    void ProcessMessage(CNode& pfrom, const std::string& msg_type, CDataStream& vRecv) override
+    {
+        std::string payload;
+        vRecv >> payload;
+        LOCK(m_mutex);
+        m_processed.emplace_back(pfrom.GetId(), payload);
+        m_cond.notify_all();
+    }
+
+    std::vector<std::pair<NodeId, std::string>> WaitFor(size_t count) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cond.wait_for(lock, 10s, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_processed.size() >= count; });
+        return m_processed;
+    }
+
+    Mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<std::pair<NodeId, std::string>> m_processed GUARDED_BY(m_mutex);
+};
+
+std::unique_ptr<CNode> MakeNode(NodeId id, size_t recv_flood_size = DEFAULT_MAXRECEIVEBUFFER * 1000)
+{
+    return std::make_unique<CNode>(id, /*sock=*/nullptr, CAddress{}, /*nKeyedNetGroupIn=*/0, /*nLocalHostNonceIn=*/0,
+                                   CAddress{}, /*addrNameIn=*/"", ConnectionType::INBOUND, /*inbound_onion=*/false,
+                                   CNodeOptions{.recv_flood_size = recv_flood_size});
+}
+
+CDataStream MakeMsg(const std::string& payload)
+{
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << payload;
+    return ss;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(net_dispatcher_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(dispatch_round_robin)
+{
+    RecordingHandler handler{m_node.peerman.get()};
+    NetHandlerDispatcher dispatcher{handler, "test-dispatch", {"a", "b"}};
+    BOOST_CHECK(dispatcher.IsDispatched("a"));
+    BOOST_CHECK(!dispatcher.IsDispatched("c"));
+
+    auto node1 = MakeNode(1);
+    auto node2 = MakeNode(2);
+    auto node3 = MakeNode(3);
+    node3->fDisconnect = true;
+
+    // Peer 1 floods the handler before the thread runs, peer 2 still gets every other turn
+    for (const auto& payload : {"1a", "1b", "1c"}) {
+        dispatcher.Enqueue(*node1, "a", MakeMsg(payload));
+    }
+    dispatcher.Enqueue(*node2, "b", MakeMsg("2a"));
+    dispatcher.Enqueue(*node3, "a", MakeMsg("3a"));
+    dispatcher.Enqueue(*node2, "b", MakeMsg("2b"));
+    BOOST_CHECK_EQUAL(node1->GetRefCount(), 3);
+
+    dispatcher.Start();
+    const auto processed = handler.WaitFor(5);
+    dispatcher.Stop();
+
+    // Messages of a disconnected peer are dropped
+    const std::vector<std::pair<NodeId, std::string>> expected{{1, "1a"}, {2, "2a"}, {1, "1b"}, {2, "2b"}, {1, "1c"}};
+    BOOST_CHECK(processed == expected);
+    for (const auto* node : {node1.get(), node2.get(), node3.get()}) {
+        BOOST_CHECK_EQUAL(node->GetRefCount(), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dispatch_shutdown)
+{
+    RecordingHandler handler{m_node.peerman.get()};
+    auto node = MakeNode(1, /*recv_flood_size=*/10);
+    {
+        NetHandlerDispatcher dispatcher{handler, "test-dispatch", {"a"}};
+
+        // Queued bytes pause receiving from the peer
+        dispatcher.Enqueue(*node, "a", MakeMsg("payload larger than the flood limit"));
+        BOOST_CHECK(node->fPauseRecv);
+        BOOST_CHECK_EQUAL(node->GetRefCount(), 1);
+
+        // Stopping without running drops the queue and gives the node back
+        dispatcher.Stop();
+        BOOST_CHECK(!node->fPauseRecv);
+        BOOST_CHECK_EQUAL(node->GetRefCount(), 0);
+        BOOST_CHECK(handler.WaitFor(0).empty());
+
+        // A restarted dispatcher processes new messages and can be stopped again
+        dispatcher.Start();
+        dispatcher.Enqueue(*node, "a", MakeMsg("x"));
+        BOOST_CHECK_EQUAL(handler.WaitFor(1).size(), 1U);
+        dispatcher.Interrupt();
+        dispatcher.Stop();
+
+        // Whatever is queued when the dispatcher goes away is released too
+        dispatcher.Enqueue(*node, "a", MakeMsg("y"));
+        BOOST_CHECK_EQUAL(node->GetRefCount(), 1);
+    }
+    BOOST_CHECK_EQUAL(node->GetRefCount(), 0);
+    BOOST_CHECK_EQUAL(handler.WaitFor(0).size(), 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
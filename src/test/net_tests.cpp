@@ -4,9 +4,13 @@
 
 #include <test/util/setup_common.h>
 
+#include <bls/bls.h>
 #include <chainparams.h>
 #include <clientversion.h>
 #include <compat/compat.h>
+#include <evo/deterministicmns.h>
+#include <evo/netinfo.h>
+#include <evo/providertx.h>
 #include <net.h>
 #include <net_processing.h>
 #include <netaddress.h>
@@ -1642,7 +1646,7 @@ BOOST_AUTO_TEST_CASE(v2_short_id_version_negotiation)
 
         // New peer (v70240) - knows about PLATFORMBAN short ID 168
         V2TransportTester tester_new(true);
-        // Uses PROTOCOL_VERSION (70240) by default
+        // Uses PROTOCOL_VERSION (>= 70240) by default
 
         ret = tester_new.Interact();
         BOOST_REQUIRE(ret && ret->empty());
@@ -1702,4 +1706,314 @@ BOOST_AUTO_TEST_CASE(socket_handler_skips_receive_paused_nodes)
     BOOST_CHECK(HasUnpausedReceivableNode(receivable));
 }
 
+BOOST_AUTO_TEST_CASE(masternode_quorum_refs)
+{
+    auto& connman = *m_node.connman;
+    const auto llmq_type{Consensus::LLMQType::LLMQ_TEST};
+    const uint256 quorum1{InsecureRand256()}, quorum2{InsecureRand256()};
+    const uint256 mn_a{InsecureRand256()}, mn_b{InsecureRand256()}, mn_c{InsecureRand256()};
+
+    std::vector<std::unique_ptr<CNode>> nodes;
+    for (const auto& protx_hash : {mn_a, mn_b, mn_c}) {
+        nodes.emplace_back(std::make_unique<CNode>(nodes.size(), /*sock=*/nullptr, CAddress{CService{}, NODE_NONE},
+                                                   /*nKeyedNetGroupIn=*/0, /*nLocalHostNonceIn=*/0, CAddress{},
+                                                   /*addrNameIn=*/std::string{}, ConnectionType::INBOUND,
+                                                   /*inbound_onion=*/false));
+        nodes.back()->SetVerifiedProRegTxHash(protx_hash);
+    }
+    const auto quorum_nodes = [&]() {
+        std::vector<bool> ret;
+        for (const auto& node : nodes) {
+            ret.push_back(connman.IsMasternodeQuorumNode(node.get()));
+        }
+        return ret;
+    };
+    const auto relay_members = [&]() {
+        std::vector<bool> ret;
+        for (const auto& protx_hash : {mn_a, mn_b, mn_c}) {
+            ret.push_back(connman.IsMasternodeQuorumRelayMember(protx_hash));
+        }
+        return ret;
+    };
+
+    // A masternode stays a quorum node as long as any quorum needs it
+    connman.SetMasternodeQuorumNodes(llmq_type, quorum1, {mn_a, mn_b});
+    connman.SetMasternodeQuorumNodes(llmq_type, quorum2, {mn_b, mn_c});
+    BOOST_CHECK(quorum_nodes() == std::vector<bool>({true, true, true}));
+    connman.SetMasternodeQuorumNodes(llmq_type, quorum1, {mn_a});
+    BOOST_CHECK(quorum_nodes() == std::vector<bool>({true, true, true}));
+    connman.RemoveMasternodeQuorumNodes(llmq_type, quorum2);
+    BOOST_CHECK(!connman.HasMasternodeQuorumNodes(llmq_type, quorum2));
+    BOOST_CHECK(quorum_nodes() == std::vector<bool>({true, false, false}));
+    // Setting the same members again doesn't count them twice
+    connman.SetMasternodeQuorumNodes(llmq_type, quorum1, {mn_a});
+    connman.SetMasternodeQuorumNodes(llmq_type, quorum1, {});
+    BOOST_CHECK(quorum_nodes() == std::vector<bool>({false, false, false}));
+
+    // Same for relay members
+    connman.SetMasternodeQuorumRelayMembers(llmq_type, quorum1, {mn_a, mn_b});
+    connman.SetMasternodeQuorumRelayMembers(llmq_type, quorum2, {mn_b});
+    connman.SetMasternodeQuorumRelayMembers(llmq_type, quorum2, {mn_b});
+    BOOST_CHECK(relay_members() == std::vector<bool>({true, true, false}));
+    connman.RemoveMasternodeQuorumNodes(llmq_type, quorum1);
+    BOOST_CHECK(relay_members() == std::vector<bool>({false, true, false}));
+    connman.RemoveMasternodeQuorumNodes(llmq_type, quorum2);
+    BOOST_CHECK(relay_members() == std::vector<bool>({false, false, false}));
+}
+
+static std::shared_ptr<CDeterministicMNState> MakeMNState(const CDeterministicMNState& state, const std::string& service)
+{
+    auto new_state = std::make_shared<CDeterministicMNState>(state);
+    new_state->netInfo = NetInfoInterface::MakeNetInfo(ProTxVersion::LegacyBLS);
+    BOOST_REQUIRE(new_state->netInfo->AddEntry(NetInfoPurpose::CORE_P2P, service) == NetInfoStatus::Success);
+    return new_state;
+}
+
+static CDeterministicMNCPtr MakeMN(uint64_t internal_id, const std::string& service)
+{
+    CKey owner_key;
+    owner_key.MakeNewKey(/*fCompressed=*/true);
+    CBLSSecretKey operator_key;
+    operator_key.MakeNewKey();
+    CDeterministicMNState state;
+    state.keyIDOwner = owner_key.GetPubKey().GetID();
+    state.pubKeyOperator.Set(operator_key.GetPublicKey(), /*legacy=*/true);
+    auto dmn = std::make_shared<CDeterministicMN>(internal_id, MnType::Regular);
+    dmn->proTxHash = InsecureRand256();
+    dmn->collateralOutpoint = COutPoint(InsecureRand256(), 0);
+    dmn->pdmnState = MakeMNState(state, service);
+    return dmn;
+}
+
+BOOST_AUTO_TEST_CASE(masternode_services_update)
+{
+    auto& connman = *m_node.connman;
+    const std::vector<std::string> services{"1.1.1.1:1", "1.1.1.2:1", "1.1.1.3:1", "1.1.1.4:1", "1.1.1.5:1", "1.1.1.6:1"};
+    const auto lookup = [&]() {
+        std::vector<uint256> ret;
+        for (const auto& service : services) {
+            ret.emplace_back(connman.GetMasternodeByService(LookupNumeric(service, 0)));
+        }
+        return ret;
+    };
+    // The incrementally updated index must match the one built from the new list
+    const auto check_update = [&](const CDeterministicMNList& old_list, const CDeterministicMNList& new_list) {
+        connman.SetMasternodeServices(old_list);
+        connman.UpdateMasternodeServices(old_list, old_list.BuildDiff(new_list));
+        const auto updated{lookup()};
+        connman.SetMasternodeServices(new_list);
+        BOOST_CHECK(updated == lookup());
+        return updated;
+    };
+
+    const auto mn_a{MakeMN(0, services[0])}, mn_b{MakeMN(1, services[1])}, mn_c{MakeMN(2, services[2])};
+    CDeterministicMNList list0(uint256{}, 0, 0);
+    for (const auto& dmn : {mn_a, mn_b, mn_c}) {
+        list0.AddMN(dmn);
+    }
+
+    // A removed masternode
+    CDeterministicMNList list1{list0};
+    list1.RemoveMN(mn_b->proTxHash);
+    auto result{check_update(list0, list1)};
+    BOOST_CHECK(result[0] == mn_a->proTxHash);
+    BOOST_CHECK(result[1].IsNull());
+
+    // A masternode moving to a new service
+    CDeterministicMNList list2{list1};
+    list2.UpdateMN(*mn_c, MakeMNState(*mn_c->pdmnState, services[3]));
+    result = check_update(list1, list2);
+    BOOST_CHECK(result[2].IsNull());
+    BOOST_CHECK(result[3] == mn_c->proTxHash);
+
+    // An added masternode
+    const auto mn_d{MakeMN(3, services[4])};
+    CDeterministicMNList list3{list2};
+    list3.AddMN(mn_d);
+    result = check_update(list2, list3);
+    BOOST_CHECK(result[4] == mn_d->proTxHash);
+
+    // A masternode taking over the service another one just left, both ways round
+    CDeterministicMNList list4{list3};
+    list4.UpdateMN(*mn_a, MakeMNState(*mn_a->pdmnState, services[5]));
+    list4.UpdateMN(*mn_d, MakeMNState(*mn_d->pdmnState, services[0]));
+    result = check_update(list3, list4);
+    BOOST_CHECK(result[0] == mn_d->proTxHash);
+    BOOST_CHECK(result[5] == mn_a->proTxHash);
+    BOOST_CHECK(result[4].IsNull());
+
+    CDeterministicMNList list5{list4};
+    list5.UpdateMN(*list4.GetMN(mn_d->proTxHash), MakeMNState(*mn_d->pdmnState, services[4]));
+    list5.UpdateMN(*list4.GetMN(mn_a->proTxHash), MakeMNState(*mn_a->pdmnState, services[0]));
+    list5.UpdateMN(*list4.GetMN(mn_c->proTxHash), MakeMNState(*mn_c->pdmnState, services[1]));
+    const auto mn_e{MakeMN(4, services[3])};
+    list5.AddMN(mn_e);
+    result = check_update(list4, list5);
+    BOOST_CHECK(result[0] == mn_a->proTxHash);
+    BOOST_CHECK(result[1] == mn_c->proTxHash);
+    BOOST_CHECK(result[3] == mn_e->proTxHash);
+    BOOST_CHECK(result[4] == mn_d->proTxHash);
+    BOOST_CHECK(result[5].IsNull());
+}
+
+BOOST_AUTO_TEST_CASE(send_queue_priority)
+{
+    auto make_msg = [](const std::string& msg_type, uint8_t tag) {
+        CSerializedNetMsg msg;
+        msg.m_type = msg_type;
+        msg.data = {tag};
+        return msg;
+    };
+    auto pop = [](SendQueue& queue) {
+        auto msg = std::move(queue.front());
+        queue.pop_front();
+        return std::make_pair(msg.m_type, msg.data.at(0));
+    };
+
+    BOOST_CHECK(GetSendPriority(NetMsgType::QSIGSHARE) == SendPriority::HIGH);
+    BOOST_CHECK(GetSendPriority(NetMsgType::CLSIG) == SendPriority::HIGH);
+    BOOST_CHECK(GetSendPriority(NetMsgType::MNAUTH) == SendPriority::HIGH);
+    BOOST_CHECK(GetSendPriority(NetMsgType::INV) == SendPriority::NORMAL);
+    BOOST_CHECK(GetSendPriority(NetMsgType::MERKLEBLOCK) == SendPriority::NORMAL);
+    BOOST_CHECK(GetSendPriority(NetMsgType::BLOCK) == SendPriority::NORMAL);
+    BOOST_CHECK(GetSendPriority(NetMsgType::MNLISTDIFF) == SendPriority::BULK);
+
+    SendQueue queue;
+    BOOST_CHECK(queue.empty());
+    queue.push_back(make_msg(NetMsgType::MNLISTDIFF, 0));
+    queue.push_back(make_msg(NetMsgType::INV, 1));
+    queue.push_back(make_msg(NetMsgType::MNLISTDIFF, 2));
+    queue.push_back(make_msg(NetMsgType::QSIGSHARE, 3));
+    queue.push_back(make_msg(NetMsgType::INV, 4));
+    queue.push_back(make_msg(NetMsgType::CLSIG, 5));
+    BOOST_CHECK_EQUAL(queue.size(), 6U);
+
+    // Higher classes first, FIFO within a class
+    BOOST_CHECK(pop(queue) == std::make_pair(std::string{NetMsgType::QSIGSHARE}, uint8_t{3}));
+    BOOST_CHECK(pop(queue) == std::make_pair(std::string{NetMsgType::CLSIG}, uint8_t{5}));
+    BOOST_CHECK(pop(queue) == std::make_pair(std::string{NetMsgType::INV}, uint8_t{1}));
+    BOOST_CHECK(pop(queue) == std::make_pair(std::string{NetMsgType::INV}, uint8_t{4}));
+    BOOST_CHECK(pop(queue) == std::make_pair(std::string{NetMsgType::MNLISTDIFF}, uint8_t{0}));
+    BOOST_CHECK(pop(queue) == std::make_pair(std::string{NetMsgType::MNLISTDIFF}, uint8_t{2}));
+    BOOST_CHECK(queue.empty());
+
+    // A steady stream of high priority messages can't starve bulk ones
+    queue.push_back(make_msg(NetMsgType::MNLISTDIFF, 0));
+    size_t high_sent{0};
+    while (true) {
+        queue.push_back(make_msg(NetMsgType::QSIGSHARE, 0));
+        if (pop(queue).first == NetMsgType::MNLISTDIFF) break;
+        ++high_sent;
+        BOOST_REQUIRE(high_sent <= SendQueue::MAX_SKIPPED);
+    }
+    BOOST_CHECK_EQUAL(high_sent, SendQueue::MAX_SKIPPED);
+
+    queue.clear();
+    BOOST_CHECK(queue.empty());
+    BOOST_CHECK_EQUAL(queue.size(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(send_queue_handshake_order)
+{
+    LOCK(NetEventsInterface::g_msgproc_mutex);
+
+    CNode peer{/*id=*/0,
+               /*sock=*/nullptr,
+               /*addrIn=*/CAddress{CService{LookupNumeric("1.2.3.4", 8333)}, NODE_NETWORK},
+               /*nKeyedNetGroupIn=*/0,
+               /*nLocalHostNonceIn=*/0,
+               /*addrBindIn=*/CAddress{},
+               /*addrNameIn=*/std::string{},
+               /*conn_type_in=*/ConnectionType::OUTBOUND_FULL_RELAY,
+               /*inbound_onion=*/false};
+    const CNetMsgMaker msg_maker{PROTOCOL_VERSION};
+    std::atomic<bool> interrupt_dummy{false};
+    std::chrono::microseconds time_received_dummy{0};
+    auto drain = [&peer] {
+        std::vector<std::string> sent;
+        LOCK(peer.cs_vSend);
+        while (!peer.vSendMsg.empty()) {
+            sent.emplace_back(peer.vSendMsg.front().m_type);
+            peer.vSendMsg.pop_front();
+        }
+        return sent;
+    };
+    auto position = [](const std::vector<std::string>& sent, const std::string& msg_type) {
+        return std::distance(sent.begin(), std::find(sent.begin(), sent.end(), msg_type));
+    };
+
+    m_node.peerman->InitializeNode(peer, NODE_NETWORK);
+    const auto msg_version = msg_maker.Make(NetMsgType::VERSION, PROTOCOL_VERSION, uint64_t{NODE_NETWORK}, int64_t{0},
+                                            uint64_t{NODE_NETWORK}, CService{});
+    CDataStream msg_version_stream{msg_version.data, SER_NETWORK, PROTOCOL_VERSION};
+    m_node.peerman->ProcessMessage(peer, NetMsgType::VERSION, msg_version_stream, time_received_dummy, interrupt_dummy);
+    BOOST_REQUIRE(!peer.fDisconnect);
+
+    // BIP155 requires SENDADDRV2 before VERACK, the peer disconnects otherwise
+    const auto handshake = drain();
+    BOOST_REQUIRE(!handshake.empty());
+    BOOST_CHECK_EQUAL(handshake.front(), NetMsgType::VERSION);
+    const auto sendaddrv2_pos = position(handshake, NetMsgType::SENDADDRV2);
+    const auto verack_pos = position(handshake, NetMsgType::VERACK);
+    BOOST_REQUIRE(verack_pos < std::ssize(handshake));
+    BOOST_CHECK(sendaddrv2_pos < verack_pos);
+
+    const auto msg_verack = msg_maker.Make(NetMsgType::VERACK);
+    CDataStream msg_verack_stream{msg_verack.data, SER_NETWORK, PROTOCOL_VERSION};
+    m_node.peerman->ProcessMessage(peer, NetMsgType::VERACK, msg_verack_stream, time_received_dummy, interrupt_dummy);
+    BOOST_REQUIRE(peer.fSuccessfullyConnected);
+    drain();
+
+    // Once connected, quorum messages overtake others, but the hashContinue INV of a getblocks
+    // response still follows its block
+    m_node.connman->PushMessage(&peer, msg_maker.Make(NetMsgType::BLOCK, CBlock{}));
+    m_node.connman->PushMessage(&peer, msg_maker.Make(NetMsgType::INV, std::vector<CInv>{}));
+    m_node.connman->PushMessage(&peer, msg_maker.Make(NetMsgType::QSIGSHARE, std::vector<uint8_t>{}));
+    const std::vector<std::string> expected{NetMsgType::QSIGSHARE, NetMsgType::BLOCK, NetMsgType::INV};
+    BOOST_CHECK(drain() == expected);
+
+    m_node.peerman->FinalizeNode(peer);
+    TestOnlyResetTimeData();
+}
+
+BOOST_AUTO_TEST_CASE(shared_serialized_msg)
+{
+    auto serialize = [](CSerializedNetMsg msg) {
+        V1Transport transport{/*node_id=*/0, SER_NETWORK, INIT_PROTO_VERSION};
+        BOOST_REQUIRE(transport.SetMessageToSend(msg));
+        std::vector<uint8_t> wire;
+        while (true) {
+            const auto& [bytes, more, msg_type] = transport.GetBytesToSend(/*have_next_message=*/false);
+            if (bytes.empty()) break;
+            wire.insert(wire.end(), bytes.begin(), bytes.end());
+            transport.MarkBytesSent(bytes.size());
+        }
+        return wire;
+    };
+
+    CSerializedNetMsg msg;
+    msg.m_type = NetMsgType::QSIGREC;
+    msg.data = {0x01, 0x02, 0x03, 0x04, 0x05};
+    const auto expected{serialize(msg.Copy())};
+
+    msg.MakeShared();
+    BOOST_CHECK(msg.data.empty());
+    BOOST_REQUIRE(msg.m_shared);
+    BOOST_CHECK(msg.Payload().size() == 5);
+
+    // Copies share the payload and put the same bytes on the wire
+    auto copy{msg.Copy()};
+    BOOST_CHECK(copy.m_shared == msg.m_shared);
+    BOOST_CHECK(serialize(std::move(copy)) == expected);
+    BOOST_CHECK(serialize(msg.Copy()) == expected);
+    BOOST_CHECK_EQUAL(msg.m_shared.use_count(), 1);
+
+    // Every queued copy is still accounted for the full payload size
+    BOOST_CHECK_EQUAL(msg.Copy().GetMemoryUsage(), msg.GetMemoryUsage());
+    BOOST_CHECK(msg.GetMemoryUsage() > sizeof(CSerializedNetMsg));
+
+    msg.ClearPayload();
+    BOOST_CHECK(msg.Payload().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
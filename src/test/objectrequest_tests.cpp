@@ -0,0 +1,95 @@
+// Copyright (c) 2025 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <objectrequest.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std::chrono_literals;
+
+BOOST_FIXTURE_TEST_SUITE(objectrequest_tests, BasicTestingSetup)
+
+static bool IsInv(const std::optional<CInv>& inv, const CInv& expected)
+{
+    return inv && inv->type == expected.type && inv->hash == expected.hash;
+}
+
+BOOST_AUTO_TEST_CASE(schedule_and_request)
+{
+    ObjectRequestTracker tracker(/*max_peer_announcements=*/3);
+    const CInv inv1{MSG_ISDLOCK, uint256::ONE};
+    const CInv inv2{MSG_CLSIG, uint256::TWO};
+    const CInv inv3{MSG_TX, uint256{3}};
+
+    BOOST_CHECK(!tracker.IsPreferred(1));
+    tracker.SetPreferred(1, true);
+    BOOST_CHECK(tracker.IsPreferred(1));
+
+    BOOST_CHECK(tracker.ReceivedInv(1, inv1, 20s));
+    BOOST_CHECK(tracker.ReceivedInv(1, inv2, 10s));
+    // Duplicate announcements are ignored
+    BOOST_CHECK(!tracker.ReceivedInv(1, inv2, 5s));
+    BOOST_CHECK(tracker.ReceivedInv(1, inv3, 30s));
+    // Too many announcements
+    BOOST_CHECK(!tracker.ReceivedInv(1, CInv{MSG_TX, uint256{4}}, 1s));
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(1), 3U);
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(2), 0U);
+
+    // Nothing due yet, then in process time order
+    BOOST_CHECK(!tracker.NextDue(1, 9s, 10));
+    BOOST_CHECK(IsInv(tracker.NextDue(1, 25s, 10), inv2));
+    tracker.RequestedObject(1, inv2, 25s, 85s);
+    BOOST_CHECK_EQUAL(tracker.GetLastRequestTime(inv2.hash).count(), std::chrono::microseconds{25s}.count());
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(1), 2U);
+
+    // The in flight limit is respected
+    BOOST_CHECK(!tracker.NextDue(1, 25s, 1));
+    BOOST_CHECK(IsInv(tracker.NextDue(1, 25s, 2), inv1));
+    tracker.Reschedule(1, inv1, 40s);
+    BOOST_CHECK(!tracker.NextDue(1, 25s, 10));
+    BOOST_CHECK(IsInv(tracker.NextDue(1, 35s, 10), inv3));
+    tracker.DropAnnouncement(1, inv3);
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(1), 1U);
+
+    // Requests expire in expiry order
+    BOOST_CHECK(tracker.ExpireRequests(1, 84s).empty());
+    const auto expired{tracker.ExpireRequests(1, 85s)};
+    BOOST_REQUIRE_EQUAL(expired.size(), 1U);
+    BOOST_CHECK(IsInv(expired[0], inv2));
+
+    // A NOTFOUND only drops in flight requests
+    tracker.ReceivedNotFound(1, inv1);
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(1), 1U);
+
+    tracker.DisconnectedPeer(1);
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(1), 0U);
+    BOOST_CHECK(!tracker.IsPreferred(1));
+}
+
+BOOST_AUTO_TEST_CASE(forget_object)
+{
+    ObjectRequestTracker tracker(/*max_peer_announcements=*/10);
+    const CInv inv{MSG_GOVERNANCE_OBJECT, uint256::ONE};
+
+    BOOST_CHECK(tracker.ReceivedInv(1, inv, 0s));
+    BOOST_CHECK(tracker.ReceivedInv(2, inv, 0s));
+    BOOST_CHECK(IsInv(tracker.NextDue(1, 1s, 10), inv));
+    tracker.RequestedObject(1, inv, 1s, 61s);
+
+    // Received from peer 1, peer 2's announcement is skipped
+    tracker.ForgetObject(1, inv, 2s);
+    BOOST_CHECK_EQUAL(tracker.GetLastRequestTime(inv.hash).count(), 0);
+    BOOST_CHECK(tracker.ExpireRequests(1, 100s).empty());
+    BOOST_CHECK(!tracker.NextDue(2, 3s, 10));
+    BOOST_CHECK_EQUAL(tracker.CountScheduled(2), 0U);
+
+    // Unless a request is forced
+    BOOST_CHECK(tracker.ReceivedInv(2, inv, 3s));
+    tracker.ForceRequest(inv.hash);
+    BOOST_CHECK(IsInv(tracker.NextDue(2, 3s, 10), inv));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
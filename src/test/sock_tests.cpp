@@ -4,6 +4,7 @@
 
 #include <compat/compat.h>
 #include <test/util/setup_common.h>
+#include <util/edge.h>
 #include <util/sock.h>
 #include <util/system.h>
 #include <util/threadinterrupt.h>
@@ -128,6 +129,125 @@ BOOST_AUTO_TEST_CASE(wait)
     waiter.join();
 }
 
+#ifdef USE_IO_URING
+BOOST_AUTO_TEST_CASE(wait_many_io_uring)
+{
+    EdgeTriggeredEvents events{SocketEventsMode::IOUring};
+    if (!events.IsValid()) {
+        // io_uring may be unavailable (old kernel or disabled by the sandbox), nothing to test
+        return;
+    }
+
+    int s[2];
+    CreateSocketPair(s);
+    Sock sock0(s[0]);
+    Sock sock1(s[1]);
+    BOOST_REQUIRE(events.RegisterEvents(sock0.Get()));
+
+    const SocketEventsParams params{SocketEventsMode::IOUring, static_cast<SOCKET>(events.GetFileDescriptor()),
+                                    [](std::function<void()>&& func) { func(); }, &events};
+
+    // The registration is submitted together with the first wait, which reports the socket as writable
+    Sock::EventsPerSock events_per_sock;
+    BOOST_REQUIRE(Sock::WaitManyInternal(1s, events_per_sock, params));
+    BOOST_REQUIRE(events_per_sock.count(sock0.Get()));
+    BOOST_CHECK(events_per_sock.at(sock0.Get()).occurred & Sock::SEND);
+    BOOST_CHECK(!(events_per_sock.at(sock0.Get()).occurred & Sock::RECV));
+
+    // Nothing happened since, the wait times out without events
+    BOOST_REQUIRE(Sock::WaitManyInternal(10ms, events_per_sock, params));
+    BOOST_CHECK(events_per_sock.empty());
+
+    // Incoming data is reported by the still armed multishot poll
+    BOOST_REQUIRE_EQUAL(sock1.Send("a", 1, 0), 1);
+    BOOST_REQUIRE(Sock::WaitManyInternal(1s, events_per_sock, params));
+    BOOST_REQUIRE(events_per_sock.count(sock0.Get()));
+    BOOST_CHECK(events_per_sock.at(sock0.Get()).occurred & Sock::RECV);
+
+    // After unregistering, no more events are reported for the socket
+    BOOST_REQUIRE(events.UnregisterEvents(sock0.Get()));
+    BOOST_REQUIRE_EQUAL(sock1.Send("b", 1, 0), 1);
+    BOOST_REQUIRE(Sock::WaitManyInternal(10ms, events_per_sock, params));
+    BOOST_CHECK(!events_per_sock.count(sock0.Get()));
+}
+
+BOOST_AUTO_TEST_CASE(wait_many_io_uring_register_twice)
+{
+    EdgeTriggeredEvents events{SocketEventsMode::IOUring};
+    if (!events.IsValid()) return;
+
+    const SocketEventsParams params{SocketEventsMode::IOUring, static_cast<SOCKET>(events.GetFileDescriptor()),
+                                    [](std::function<void()>&& func) { func(); }, &events};
+
+    int s[2];
+    CreateSocketPair(s);
+    Sock sock0(s[0]);
+    Sock sock1(s[1]);
+    BOOST_REQUIRE(events.RegisterEvents(sock0.Get()));
+    // An already registered socket is rejected, the first registration stays in place
+    BOOST_CHECK(!events.RegisterEvents(sock0.Get()));
+    Sock::EventsPerSock events_per_sock;
+    BOOST_REQUIRE(Sock::WaitManyInternal(1s, events_per_sock, params));
+    BOOST_CHECK(events_per_sock.count(sock0.Get()));
+
+    // Unregistering cancels the only poll, no events are reported afterwards
+    BOOST_REQUIRE(events.UnregisterEvents(sock0.Get()));
+    BOOST_CHECK(!events.UnregisterEvents(sock0.Get()));
+    BOOST_REQUIRE_EQUAL(sock1.Send("a", 1, 0), 1);
+    BOOST_REQUIRE(Sock::WaitManyInternal(10ms, events_per_sock, params));
+    BOOST_CHECK(!events_per_sock.count(sock0.Get()));
+
+    // It can be registered again afterwards
+    BOOST_REQUIRE(events.RegisterEvents(sock0.Get()));
+    BOOST_REQUIRE(Sock::WaitManyInternal(1s, events_per_sock, params));
+    BOOST_REQUIRE(events_per_sock.count(sock0.Get()));
+    BOOST_CHECK(events_per_sock.at(sock0.Get()).occurred & Sock::RECV);
+    BOOST_REQUIRE(events.UnregisterEvents(sock0.Get()));
+}
+
+BOOST_AUTO_TEST_CASE(wait_many_io_uring_reused_fd)
+{
+    EdgeTriggeredEvents events{SocketEventsMode::IOUring};
+    if (!events.IsValid()) return;
+
+    const SocketEventsParams params{SocketEventsMode::IOUring, static_cast<SOCKET>(events.GetFileDescriptor()),
+                                    [](std::function<void()>&& func) { func(); }, &events};
+
+    // A readable socket is registered and unregistered before any wait, the readiness completion
+    // of its poll is still waiting to be reaped when the socket is closed
+    SOCKET reused;
+    {
+        int s[2];
+        CreateSocketPair(s);
+        Sock sock0(s[0]);
+        Sock sock1(s[1]);
+        BOOST_REQUIRE_EQUAL(sock1.Send("a", 1, 0), 1);
+        BOOST_REQUIRE(events.RegisterEvents(sock0.Get()));
+        BOOST_REQUIRE(events.UnregisterEvents(sock0.Get()));
+        reused = sock0.Get();
+    }
+
+    // A new socket gets the same descriptor, the stale completion must not be reported for it
+    int s[2];
+    CreateSocketPair(s);
+    Sock sock0(s[0]);
+    Sock sock1(s[1]);
+    if (sock0.Get() != reused) return;
+    BOOST_REQUIRE(events.RegisterEvents(sock0.Get()));
+    Sock::EventsPerSock events_per_sock;
+    BOOST_REQUIRE(Sock::WaitManyInternal(1s, events_per_sock, params));
+    BOOST_REQUIRE(events_per_sock.count(sock0.Get()));
+    BOOST_CHECK(!(events_per_sock.at(sock0.Get()).occurred & Sock::RECV));
+
+    // The new registration works
+    BOOST_REQUIRE_EQUAL(sock1.Send("b", 1, 0), 1);
+    BOOST_REQUIRE(Sock::WaitManyInternal(1s, events_per_sock, params));
+    BOOST_REQUIRE(events_per_sock.count(sock0.Get()));
+    BOOST_CHECK(events_per_sock.at(sock0.Get()).occurred & Sock::RECV);
+    BOOST_REQUIRE(events.UnregisterEvents(sock0.Get()));
+}
+#endif /* USE_IO_URING */
+
 BOOST_AUTO_TEST_CASE(recv_until_terminator_limit)
 {
     constexpr auto timeout = 1min; // High enough so that it is never hit.
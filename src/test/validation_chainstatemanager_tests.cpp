@@ -4,19 +4,24 @@
 //
 #include <chainparams.h>
 #include <consensus/validation.h>
+#include <hash.h>
 #include <index/txindex.h>
 #include <node/chainstate.h>
 #include <node/utxo_snapshot.h>
 #include <random.h>
 #include <rpc/blockchain.h>
+#include <script/standard.h>
+#include <spork.h>
 #include <sync.h>
 #include <test/util/chainstate.h>
 #include <test/util/random.h>
 #include <test/util/setup_common.h>
 #include <uint256.h>
+#include <util/time.h>
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <chainlock/chainlock.h>
 #include <chainlock/handler.h>
 #include <evo/evodb.h>
 #include <llmq/blockprocessor.h>
@@ -24,6 +29,7 @@
 
 #include <tinyformat.h>
 
+#include <chrono>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -415,4 +421,65 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_loadblockindex, TestChain100Setup)
     BOOST_CHECK_EQUAL(cs2.setBlockIndexCandidates.size(), num_indexes);
 }
 
+//! Blocks connected below a chainlock with -skipchainlockedscripts are flagged for the script
+//! audit. The flag is persisted with the block index and cleared once the audit verified the block.
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_script_audit, TestChain100Setup)
+{
+    ChainstateManager& chainman = *Assert(m_node.chainman);
+    CChainState& chainstate = chainman.ActiveChainstate();
+    chainlock::Chainlocks& chainlocks = *Assert(m_node.chainlocks);
+
+    // Enable chainlocks, without signing them
+    CSporkManager& sporkman = *Assert(m_node.sporkman);
+    BOOST_REQUIRE(sporkman.SetSporkAddress(Params().SporkAddresses().front()));
+    BOOST_REQUIRE(sporkman.SetMinSporkKeys(Params().MinSporkKeys()));
+    BOOST_REQUIRE(sporkman.SetPrivKey("cP4EKFyJsHT39LDqgdcB43Y3YXjNyjb5Fuas1GQSeAtjnZWmZEQK"));
+    BOOST_REQUIRE(sporkman.UpdateSpork(SPORK_19_CHAINLOCKS_ENABLED, 1));
+    BOOST_REQUIRE(chainlocks.IsEnabled());
+
+    // A block with a transaction spending a coinbase, chainlocked before it is connected
+    const CScript coinbase_script{GetScriptForRawPubKey(coinbaseKey.GetPubKey())};
+    const CMutableTransaction tx{CreateValidMempoolTransaction(m_coinbase_txns[0], 0, 1, coinbaseKey, coinbase_script,
+                                                               10 * COIN, /*submit=*/false)};
+    const auto block{std::make_shared<const CBlock>(CreateBlock({tx}, coinbase_script, chainstate))};
+    BlockValidationState state;
+    const CBlockIndex* pindex{nullptr};
+    BOOST_REQUIRE(chainman.ProcessNewBlockHeaders({block->GetBlockHeader()}, state, &pindex));
+    const chainlock::ChainLockSig clsig{pindex->nHeight, block->GetHash(), CBLSSignature{}};
+    BOOST_REQUIRE(chainlocks.UpdateBestChainlock(::SerializeHash(clsig), clsig, pindex));
+
+    g_skip_chainlocked_scripts = true;
+    const bool processed{chainman.ProcessNewBlock(block, /*force_processing=*/true, /*new_block=*/nullptr)};
+    g_skip_chainlocked_scripts = DEFAULT_SKIP_CHAINLOCKED_SCRIPTS;
+    BOOST_REQUIRE(processed);
+    BOOST_REQUIRE(WITH_LOCK(::cs_main, return chainman.ActiveTip()) == pindex);
+
+    auto is_unverified = [&] { return WITH_LOCK(::cs_main, return (pindex->nStatus & BLOCK_SCRIPTS_UNVERIFIED) != 0); };
+    auto reload_block_index = [&] {
+        LOCK(::cs_main);
+        for (CChainState* cs : chainman.GetAll()) {
+            cs->UnloadBlockIndex();
+        }
+        BOOST_REQUIRE(chainman.LoadBlockIndex());
+    };
+    BOOST_CHECK(is_unverified());
+
+    // The flag survives a restart
+    chainstate.ForceFlushStateToDisk();
+    WITH_LOCK(::cs_main, const_cast<CBlockIndex*>(pindex)->nStatus &= ~BLOCK_SCRIPTS_UNVERIFIED);
+    reload_block_index();
+    BOOST_CHECK(is_unverified());
+
+    // The audit picks up the flagged block and clears the flag once its scripts are verified
+    chainman.StartScriptAudit(/*threads_num=*/1);
+    for (int i = 0; i < 100 && is_unverified(); ++i) {
+        UninterruptibleSleep(std::chrono::milliseconds{100});
+    }
+    chainman.StopScriptAudit();
+    BOOST_CHECK(!is_unverified());
+    chainstate.ForceFlushStateToDisk();
+    reload_block_index();
+    BOOST_CHECK(!is_unverified());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 //
+#include <chainlock/chainlock.h>
 #include <evo/evodb.h>
 #include <sync.h>
 #include <test/util/coins.h>
@@ -155,4 +156,64 @@ BOOST_AUTO_TEST_CASE(getcoinscachesizestate)
         CoinsCacheSizeState::OK);
 }
 
+struct FlushTestingSetup : public TestChain100Setup {
+    // Keep the mempool headroom small, so the coins cache can be made LARGE quickly
+    FlushTestingSetup()
+        : TestChain100Setup{CBaseChainParams::REGTEST, {"-maxmempool=5"}} {}
+};
+
+//! A periodic flush of a LARGE coins cache with a chainlock writes everything,
+//! but only drops the coins at or below the chainlock.
+BOOST_FIXTURE_TEST_CASE(flush_large_keeps_unlocked_coins, FlushTestingSetup)
+{
+    CChainState& chainstate{m_node.chainman->ActiveChainstate()};
+    chainstate.ForceFlushStateToDisk();
+
+    LOCK(::cs_main);
+    auto& view = chainstate.CoinsTip();
+    const int tip_height{chainstate.m_chain.Height()};
+    const CBlockIndex* locked{chainstate.m_chain[tip_height - 10]};
+    BOOST_REQUIRE(m_node.chainlocks->UpdateBestChainlock(locked->GetBlockHash(),
+                                                         chainlock::ChainLockSig(locked->nHeight, locked->GetBlockHash(), CBLSSignature()),
+                                                         locked));
+
+    const auto add_coin = [&](int height) {
+        Coin coin;
+        coin.nHeight = height;
+        coin.out.nValue = InsecureRandMoneyAmount();
+        // Short enough to be stored inline, the cache usage is then all in the map itself
+        coin.out.scriptPubKey.assign(uint32_t{25}, 1);
+        const COutPoint outpoint{InsecureRand256(), 0};
+        view.AddCoin(outpoint, std::move(coin), /*possible_overwrite=*/false);
+        return outpoint;
+    };
+    std::vector<COutPoint> unlocked;
+    for (int i = 0; i < 100; ++i) {
+        unlocked.push_back(add_coin(tip_height));
+    }
+    // Fill the cache up to LARGE with coins below the chainlock
+    chainstate.m_coinstip_cache_size_bytes = 1 << 20;
+    std::vector<COutPoint> locked_coins;
+    while (chainstate.GetCoinsCacheSizeState() < CoinsCacheSizeState::LARGE) {
+        locked_coins.push_back(add_coin(1));
+    }
+    BOOST_CHECK(chainstate.GetCoinsCacheSizeState() == CoinsCacheSizeState::LARGE);
+
+    BlockValidationState state;
+    BOOST_CHECK(chainstate.FlushStateToDisk(state, FlushStateMode::PERIODIC));
+
+    // Everything was written, the coins above the chainlock are still cached and the cache is no longer LARGE
+    BOOST_CHECK_EQUAL(view.GetCacheSize(), unlocked.size());
+    for (const auto& outpoint : unlocked) {
+        BOOST_CHECK(view.HaveCoinInCache(outpoint));
+        BOOST_CHECK(chainstate.CoinsDB().HaveCoin(outpoint));
+    }
+    for (const auto& outpoint : locked_coins) {
+        BOOST_CHECK(!view.HaveCoinInCache(outpoint));
+        BOOST_CHECK(chainstate.CoinsDB().HaveCoin(outpoint));
+    }
+    BOOST_CHECK(chainstate.GetCoinsCacheSizeState() == CoinsCacheSizeState::OK);
+    BOOST_CHECK(chainstate.CoinsDB().GetBestBlock() == chainstate.m_chain.Tip()->GetBlockHash());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,7 +3,9 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <consensus/amount.h>
+#include <ctpl_stl.h>
 #include <net.h>
+#include <primitives/block.h>
 #include <uint256.h>
 #include <validation.h>
 
@@ -36,4 +38,29 @@ BOOST_AUTO_TEST_CASE(test_assumeutxo)
     BOOST_CHECK_EQUAL(out210.nChainTx, 200U);
 }
 
+BOOST_AUTO_TEST_CASE(hash_headers)
+{
+    ctpl::thread_pool pool(3);
+
+    // Batch sizes below, at and above the size that is split between threads
+    for (const size_t count : {0, 1, 249, 250, 499, 500, 1001, 2000}) {
+        std::vector<CBlockHeader> headers(count);
+        for (size_t i = 0; i < count; ++i) {
+            headers[i].nTime = i;
+            headers[i].nNonce = i * 7;
+        }
+        std::vector<uint256> expected;
+        for (const auto& header : headers) {
+            expected.push_back(header.GetHash());
+        }
+        BOOST_CHECK(HashHeaders(headers, &pool) == expected);
+        BOOST_CHECK(HashHeaders(headers, nullptr) == expected);
+    }
+
+    // A pool without threads hashes everything on the calling thread
+    ctpl::thread_pool empty_pool;
+    const std::vector<CBlockHeader> headers(1000);
+    BOOST_CHECK(HashHeaders(headers, &empty_pool) == std::vector<uint256>(1000, CBlockHeader{}.GetHash()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,7 @@
 #include <evo/deterministicmns.h>
 #include <instantsend/instantsend.h>
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <optional>
@@ -541,9 +542,20 @@ void CTxMemPool::addAddressIndex(const CTxMemPoolEntry& entry, const CCoinsViewC
 
     LOCK(cs);
     const CTransaction& tx = entry.GetTx();
-    std::vector<CMempoolAddressDeltaKey> inserted;
+    const uint256 txhash = tx.GetHash();
+    // The reverse links live on the pooled copy of the entry, the one passed in may be a temporary
+    const auto it = mapTx.find(txhash);
+    if (it == mapTx.end()) return;
+    std::vector<CMempoolAddress>& inserted = it->m_address_index_keys;
+    cachedInnerUsage -= memusage::DynamicUsage(inserted);
+
+    auto add_delta = [&](CMempoolAddress&& address, CMempoolAddressDeltaKey&& key, CMempoolAddressDelta&& delta) {
+        if (std::find(inserted.begin(), inserted.end(), address) == inserted.end()) {
+            inserted.push_back(address);
+        }
+        mapAddress[std::move(address)][txhash].emplace_back(std::move(key), std::move(delta));
+    };
 
-    uint256 txhash = tx.GetHash();
     for (unsigned int j = 0; j < tx.vin.size(); j++) {
         const CTxIn input = tx.vin[j];
         const Coin& coin = view.AccessCoin(input.prevout);
@@ -556,10 +568,9 @@ void CTxMemPool::addAddressIndex(const CTxMemPoolEntry& entry, const CCoinsViewC
             continue;
         }
 
-        CMempoolAddressDeltaKey key(address_type, address_bytes, txhash, j, /* tx_spent */ true);
-        CMempoolAddressDelta delta(entry.GetTime(), prevout.nValue * -1, input.prevout.hash, input.prevout.n);
-        mapAddress.insert(std::make_pair(key, delta));
-        inserted.push_back(key);
+        add_delta({address_type, address_bytes},
+                  CMempoolAddressDeltaKey(address_type, address_bytes, txhash, j, /* tx_spent */ true),
+                  CMempoolAddressDelta(entry.GetTime(), prevout.nValue * -1, input.prevout.hash, input.prevout.n));
     }
 
     for (unsigned int k = 0; k < tx.vout.size(); k++) {
@@ -572,12 +583,11 @@ void CTxMemPool::addAddressIndex(const CTxMemPoolEntry& entry, const CCoinsViewC
             continue;
         }
 
-        CMempoolAddressDeltaKey key(address_type, address_bytes, txhash, k, /* tx_spent */ false);
-        mapAddress.insert(std::make_pair(key, CMempoolAddressDelta(entry.GetTime(), out.nValue)));
-        inserted.push_back(key);
+        add_delta({address_type, address_bytes},
+                  CMempoolAddressDeltaKey(address_type, address_bytes, txhash, k, /* tx_spent */ false),
+                  CMempoolAddressDelta(entry.GetTime(), out.nValue));
     }
-
-    mapAddressInserted.insert(std::make_pair(txhash, inserted));
+    cachedInnerUsage += memusage::DynamicUsage(inserted);
 }
 
 void CTxMemPool::getAddressIndex(const std::vector<CMempoolAddressDeltaKey>& addresses,
@@ -585,24 +595,28 @@ void CTxMemPool::getAddressIndex(const std::vector<CMempoolAddressDeltaKey>& add
 {
     LOCK(cs);
     for (const auto& address : addresses) {
-        auto ait = mapAddress.lower_bound(address);
-        while (ait != mapAddress.end() && (*ait).first.m_address_bytes == address.m_address_bytes
-               && (*ait).first.m_address_type == address.m_address_type) {
-            results.push_back(*ait);
-            ait++;
+        if (auto it = mapAddress.find({address.m_address_type, address.m_address_bytes}); it != mapAddress.end()) {
+            for (const auto& [_, deltas] : it->second) {
+                results.insert(results.end(), deltas.begin(), deltas.end());
+            }
         }
     }
 }
 
-void CTxMemPool::removeAddressIndex(const uint256 txhash)
+void CTxMemPool::removeAddressIndex(const CTxMemPoolEntry& entry)
 {
-    LOCK(cs);
-    if (auto it = mapAddressInserted.find(txhash); it != mapAddressInserted.end()) {
-        for (const auto& key : (*it).second) {
-            mapAddress.erase(key);
+    AssertLockHeld(cs);
+    const uint256& txhash = entry.GetTx().GetHash();
+    for (const auto& address : entry.m_address_index_keys) {
+        auto it = mapAddress.find(address);
+        if (it == mapAddress.end()) continue;
+        it->second.erase(txhash);
+        if (it->second.empty()) {
+            mapAddress.erase(it);
         }
-        mapAddressInserted.erase(it);
     }
+    cachedInnerUsage -= memusage::DynamicUsage(entry.m_address_index_keys);
+    std::vector<CMempoolAddress>().swap(entry.m_address_index_keys);
 }
 
 void CTxMemPool::addSpentIndex(const CTxMemPoolEntry& entry, const CCoinsViewCache& view)
@@ -612,7 +626,6 @@ void CTxMemPool::addSpentIndex(const CTxMemPoolEntry& entry, const CCoinsViewCac
     LOCK(cs);
 
     const CTransaction& tx = entry.GetTx();
-    std::vector<CSpentIndexKey> inserted;
 
     uint256 txhash = tx.GetHash();
     for (unsigned int j = 0; j < tx.vin.size(); j++) {
@@ -627,72 +640,113 @@ void CTxMemPool::addSpentIndex(const CTxMemPoolEntry& entry, const CCoinsViewCac
             continue;
         }
 
-        CSpentIndexKey key = CSpentIndexKey(input.prevout.hash, input.prevout.n);
-        CSpentIndexValue value = CSpentIndexValue(txhash, j, -1, prevout.nValue, address_type, address_bytes);
-
-        mapSpent.insert(std::make_pair(key, value));
-        inserted.push_back(key);
+        mapSpent.emplace(input.prevout, CSpentIndexValue(txhash, j, -1, prevout.nValue, address_type, address_bytes));
     }
-
-    mapSpentInserted.insert(make_pair(txhash, inserted));
 }
 
 bool CTxMemPool::getSpentIndex(const CSpentIndexKey& key, CSpentIndexValue& value) const
 {
     LOCK(cs);
-    if (auto it = mapSpent.find(key); it != mapSpent.end()) {
+    if (auto it = mapSpent.find(COutPoint(key.m_tx_hash, key.m_tx_index)); it != mapSpent.end()) {
         value = it->second;
         return true;
     }
     return false;
 }
 
-void CTxMemPool::removeSpentIndex(const uint256 txhash)
+void CTxMemPool::removeSpentIndex(const CTransaction& tx)
 {
-    LOCK(cs);
-    if (auto it = mapSpentInserted.find(txhash); it != mapSpentInserted.end()) {
-        for (const auto& key : (*it).second) {
-            mapSpent.erase(key);
+    AssertLockHeld(cs);
+    if (mapSpent.empty()) return;
+    const uint256& txhash = tx.GetHash();
+    for (const auto& input : tx.vin) {
+        if (auto it = mapSpent.find(input.prevout); it != mapSpent.end() && it->second.m_tx_hash == txhash) {
+            mapSpent.erase(it);
         }
-        mapSpentInserted.erase(it);
     }
 }
 
+namespace {
+/** Kinds of ProTx properties which must be unique across the mempool */
+enum class ProTxProperty : uint8_t {
+    Address,
+    OwnerKeyID,
+    OperatorKey,
+    PlatformNodeID,
+    Collateral,
+};
+
+template <typename T>
+uint256 GetProTxPropertyHash(ProTxProperty property, const T& v)
+{
+    // Tagged with the property type so that e.g. a key ID can't collide with a platform node ID,
+    // NetInfoEntry always serializes its address as ADDRv2 so nothing gets truncated
+    CHashWriter hw(SER_GETHASH, PROTOCOL_VERSION);
+    hw << static_cast<uint8_t>(property) << v;
+    return hw.GetHash();
+}
+
+/**
+ * The hashes of all unique properties a ProTx claims, std::nullopt if its payload can't be
+ * decoded. Empty for transactions that don't claim any.
+ */
+std::optional<std::vector<uint256>> GetProTxPropertyHashes(const CTransaction& tx)
+{
+    std::vector<uint256> ret;
+    if (tx.nType == TRANSACTION_PROVIDER_REGISTER) {
+        const auto opt_proTx = GetTxPayload<CProRegTx>(tx);
+        if (!opt_proTx) return std::nullopt;
+        for (const auto& entry : opt_proTx->netInfo->GetEntries()) {
+            ret.emplace_back(GetProTxPropertyHash(ProTxProperty::Address, entry));
+        }
+        ret.emplace_back(GetProTxPropertyHash(ProTxProperty::OwnerKeyID, opt_proTx->keyIDOwner));
+        ret.emplace_back(GetProTxPropertyHash(ProTxProperty::OperatorKey, opt_proTx->pubKeyOperator.GetHash()));
+        if (opt_proTx->nType == MnType::Evo && !opt_proTx->platformNodeID.IsNull()) {
+            ret.emplace_back(GetProTxPropertyHash(ProTxProperty::PlatformNodeID, opt_proTx->platformNodeID));
+        }
+        if (!opt_proTx->collateralOutpoint.hash.IsNull()) {
+            ret.emplace_back(GetProTxPropertyHash(ProTxProperty::Collateral, opt_proTx->collateralOutpoint));
+        } else {
+            ret.emplace_back(GetProTxPropertyHash(ProTxProperty::Collateral, COutPoint(tx.GetHash(), opt_proTx->collateralOutpoint.n)));
+        }
+    } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_SERVICE) {
+        const auto opt_proTx = GetTxPayload<CProUpServTx>(tx);
+        if (!opt_proTx) return std::nullopt;
+        for (const auto& entry : opt_proTx->netInfo->GetEntries()) {
+            ret.emplace_back(GetProTxPropertyHash(ProTxProperty::Address, entry));
+        }
+        if (opt_proTx->nType == MnType::Evo && !opt_proTx->platformNodeID.IsNull()) {
+            ret.emplace_back(GetProTxPropertyHash(ProTxProperty::PlatformNodeID, opt_proTx->platformNodeID));
+        }
+    } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REGISTRAR) {
+        const auto opt_proTx = GetTxPayload<CProUpRegTx>(tx);
+        if (!opt_proTx) return std::nullopt;
+        ret.emplace_back(GetProTxPropertyHash(ProTxProperty::OperatorKey, opt_proTx->pubKeyOperator.GetHash()));
+    }
+    return ret;
+}
+} // anonymous namespace
+
 void CTxMemPool::addUncheckedProTx(CDeterministicMNManager& dmnman, indexed_transaction_set::iterator& newit,
                                    const CTransaction& tx)
 {
     const uint256 tx_hash{tx.GetHash()};
+    const auto property_hashes{*Assert(GetProTxPropertyHashes(tx))};
+    for (const auto& property_hash : property_hashes) {
+        mapProTxProperties.emplace(property_hash, tx_hash);
+    }
+
     if (tx.nType == TRANSACTION_PROVIDER_REGISTER) {
         auto proTx = *Assert(GetTxPayload<CProRegTx>(tx));
         if (!proTx.collateralOutpoint.hash.IsNull()) {
             mapProTxRefs.emplace(tx_hash, proTx.collateralOutpoint.hash);
         }
-        for (const auto& entry : proTx.netInfo->GetEntries()) {
-            mapProTxAddresses.emplace(entry, tx_hash);
-        }
-        mapProTxPubKeyIDs.emplace(proTx.keyIDOwner, tx_hash);
-        mapProTxBlsPubKeyHashes.emplace(proTx.pubKeyOperator.GetHash(), tx_hash);
-        if (proTx.nType == MnType::Evo && !proTx.platformNodeID.IsNull()) {
-            mapProTxPlatformNodeIDs.emplace(proTx.platformNodeID, tx_hash);
-        }
-        if (!proTx.collateralOutpoint.hash.IsNull()) {
-            mapProTxCollaterals.emplace(proTx.collateralOutpoint, tx_hash);
-        } else {
-            mapProTxCollaterals.emplace(COutPoint(tx_hash, proTx.collateralOutpoint.n), tx_hash);
-        }
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_SERVICE) {
         auto proTx = *Assert(GetTxPayload<CProUpServTx>(tx));
         mapProTxRefs.emplace(proTx.proTxHash, tx_hash);
-        for (const auto& entry : proTx.netInfo->GetEntries()) {
-            mapProTxAddresses.emplace(entry, tx_hash);
-        }
-        if (proTx.nType == MnType::Evo && !proTx.platformNodeID.IsNull()) {
-            mapProTxPlatformNodeIDs.emplace(proTx.platformNodeID, tx_hash);
-        }
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REGISTRAR) {
         auto proTx = *Assert(GetTxPayload<CProUpRegTx>(tx));
         mapProTxRefs.emplace(proTx.proTxHash, tx_hash);
-        mapProTxBlsPubKeyHashes.emplace(proTx.pubKeyOperator.GetHash(), tx_hash);
         auto dmn = Assert(dmnman.GetListAtChainTip().GetMN(proTx.proTxHash));
         newit->validForProTxKey = ::SerializeHash(dmn->pdmnState->pubKeyOperator);
         if (dmn->pdmnState->pubKeyOperator != proTx.pubKeyOperator) {
@@ -751,11 +805,11 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     m_total_fee -= it->GetFee();
     cachedInnerUsage -= it->DynamicMemoryUsage();
     cachedInnerUsage -= memusage::DynamicUsage(it->GetMemPoolParentsConst()) + memusage::DynamicUsage(it->GetMemPoolChildrenConst());
+    removeAddressIndex(*it);
+    removeSpentIndex(it->GetTx());
     mapTx.erase(it);
     nTransactionsUpdated++;
     if (minerPolicyEstimator) {minerPolicyEstimator->removeTx(hash, false);}
-    removeAddressIndex(hash);
-    removeSpentIndex(hash);
 }
 
 void CTxMemPool::removeUncheckedProTx(const CTransaction& tx)
@@ -772,34 +826,24 @@ void CTxMemPool::removeUncheckedProTx(const CTransaction& tx)
     };
 
     const uint256 tx_hash{tx.GetHash()};
+    const auto property_hashes{*Assert(GetProTxPropertyHashes(tx))};
+    for (const auto& property_hash : property_hashes) {
+        if (auto it = mapProTxProperties.find(property_hash); it != mapProTxProperties.end() && it->second == tx_hash) {
+            mapProTxProperties.erase(it);
+        }
+    }
+
     if (tx.nType == TRANSACTION_PROVIDER_REGISTER) {
         auto proTx = *Assert(GetTxPayload<CProRegTx>(tx));
         if (!proTx.collateralOutpoint.IsNull()) {
             eraseProTxRef(tx_hash, proTx.collateralOutpoint.hash);
         }
-        for (const auto& entry : proTx.netInfo->GetEntries()) {
-            mapProTxAddresses.erase(entry);
-        }
-        mapProTxPubKeyIDs.erase(proTx.keyIDOwner);
-        mapProTxBlsPubKeyHashes.erase(proTx.pubKeyOperator.GetHash());
-        if (proTx.nType == MnType::Evo && !proTx.platformNodeID.IsNull()) {
-            mapProTxPlatformNodeIDs.erase(proTx.platformNodeID);
-        }
-        mapProTxCollaterals.erase(proTx.collateralOutpoint);
-        mapProTxCollaterals.erase(COutPoint(tx_hash, proTx.collateralOutpoint.n));
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_SERVICE) {
         auto proTx = *Assert(GetTxPayload<CProUpServTx>(tx));
         eraseProTxRef(proTx.proTxHash, tx_hash);
-        for (const auto& entry : proTx.netInfo->GetEntries()) {
-            mapProTxAddresses.erase(entry);
-        }
-        if (proTx.nType == MnType::Evo && !proTx.platformNodeID.IsNull()) {
-            mapProTxPlatformNodeIDs.erase(proTx.platformNodeID);
-        }
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REGISTRAR) {
         auto proTx = *Assert(GetTxPayload<CProUpRegTx>(tx));
         eraseProTxRef(proTx.proTxHash, tx_hash);
-        mapProTxBlsPubKeyHashes.erase(proTx.pubKeyOperator.GetHash());
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REVOKE) {
         auto proTx = *Assert(GetTxPayload<CProUpRevTx>(tx));
         eraseProTxRef(proTx.proTxHash, tx_hash);
@@ -922,46 +966,6 @@ void CTxMemPool::removeConflicts(const CTransaction &tx)
     }
 }
 
-void CTxMemPool::removeProTxPubKeyConflicts(const CTransaction &tx, const CKeyID &keyId)
-{
-    if (mapProTxPubKeyIDs.count(keyId)) {
-        uint256 conflictHash = mapProTxPubKeyIDs[keyId];
-        if (conflictHash != tx.GetHash() && mapTx.count(conflictHash)) {
-            removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
-        }
-    }
-}
-
-void CTxMemPool::removeProTxPubKeyConflicts(const CTransaction &tx, const CBLSLazyPublicKey &pubKey)
-{
-    if (mapProTxBlsPubKeyHashes.count(pubKey.GetHash())) {
-        uint256 conflictHash = mapProTxBlsPubKeyHashes[pubKey.GetHash()];
-        if (conflictHash != tx.GetHash() && mapTx.count(conflictHash)) {
-            removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
-        }
-    }
-}
-
-void CTxMemPool::removeProTxPlatformNodeIDConflicts(const CTransaction &tx, const uint160 &platformNodeID)
-{
-    if (mapProTxPlatformNodeIDs.count(platformNodeID)) {
-        uint256 conflictHash = mapProTxPlatformNodeIDs[platformNodeID];
-        if (conflictHash != tx.GetHash() && mapTx.count(conflictHash)) {
-            removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
-        }
-    }
-}
-
-void CTxMemPool::removeProTxCollateralConflicts(const CTransaction &tx, const COutPoint &collateralOutpoint)
-{
-    if (mapProTxCollaterals.count(collateralOutpoint)) {
-        uint256 conflictHash = mapProTxCollaterals[collateralOutpoint];
-        if (conflictHash != tx.GetHash() && mapTx.count(conflictHash)) {
-            removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
-        }
-    }
-}
-
 void CTxMemPool::removeProTxSpentCollateralConflicts(const CTransaction &tx)
 {
     auto dmnman = Assert(m_dmnman.load(std::memory_order_acquire));
@@ -988,8 +992,8 @@ void CTxMemPool::removeProTxSpentCollateralConflicts(const CTransaction &tx)
     };
     auto mnList = dmnman->GetListAtChainTip();
     for (const auto& in : tx.vin) {
-        auto collateralIt = mapProTxCollaterals.find(in.prevout);
-        if (collateralIt != mapProTxCollaterals.end()) {
+        auto collateralIt = mapProTxProperties.find(GetProTxPropertyHash(ProTxProperty::Collateral, in.prevout));
+        if (collateralIt != mapProTxProperties.end()) {
             // These are not yet mined ProRegTxs
             removeSpentCollateralConflict(collateralIt->second);
         }
@@ -1024,59 +1028,26 @@ void CTxMemPool::removeProTxConflicts(const CTransaction &tx)
     removeProTxSpentCollateralConflicts(tx);
 
     const uint256 tx_hash{tx.GetHash()};
-    if (tx.nType == TRANSACTION_PROVIDER_REGISTER) {
-        const auto opt_proTx = GetTxPayload<CProRegTx>(tx);
-        if (!opt_proTx) {
-            LogPrint(BCLog::MEMPOOL, "%s: ERROR: Invalid transaction payload, tx: %s\n", __func__, tx_hash.ToString());
-            return;
-        }
-        auto& proTx = *opt_proTx;
-
-        for (const auto& entry : proTx.netInfo->GetEntries()) {
-            if (mapProTxAddresses.count(entry)) {
-                uint256 conflictHash = mapProTxAddresses[entry];
-                if (conflictHash != tx_hash && mapTx.count(conflictHash)) {
-                    removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
-                }
-            }
-        }
-        removeProTxPubKeyConflicts(tx, proTx.keyIDOwner);
-        removeProTxPubKeyConflicts(tx, proTx.pubKeyOperator);
-        if (proTx.nType == MnType::Evo && !proTx.platformNodeID.IsNull()) {
-            removeProTxPlatformNodeIDConflicts(tx, proTx.platformNodeID);
-        }
-        if (!proTx.collateralOutpoint.hash.IsNull()) {
-            removeProTxCollateralConflicts(tx, proTx.collateralOutpoint);
-        } else {
-            removeProTxCollateralConflicts(tx, COutPoint(tx_hash, proTx.collateralOutpoint.n));
-        }
-    } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_SERVICE) {
-        const auto opt_proTx = GetTxPayload<CProUpServTx>(tx);
-        if (!opt_proTx) {
-            LogPrint(BCLog::MEMPOOL, "%s: ERROR: Invalid transaction payload, tx: %s\n", __func__, tx_hash.ToString());
-            return;
-        }
+    const auto property_hashes = GetProTxPropertyHashes(tx);
+    if (!property_hashes) {
+        LogPrint(BCLog::MEMPOOL, "%s: ERROR: Invalid transaction payload, tx: %s\n", __func__, tx_hash.ToString());
+        return;
+    }
 
-        for (const auto& entry : opt_proTx->netInfo->GetEntries()) {
-            if (mapProTxAddresses.count(entry)) {
-                uint256 conflictHash = mapProTxAddresses[entry];
-                if (conflictHash != tx_hash && mapTx.count(conflictHash)) {
-                    removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
-                }
-            }
-        }
-        if (opt_proTx->nType == MnType::Evo && !opt_proTx->platformNodeID.IsNull()) {
-            removeProTxPlatformNodeIDConflicts(tx, opt_proTx->platformNodeID);
+    for (const auto& property_hash : *property_hashes) {
+        auto it = mapProTxProperties.find(property_hash);
+        if (it == mapProTxProperties.end() || it->second == tx_hash) {
+            continue;
         }
-    } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REGISTRAR) {
-        const auto opt_proTx = GetTxPayload<CProUpRegTx>(tx);
-        if (!opt_proTx) {
-            LogPrint(BCLog::MEMPOOL, "%s: ERROR: Invalid transaction payload, tx: %s\n", __func__, tx_hash.ToString());
-            return;
+        if (auto conflictIt = mapTx.find(it->second); conflictIt != mapTx.end()) {
+            removeRecursive(conflictIt->GetTx(), MemPoolRemovalReason::CONFLICT);
         }
+    }
 
-        removeProTxPubKeyConflicts(tx, opt_proTx->pubKeyOperator);
-        removeProTxKeyChangedConflicts(tx, opt_proTx->proTxHash, ::SerializeHash(opt_proTx->pubKeyOperator));
+    if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REGISTRAR) {
+        // The payload was already decoded by GetProTxPropertyHashes()
+        const auto proTx = *Assert(GetTxPayload<CProUpRegTx>(tx));
+        removeProTxKeyChangedConflicts(tx, proTx.proTxHash, ::SerializeHash(proTx.pubKeyOperator));
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REVOKE) {
         const auto opt_proTx = GetTxPayload<CProUpRevTx>(tx);
         if (!opt_proTx) {
@@ -1147,9 +1118,9 @@ void CTxMemPool::_clear()
     vTxHashes.clear();
     mapTx.clear();
     mapNextTx.clear();
-    mapProTxAddresses.clear();
-    mapProTxPubKeyIDs.clear();
-    mapProTxPlatformNodeIDs.clear();
+    mapAddress.clear();
+    mapSpent.clear();
+    mapProTxProperties.clear();
     totalTxSize = 0;
     m_total_fee = 0;
     cachedInnerUsage = 0;
@@ -1185,7 +1156,7 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
     for (const auto& it : GetSortedDepthAndScore()) {
         checkTotal += it->GetTxSize();
         check_total_fee += it->GetFee();
-        innerUsage += it->DynamicMemoryUsage();
+        innerUsage += it->DynamicMemoryUsage() + memusage::DynamicUsage(it->m_address_index_keys);
         const CTransaction& tx = it->GetTx();
         innerUsage += memusage::DynamicUsage(it->GetMemPoolParentsConst()) + memusage::DynamicUsage(it->GetMemPoolChildrenConst());
         CTxMemPoolEntry::Parents setParentCheck;
@@ -1399,22 +1370,13 @@ bool CTxMemPool::existsProviderTxConflict(const CTransaction &tx) const {
             return true; // i.e. can't decode payload == conflict
         }
         auto& proTx = *opt_proTx;
-        for (const auto& entry : proTx.netInfo->GetEntries()) {
-            if (mapProTxAddresses.count(entry)) {
+        const auto property_hashes{*Assert(GetProTxPropertyHashes(tx))};
+        for (const auto& property_hash : property_hashes) {
+            if (mapProTxProperties.count(property_hash)) {
                 return true;
             }
         }
-        if (mapProTxPubKeyIDs.count(proTx.keyIDOwner) || mapProTxBlsPubKeyHashes.count(proTx.pubKeyOperator.GetHash())) {
-            return true;
-        }
-        if (proTx.nType == MnType::Evo && !proTx.platformNodeID.IsNull() && mapProTxPlatformNodeIDs.count(proTx.platformNodeID)) {
-            return true;
-        }
         if (!proTx.collateralOutpoint.hash.IsNull()) {
-            if (mapProTxCollaterals.count(proTx.collateralOutpoint)) {
-                // there is another ProRegTx that refers to the same collateral
-                return true;
-            }
             if (mapNextTx.count(proTx.collateralOutpoint)) {
                 // there is another tx that spends the collateral
                 return true;
@@ -1427,15 +1389,10 @@ bool CTxMemPool::existsProviderTxConflict(const CTransaction &tx) const {
             LogPrint(BCLog::MEMPOOL, "%s: ERROR: Invalid transaction payload, tx: %s\n", __func__, tx_hash.ToString());
             return true; // i.e. can't decode payload == conflict
         }
-        for (const auto& entry : opt_proTx->netInfo->GetEntries()) {
-            auto it = mapProTxAddresses.find(entry);
-            if (it != mapProTxAddresses.end() && it->second != opt_proTx->proTxHash) {
-                return true;
-            }
-        }
-        if (opt_proTx->nType == MnType::Evo && !opt_proTx->platformNodeID.IsNull()) {
-            auto it = mapProTxPlatformNodeIDs.find(opt_proTx->platformNodeID);
-            if (it != mapProTxPlatformNodeIDs.end() && it->second != opt_proTx->proTxHash) {
+        const auto property_hashes{*Assert(GetProTxPropertyHashes(tx))};
+        for (const auto& property_hash : property_hashes) {
+            auto it = mapProTxProperties.find(property_hash);
+            if (it != mapProTxProperties.end() && it->second != opt_proTx->proTxHash) {
                 return true;
             }
         }
@@ -1460,8 +1417,8 @@ bool CTxMemPool::existsProviderTxConflict(const CTransaction &tx) const {
             }
         }
 
-        auto it = mapProTxBlsPubKeyHashes.find(proTx.pubKeyOperator.GetHash());
-        return it != mapProTxBlsPubKeyHashes.end() && it->second != proTx.proTxHash;
+        auto it = mapProTxProperties.find(GetProTxPropertyHash(ProTxProperty::OperatorKey, proTx.pubKeyOperator.GetHash()));
+        return it != mapProTxProperties.end() && it->second != proTx.proTxHash;
     } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REVOKE) {
         const auto opt_proTx = GetTxPayload<CProUpRevTx>(tx);
         if (!opt_proTx) {
@@ -11,12 +11,12 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <coins.h>
 #include <consensus/amount.h>
-#include <evo/netinfo.h>
 #include <gsl/pointers.h>
 #include <index/addressindex_types.h>
 #include <index/spentindex_types.h>
@@ -27,6 +27,8 @@
 #include <primitives/transaction.h>
 #include <pubkey.h>
 #include <random.h>
+#include <saltedhasher.h>
+#include <support/allocators/pool.h>
 #include <sync.h>
 #include <util/epochguard.h>
 #include <util/hasher.h>
@@ -44,11 +46,6 @@ class CChain;
 class CChainState;
 extern RecursiveMutex cs_main; // NOLINT(readability-redundant-declaration)
 
-// Forward declaration for CBLSLazyPublicKey:
-template<typename T> class CBLSLazyWrapper;
-class CBLSPublicKey;
-using CBLSLazyPublicKey = CBLSLazyWrapper<CBLSPublicKey>;
-
 /** Fake height value used in Coin to signify they are only in the memory pool (since 0.8) */
 static const uint32_t MEMPOOL_HEIGHT = 0x7FFFFFFF;
 
@@ -83,6 +80,25 @@ struct CompareIteratorByHash {
         return a->GetTx().GetHash() < b->GetTx().GetHash();
     }
 };
+/** An address as tracked by the mempool address index */
+using CMempoolAddress = std::pair<AddressType, uint160>;
+
+class SaltedMempoolAddressHasher
+{
+private:
+    /** Salt */
+    const uint64_t k0{GetRand<uint64_t>()}, k1{GetRand<uint64_t>()};
+
+public:
+    size_t operator()(const CMempoolAddress& address) const noexcept
+    {
+        return CSipHasher(k0, k1)
+            .Write(static_cast<uint64_t>(address.first))
+            .Write(address.second.begin(), address.second.size())
+            .Finalize();
+    }
+};
+
 /** \class CTxMemPoolEntry
  *
  * CTxMemPoolEntry stores data about the corresponding transaction, as well
@@ -187,6 +203,9 @@ public:
     // If this is a proTx, this will be the hash of the key for which this ProTx was valid
     mutable uint256 validForProTxKey;
     mutable bool isKeyChangeProTx{false};
+    // Addresses this transaction has deltas for in the mempool address index, accounted in
+    // CTxMemPool::cachedInnerUsage while the transaction is indexed
+    mutable std::vector<CMempoolAddress> m_address_index_keys;
     mutable Epoch::Marker m_epoch_marker; //!< epoch when last touched, useful for graph algorithms
 };
 
@@ -532,17 +551,37 @@ public:
 private:
     typedef std::map<txiter, setEntries, CompareIteratorByHash> cacheMap;
 
-    std::map<CMempoolAddressDeltaKey, CMempoolAddressDelta, CMempoolAddressDeltaKeyCompare> mapAddress;
-    std::map<uint256, std::vector<CMempoolAddressDeltaKey>> mapAddressInserted;
-    std::map<CSpentIndexKey, CSpentIndexValue, CSpentIndexKeyCompare> mapSpent;
-    std::map<uint256, std::vector<CSpentIndexKey>> mapSpentInserted;
-
-    std::multimap<uint256, uint256> mapProTxRefs; // proTxHash -> transaction (all TXs that refer to an existing proTx)
-    std::map<NetInfoEntry, uint256> mapProTxAddresses;
-    std::map<CKeyID, uint256> mapProTxPubKeyIDs;
-    std::map<uint256, uint256> mapProTxBlsPubKeyHashes;
-    std::map<uint160, uint256> mapProTxPlatformNodeIDs;
-    std::map<COutPoint, uint256> mapProTxCollaterals;
+    /**
+     * Address index, deltas are bucketed per address and keyed by txid within the bucket, so looking
+     * up an address is O(1) plus the number of its deltas. The addresses of a transaction are linked
+     * from its mempool entry (CTxMemPoolEntry::m_address_index_keys), so removing it is O(1) per address
+     * it touched, no matter how many other transactions the address has in the mempool.
+     * See CCoinsMap for the PoolAllocator block size.
+     */
+    using AddressDeltaBucket = Uint256HashMap<std::vector<CMempoolAddressDeltaEntry>>;
+    using AddressDeltaMap = std::unordered_map<CMempoolAddress,
+                                               AddressDeltaBucket,
+                                               SaltedMempoolAddressHasher,
+                                               std::equal_to<CMempoolAddress>,
+                                               PoolAllocator<std::pair<const CMempoolAddress, AddressDeltaBucket>,
+                                                             sizeof(std::pair<const CMempoolAddress, AddressDeltaBucket>) + sizeof(void*) * 4>>;
+    /** Spent index, keyed by the spent outpoint. Entries are found again on removal from the inputs of the spending transaction. */
+    using SpentMap = std::unordered_map<COutPoint,
+                                        CSpentIndexValue,
+                                        SaltedOutpointHasher,
+                                        std::equal_to<COutPoint>,
+                                        PoolAllocator<std::pair<const COutPoint, CSpentIndexValue>,
+                                                      sizeof(std::pair<const COutPoint, CSpentIndexValue>) + sizeof(void*) * 4>>;
+
+    AddressDeltaMap::allocator_type::ResourceType m_address_memory_resource{};
+    AddressDeltaMap mapAddress GUARDED_BY(cs){0, AddressDeltaMap::hasher{}, AddressDeltaMap::key_equal{}, &m_address_memory_resource};
+    SpentMap::allocator_type::ResourceType m_spent_memory_resource{};
+    SpentMap mapSpent GUARDED_BY(cs){0, SpentMap::hasher{}, SpentMap::key_equal{}, &m_spent_memory_resource};
+
+    std::unordered_multimap<uint256, uint256, StaticSaltedHasher> mapProTxRefs; // proTxHash -> transaction (all TXs that refer to an existing proTx)
+    // Unique ProTx properties (addresses, owner and operator keys, platform node IDs and collaterals),
+    // keyed by their typed property hash -> transaction which claims the property
+    Uint256HashMap<uint256> mapProTxProperties;
     std::map<uint256, int /* expiry height */> mapAssetUnlockExpiry; // tx hash -> height
 
     void UpdateParent(txiter entry, txiter parent, bool add) EXCLUSIVE_LOCKS_REQUIRED(cs);
@@ -624,11 +663,11 @@ public:
     void addAddressIndex(const CTxMemPoolEntry& entry, const CCoinsViewCache& view);
     void getAddressIndex(const std::vector<CMempoolAddressDeltaKey>& addresses,
                          std::vector<CMempoolAddressDeltaEntry>& results) const;
-    void removeAddressIndex(const uint256 txhash);
+    void removeAddressIndex(const CTxMemPoolEntry& entry) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     void addSpentIndex(const CTxMemPoolEntry& entry, const CCoinsViewCache& view);
     bool getSpentIndex(const CSpentIndexKey& key, CSpentIndexValue& value) const;
-    void removeSpentIndex(const uint256 txhash);
+    void removeSpentIndex(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     void removeRecursive(const CTransaction& tx, MemPoolRemovalReason reason) EXCLUSIVE_LOCKS_REQUIRED(cs);
     /** After reorg, filter the entries that would no longer be valid in the next block, and update
@@ -640,10 +679,6 @@ public:
      * */
     void removeForReorg(CChain& chain, std::function<bool(txiter)> filter_final_and_mature) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     void removeConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void removeProTxPubKeyConflicts(const CTransaction &tx, const CKeyID &keyId) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void removeProTxPubKeyConflicts(const CTransaction &tx, const CBLSLazyPublicKey &pubKey) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void removeProTxPlatformNodeIDConflicts(const CTransaction &tx, const uint160 &platformNodeID) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void removeProTxCollateralConflicts(const CTransaction &tx, const COutPoint &collateralOutpoint) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void removeProTxSpentCollateralConflicts(const CTransaction &tx) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void removeProTxKeyChangedConflicts(const CTransaction &tx, const uint256& proTxHash, const uint256& newKeyHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void removeProTxConflicts(const CTransaction &tx) EXCLUSIVE_LOCKS_REQUIRED(cs);
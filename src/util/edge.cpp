@@ -15,6 +15,269 @@
 #include <sys/event.h>
 #endif
 
+#ifdef USE_IO_URING
+#include <sync.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+/* Submission queue size, registrations are queued until the next wait and the queue is flushed early when full */
+constexpr unsigned int IO_URING_ENTRIES{1024};
+/* Every socket has a multishot poll outstanding, leave room for several completions per socket */
+constexpr unsigned int IO_URING_CQ_ENTRIES{IO_URING_ENTRIES * 4};
+
+/* Tags stored in the lowest byte of user_data, followed by the registration generation and the entity */
+constexpr uint64_t IO_URING_TAG_POLL{1};
+constexpr uint64_t IO_URING_TAG_REMOVE{2};
+constexpr uint32_t IO_URING_GENERATION_MASK{0xffffff};
+
+constexpr uint64_t MakeUserData(int entity, uint32_t generation, uint64_t tag)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(entity)) << 32) | (static_cast<uint64_t>(generation & IO_URING_GENERATION_MASK) << 8) | tag;
+}
+} // namespace
+
+struct EdgeTriggeredEvents::IOUring
+{
+    Mutex m_mutex;
+
+    unsigned int m_sq_entries{0};
+    size_t m_sq_ring_size{0};
+    size_t m_cq_ring_size{0};
+    size_t m_sqes_size{0};
+    void* m_sq_ring{MAP_FAILED};
+    void* m_cq_ring{MAP_FAILED};
+    io_uring_sqe* m_sqes{static_cast<io_uring_sqe*>(MAP_FAILED)};
+
+    unsigned* m_sq_head{nullptr};
+    unsigned* m_sq_tail{nullptr};
+    unsigned* m_sq_mask{nullptr};
+    unsigned* m_sq_array{nullptr};
+    unsigned* m_cq_head{nullptr};
+    unsigned* m_cq_tail{nullptr};
+    unsigned* m_cq_mask{nullptr};
+    io_uring_cqe* m_cqes{nullptr};
+
+    struct Poll {
+        uint32_t mask;
+        /* Tells completions of this registration apart from late ones of an earlier registration of the same
+         * descriptor, which may have been closed and reused since */
+        uint32_t generation;
+    };
+    /* Every registered entity, used to re-arm multishot polls the kernel terminated */
+    std::unordered_map<int, Poll> m_polls GUARDED_BY(m_mutex);
+    uint32_t m_next_generation GUARDED_BY(m_mutex){0};
+
+    ~IOUring()
+    {
+        if (m_sqes != MAP_FAILED) munmap(m_sqes, m_sqes_size);
+        if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring) munmap(m_cq_ring, m_cq_ring_size);
+        if (m_sq_ring != MAP_FAILED) munmap(m_sq_ring, m_sq_ring_size);
+    }
+
+    /* Get an empty submission queue entry, flushing the queue to the kernel if it is full */
+    io_uring_sqe* GetSQE(int ring_fd) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        const unsigned tail{*m_sq_tail};
+        if (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries) {
+            if (!Submit(ring_fd) || tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries) {
+                return nullptr;
+            }
+        }
+        const unsigned idx{tail & *m_sq_mask};
+        io_uring_sqe* sqe{&m_sqes[idx]};
+        std::memset(sqe, 0, sizeof(*sqe));
+        m_sq_array[idx] = idx;
+        return sqe;
+    }
+
+    /* Queue a multishot poll for a registration, it is submitted with the next wait */
+    bool QueuePoll(int ring_fd, int entity, const Poll& poll) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        io_uring_sqe* sqe{GetSQE(ring_fd)};
+        if (sqe == nullptr) return false;
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = entity;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        sqe->poll32_events = (poll.mask << 16) | (poll.mask >> 16);
+#else
+        sqe->poll32_events = poll.mask;
+#endif
+        sqe->len = IORING_POLL_ADD_MULTI;
+        sqe->user_data = MakeUserData(entity, poll.generation, IO_URING_TAG_POLL);
+        PublishSQE();
+        return true;
+    }
+
+    /* Make the entry returned by the last GetSQE() visible to the kernel */
+    void PublishSQE() EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        __atomic_store_n(m_sq_tail, *m_sq_tail + 1, __ATOMIC_RELEASE);
+    }
+
+    unsigned Unsubmitted() const EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        return *m_sq_tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE);
+    }
+
+    /* Hand all queued entries to the kernel without waiting for completions */
+    bool Submit(int ring_fd) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        const unsigned to_submit{Unsubmitted()};
+        if (to_submit == 0) return true;
+        if (syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, 0, nullptr, 0) < 0) {
+            LogPrintf("Failed to submit io_uring entries (io_uring_enter returned error %s)\n",
+                      NetworkErrorString(WSAGetLastError()));
+            return false;
+        }
+        return true;
+    }
+};
+
+bool EdgeTriggeredEvents::InitIOUring()
+{
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = IO_URING_CQ_ENTRIES;
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, IO_URING_ENTRIES, &params));
+    if (m_fd == -1) {
+        LogPrintf("Unable to initialize EdgeTriggeredEvents, io_uring_setup returned -1 with error %s\n",
+                  NetworkErrorString(WSAGetLastError()));
+        return false;
+    }
+    if (!(params.features & IORING_FEAT_EXT_ARG)) {
+        LogPrintf("Unable to initialize EdgeTriggeredEvents, kernel lacks io_uring timed waits (Linux 5.11+ required)\n");
+        return false;
+    }
+
+    auto ring = std::make_unique<IOUring>();
+    ring->m_sq_entries = params.sq_entries;
+    ring->m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap{(params.features & IORING_FEAT_SINGLE_MMAP) != 0};
+    if (single_mmap) {
+        ring->m_sq_ring_size = ring->m_cq_ring_size = std::max(ring->m_sq_ring_size, ring->m_cq_ring_size);
+    }
+    ring->m_sq_ring = mmap(nullptr, ring->m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                           IORING_OFF_SQ_RING);
+    ring->m_cq_ring = single_mmap ? ring->m_sq_ring
+                                  : mmap(nullptr, ring->m_cq_ring_size, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+    ring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    ring->m_sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring->m_sqes_size, PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+    if (ring->m_sq_ring == MAP_FAILED || ring->m_cq_ring == MAP_FAILED || ring->m_sqes == MAP_FAILED) {
+        LogPrintf("Unable to initialize EdgeTriggeredEvents, failed to map io_uring rings with error %s\n",
+                  NetworkErrorString(WSAGetLastError()));
+        return false;
+    }
+
+    auto* sq{static_cast<char*>(ring->m_sq_ring)};
+    ring->m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    ring->m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    ring->m_sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    ring->m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq{static_cast<char*>(ring->m_cq_ring)};
+    ring->m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    ring->m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    ring->m_cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    ring->m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    m_io_uring = std::move(ring);
+    return true;
+}
+
+bool EdgeTriggeredEvents::AddPoll(int entity, uint32_t poll_mask) const
+{
+    assert(m_io_uring);
+    auto& ring{*m_io_uring};
+    LOCK(ring.m_mutex);
+    // Like EEXIST for epoll, replacing the registration would leave the earlier poll armed in the kernel
+    if (ring.m_polls.count(entity)) return false;
+    const IOUring::Poll poll{poll_mask, ring.m_next_generation++ & IO_URING_GENERATION_MASK};
+    // Not submitted yet, registrations are batched into the next WaitIOUring() call
+    if (!ring.QueuePoll(m_fd, entity, poll)) return false;
+    ring.m_polls[entity] = poll;
+    return true;
+}
+
+bool EdgeTriggeredEvents::RemovePoll(int entity) const
+{
+    assert(m_io_uring);
+    auto& ring{*m_io_uring};
+    LOCK(ring.m_mutex);
+    const auto it{ring.m_polls.find(entity)};
+    if (it == ring.m_polls.end()) return false;
+    const uint32_t generation{it->second.generation};
+    ring.m_polls.erase(it);
+    io_uring_sqe* sqe{ring.GetSQE(m_fd)};
+    if (sqe == nullptr) return false;
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = MakeUserData(entity, generation, IO_URING_TAG_POLL);
+    sqe->user_data = MakeUserData(entity, generation, IO_URING_TAG_REMOVE);
+    ring.PublishSQE();
+    // The pending poll holds a reference to the file, submit right away so that it is released on close
+    // and a socket reusing this descriptor can't be affected by a late removal
+    return ring.Submit(m_fd);
+}
+
+bool EdgeTriggeredEvents::WaitIOUring(std::chrono::milliseconds timeout, std::vector<std::pair<SOCKET, uint32_t>>& events,
+                                      const std::function<void(std::function<void()>&&)>& wrap_func) const
+{
+    assert(m_valid && m_io_uring);
+    auto& ring{*m_io_uring};
+
+    const unsigned to_submit{WITH_LOCK(ring.m_mutex, return ring.Unsubmitted())};
+    __kernel_timespec ts{};
+    ts.tv_sec = count_seconds(std::chrono::duration_cast<std::chrono::seconds>(timeout));
+    ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout % std::chrono::seconds{1}).count();
+    io_uring_getevents_arg arg{};
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+
+    int ret{SOCKET_ERROR};
+    wrap_func([&](){
+        ret = static_cast<int>(syscall(__NR_io_uring_enter, m_fd, to_submit, 1,
+                                       IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+    });
+    if (ret == SOCKET_ERROR && errno != ETIME && errno != EINTR) {
+        return false;
+    }
+
+    events.clear();
+    LOCK(ring.m_mutex);
+    unsigned head{*ring.m_cq_head};
+    const unsigned tail{__atomic_load_n(ring.m_cq_tail, __ATOMIC_ACQUIRE)};
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe{ring.m_cqes[head & *ring.m_cq_mask]};
+        if ((cqe.user_data & 0xff) != IO_URING_TAG_POLL) continue;
+        const int entity{static_cast<int>(cqe.user_data >> 32)};
+        const uint32_t generation{static_cast<uint32_t>(cqe.user_data >> 8) & IO_URING_GENERATION_MASK};
+        // Skip late completions of a removed poll, the descriptor may already belong to a new registration
+        const auto it{ring.m_polls.find(entity)};
+        if (it == ring.m_polls.end() || it->second.generation != generation) continue;
+        if (cqe.res >= 0) {
+            events.emplace_back(static_cast<SOCKET>(entity), static_cast<uint32_t>(cqe.res));
+            // The kernel may end a multishot poll, e.g. when completions overflow; it has to be armed again
+            if (!(cqe.flags & IORING_CQE_F_MORE)) ring.QueuePoll(m_fd, entity, it->second);
+        } else if (cqe.res != -ECANCELED && cqe.res != -ENOENT) {
+            events.emplace_back(static_cast<SOCKET>(entity), static_cast<uint32_t>(POLLERR));
+        }
+    }
+    __atomic_store_n(ring.m_cq_head, head, __ATOMIC_RELEASE);
+
+    return true;
+}
+#endif /* USE_IO_URING */
+
 EdgeTriggeredEvents::EdgeTriggeredEvents(SocketEventsMode events_mode)
     : m_mode(events_mode)
 {
@@ -42,6 +305,17 @@ EdgeTriggeredEvents::EdgeTriggeredEvents(SocketEventsMode events_mode)
         LogPrintf("Attempting to initialize EdgeTriggeredEvents for kqueue without support compiled in!\n");
         return;
 #endif /* USE_KQUEUE */
+    } else if (m_mode == SocketEventsMode::IOUring) {
+#ifdef USE_IO_URING
+        if (!InitIOUring()) {
+            if (m_fd != -1) close(m_fd);
+            m_fd = -1;
+            return;
+        }
+#else
+        LogPrintf("Attempting to initialize EdgeTriggeredEvents for io_uring without support compiled in!\n");
+        return;
+#endif /* USE_IO_URING */
     } else {
         assert(false);
     }
@@ -51,14 +325,18 @@ EdgeTriggeredEvents::EdgeTriggeredEvents(SocketEventsMode events_mode)
 EdgeTriggeredEvents::~EdgeTriggeredEvents()
 {
     if (m_valid) {
-#if defined(USE_KQUEUE) || defined(USE_EPOLL)
+#ifdef USE_IO_URING
+        // Unmap the rings before closing the descriptor they belong to
+        m_io_uring.reset();
+#endif /* USE_IO_URING */
+#if defined(USE_KQUEUE) || defined(USE_EPOLL) || defined(USE_IO_URING)
         if (close(m_fd) != 0) {
             LogPrintf("Destroying EdgeTriggeredEvents instance, close() failed for m_fd = %d with error %s\n", m_fd,
                       NetworkErrorString(WSAGetLastError()));
         }
 #else
         assert(false);
-#endif /* defined(USE_KQUEUE) || defined(USE_EPOLL) */
+#endif /* defined(USE_KQUEUE) || defined(USE_EPOLL) || defined(USE_IO_URING) */
     }
 }
 
@@ -91,6 +369,15 @@ bool EdgeTriggeredEvents::RegisterEntity(int entity, const std::string& entity_n
 #else
         assert(false);
 #endif /* USE_KQUEUE */
+    } else if (m_mode == SocketEventsMode::IOUring) {
+#ifdef USE_IO_URING
+        if (!AddPoll(entity, POLLIN)) {
+            LogPrintf("Failed to add %s to io_uring fd\n", entity_name);
+            return false;
+        }
+#else
+        assert(false);
+#endif /* USE_IO_URING */
     } else {
         assert(false);
     }
@@ -123,6 +410,15 @@ bool EdgeTriggeredEvents::UnregisterEntity(int entity, const std::string& entity
 #else
         assert(false);
 #endif /* USE_KQUEUE */
+    } else if (m_mode == SocketEventsMode::IOUring) {
+#ifdef USE_IO_URING
+        if (!RemovePoll(entity)) {
+            LogPrintf("Failed to remove %s from io_uring fd\n", entity_name);
+            return false;
+        }
+#else
+        assert(false);
+#endif /* USE_IO_URING */
     } else {
         assert(false);
     }
@@ -194,6 +490,15 @@ bool EdgeTriggeredEvents::RegisterEvents(SOCKET socket) const
 #else
         assert(false);
 #endif /* USE_KQUEUE */
+    } else if (m_mode == SocketEventsMode::IOUring) {
+#ifdef USE_IO_URING
+        if (!AddPoll(socket, POLLIN | POLLOUT | POLLERR | POLLHUP)) {
+            LogPrintf("Failed to register events for socket -- io_uring poll for %d is already registered or could not be queued\n", socket);
+            return false;
+        }
+#else
+        assert(false);
+#endif /* USE_IO_URING */
     } else {
         assert(false);
     }
@@ -232,6 +537,15 @@ bool EdgeTriggeredEvents::UnregisterEvents(SOCKET socket) const
 #else
         assert(false);
 #endif /* USE_KQUEUE */
+    } else if (m_mode == SocketEventsMode::IOUring) {
+#ifdef USE_IO_URING
+        if (!RemovePoll(socket)) {
+            LogPrintf("Failed to unregister events for socket -- io_uring poll removal for %d failed\n", socket);
+            return false;
+        }
+#else
+        assert(false);
+#endif /* USE_IO_URING */
     } else {
         assert(false);
     }
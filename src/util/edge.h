@@ -8,14 +8,19 @@
 #include <compat/compat.h>
 
 #include <assert.h>
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 enum class SocketEventsMode : int8_t;
 
 /**
  * A manager for abstracting logic surrounding edge-triggered socket events
- * modes like kqueue and epoll.
+ * modes like kqueue, epoll and io_uring.
  */
 // TODO: simplify this class to 2-3 flags; kick out everything else to Sock/~Sock and inherited classes
 class EdgeTriggeredEvents
@@ -37,6 +42,13 @@ public:
     /* Unregister events for socket */
     bool UnregisterEvents(SOCKET socket) const;
 
+#ifdef USE_IO_URING
+    /* Submit queued registrations and wait for events in a single io_uring_enter() call, reporting the poll(2)
+     * mask of every socket that became ready */
+    bool WaitIOUring(std::chrono::milliseconds timeout, std::vector<std::pair<SOCKET, uint32_t>>& events,
+                     const std::function<void(std::function<void()>&&)>& wrap_func) const;
+#endif /* USE_IO_URING */
+
 private:
     friend class WakeupPipe;
     /* Register wakeup pipe with EdgeTriggeredEvents instance */
@@ -48,6 +60,13 @@ private:
     bool RegisterEntity(int entity, const std::string& entity_name) const;
     bool UnregisterEntity(int entity, const std::string& entity_name) const;
 
+#ifdef USE_IO_URING
+    struct IOUring;
+    bool InitIOUring();
+    bool AddPoll(int entity, uint32_t poll_mask) const;
+    bool RemovePoll(int entity) const;
+#endif /* USE_IO_URING */
+
 private:
     /* Flag set if pipe has been registered with instance */
     bool m_pipe_registered{false};
@@ -57,6 +76,10 @@ private:
     SocketEventsMode m_mode;
     /* File descriptor used to interact with events mode */
     int m_fd{-1};
+#ifdef USE_IO_URING
+    /* Shared submission and completion rings, only set for io_uring */
+    std::unique_ptr<IOUring> m_io_uring;
+#endif /* USE_IO_URING */
 };
 
 #endif // BITCOIN_UTIL_EDGE_H
@@ -6,6 +6,7 @@
 #include <logging.h>
 #include <tinyformat.h>
 #include <util/sock.h>
+#include <util/edge.h>
 #include <util/syserror.h>
 #include <util/system.h>
 #include <util/threadinterrupt.h>
@@ -14,6 +15,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #ifdef USE_EPOLL
 #include <sys/epoll.h>
@@ -23,7 +25,7 @@
 #include <sys/event.h>
 #endif
 
-#ifdef USE_POLL
+#if defined(USE_POLL) || defined(USE_IO_URING)
 #include <poll.h>
 #endif
 
@@ -161,7 +163,7 @@ bool Sock::Wait(std::chrono::milliseconds timeout, Event requested, SocketEvents
 
     // We need to ensure we are only using a level-triggered mode because we are expecting
     // a direct correlation between the events reported and the one socket we are querying
-    if (auto [sem, _, __] = event_params; sem != SocketEventsMode::Poll && sem != SocketEventsMode::Select) {
+    if (const auto sem = event_params.m_event_mode; sem != SocketEventsMode::Poll && sem != SocketEventsMode::Select) {
         // We will use a compatible fallback events mode if we didn't specify a valid option
         event_params = SocketEventsParams{
 #ifdef USE_POLL
@@ -207,6 +209,11 @@ bool Sock::WaitManyInternal(std::chrono::milliseconds timeout, EventsPerSock& ev
             assert(event_params.m_event_fd != INVALID_SOCKET);
             return WaitManyKQueue(timeout, events_per_sock, event_params.m_event_fd, event_params.m_wrap_func);
 #endif /* USE_KQUEUE */
+#ifdef USE_IO_URING
+        case SocketEventsMode::IOUring:
+            assert(event_params.m_edge_trig_events != nullptr);
+            return WaitManyIOUring(timeout, events_per_sock, *event_params.m_edge_trig_events, event_params.m_wrap_func);
+#endif /* USE_IO_URING */
         default:
             assert(false);
     }
@@ -297,6 +304,44 @@ bool Sock::WaitManyKQueue(std::chrono::milliseconds timeout,
 }
 #endif /* USE_KQUEUE */
 
+#ifdef USE_IO_URING
+bool Sock::WaitManyIOUring(std::chrono::milliseconds timeout,
+                           EventsPerSock& events_per_sock,
+                           const EdgeTriggeredEvents& edge_trig_events,
+                           SocketEventsParams::wrap_fn wrap_func)
+{
+    std::vector<std::pair<SOCKET, uint32_t>> events;
+    if (!edge_trig_events.WaitIOUring(timeout, events, wrap_func)) {
+        return false;
+    }
+
+    // Events reported do not correspond to sockets requested in edge-triggered modes, we will clear the
+    // entire map before populating it with our events data.
+    events_per_sock.clear();
+
+    for (const auto& [socket, mask] : events) {
+        Event occurred = 0;
+        if (mask & (POLLERR | POLLHUP)) {
+            occurred |= ERR;
+        } else {
+            if (mask & POLLIN) {
+                occurred |= RECV;
+            }
+            if (mask & POLLOUT) {
+                occurred |= SEND;
+            }
+        }
+        if (auto it = events_per_sock.find(socket); it != events_per_sock.end()) {
+            it->second.occurred |= occurred;
+        } else {
+            events_per_sock.emplace(socket, Sock::Events{/*req=*/RECV | SEND, occurred});
+        }
+    }
+
+    return true;
+}
+#endif /* USE_IO_URING */
+
 #ifdef USE_POLL
 bool Sock::WaitManyPoll(std::chrono::milliseconds timeout,
                         EventsPerSock& events_per_sock,
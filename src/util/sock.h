@@ -15,6 +15,8 @@
 #include <string>
 #include <unordered_map>
 
+class EdgeTriggeredEvents;
+
 #if defined(USE_EPOLL)
 #define DEFAULT_SOCKETEVENTS "epoll"
 #elif defined(USE_KQUEUE)
@@ -38,6 +40,7 @@ enum class SocketEventsMode : int8_t {
     Poll = 1,
     EPoll = 2,
     KQueue = 3,
+    IOUring = 4,
 
     Unknown = -1
 };
@@ -52,10 +55,12 @@ struct SocketEventsParams
     {
         assert(m_event_mode != SocketEventsMode::Unknown);
     }
-    SocketEventsParams(SocketEventsMode event_mode, SOCKET event_fd, wrap_fn wrap_func) :
+    SocketEventsParams(SocketEventsMode event_mode, SOCKET event_fd, wrap_fn wrap_func,
+                       const EdgeTriggeredEvents* edge_trig_events = nullptr) :
         m_event_mode{event_mode},
         m_event_fd{event_fd},
-        m_wrap_func{wrap_func}
+        m_wrap_func{wrap_func},
+        m_edge_trig_events{edge_trig_events}
     {
         assert(m_event_mode != SocketEventsMode::Unknown);
     }
@@ -68,6 +73,8 @@ public:
     SOCKET m_event_fd{INVALID_SOCKET};
     /* Function that wraps itself around WakeMany()'s API call */
     wrap_fn m_wrap_func{[](std::function<void()>&& func){func();}};
+    /* Instance owning the submission and completion rings for SEMs that need more than a file descriptor */
+    const EdgeTriggeredEvents* m_edge_trig_events{nullptr};
 };
 
 /* Converts SocketEventsMode value to string with additional check to report modes not compiled for as unknown */
@@ -87,6 +94,10 @@ constexpr std::string_view SEMToString(const SocketEventsMode val) {
         case (SocketEventsMode::KQueue):
             return "kqueue";
 #endif /* USE_KQUEUE */
+#ifdef USE_IO_URING
+        case (SocketEventsMode::IOUring):
+            return "io_uring";
+#endif /* USE_IO_URING */
         default:
             return "unknown";
     };
@@ -104,6 +115,9 @@ constexpr std::string_view GetSupportedSocketEventsStr()
 #ifdef USE_KQUEUE
            ", 'kqueue'"
 #endif /* USE_KQUEUE */
+#ifdef USE_IO_URING
+           ", 'io_uring'"
+#endif /* USE_IO_URING */
            ;
 }
 
@@ -119,6 +133,9 @@ constexpr SocketEventsMode SEMFromString(std::string_view str) {
 #ifdef USE_KQUEUE
     if (str == "kqueue") { return SocketEventsMode::KQueue; }
 #endif /* USE_KQUEUE */
+#ifdef USE_IO_URING
+    if (str == "io_uring") { return SocketEventsMode::IOUring; }
+#endif /* USE_IO_URING */
     return SocketEventsMode::Unknown;
 }
 
@@ -344,6 +361,12 @@ public:
                                SOCKET kqueue_fd,
                                SocketEventsParams::wrap_fn wrap_func);
 #endif /* USE_KQUEUE */
+#ifdef USE_IO_URING
+    static bool WaitManyIOUring(std::chrono::milliseconds timeout,
+                                EventsPerSock& events_per_sock,
+                                const EdgeTriggeredEvents& edge_trig_events,
+                                SocketEventsParams::wrap_fn wrap_func);
+#endif /* USE_IO_URING */
 #ifdef USE_POLL
     static bool WaitManyPoll(std::chrono::milliseconds timeout,
                              EventsPerSock& events_per_sock,
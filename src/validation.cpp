@@ -11,12 +11,14 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <checkqueue.h>
+#include <clientversion.h>
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
 #include <consensus/merkle.h>
 #include <consensus/tx_check.h>
 #include <consensus/tx_verify.h>
 #include <consensus/validation.h>
+#include <ctpl_stl.h>
 #include <cuckoocache.h>
 #include <flatfile.h>
 #include <hash.h>
@@ -34,6 +36,7 @@
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <shutdown.h>
+#include <streams.h>
 
 #include <timedata.h>
 #include <tinyformat.h>
@@ -47,6 +50,7 @@
 #include <util/trace.h>
 #include <util/translation.h>
 #include <util/system.h>
+#include <util/thread.h>
 #include <validationinterface.h>
 #include <warnings.h>
 
@@ -54,6 +58,7 @@
 #include <evo/chainhelper.h>
 #include <evo/deterministicmns.h>
 #include <evo/evodb.h>
+#include <evo/evosnapshot.h>
 #include <evo/specialtx.h>
 #include <evo/specialtxman.h>
 #include <masternode/payments.h>
@@ -63,6 +68,7 @@
 #include <algorithm>
 #include <cassert>
 #include <deque>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <ranges>
@@ -132,6 +138,7 @@ bool fCheckpointsEnabled = DEFAULT_CHECKPOINTS_ENABLED;
 int64_t nMaxTipAge = DEFAULT_MAX_TIP_AGE;
 
 uint256 hashAssumeValid;
+bool g_skip_chainlocked_scripts = DEFAULT_SKIP_CHAINLOCKED_SCRIPTS;
 arith_uint256 nMinimumChainWork;
 
 // Forward declaration to break dependency over node/transaction.h
@@ -1956,7 +1963,7 @@ int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out)
 
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
  *  When FAILED is returned, view is left in an indeterminate state. */
-DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, bool fUndoMNList)
 {
     AssertLockHeld(cs_main);
     assert(m_chain_helper);
@@ -1984,7 +1991,7 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
     }
 
     std::optional<MNListUpdates> mnlist_updates_opt{std::nullopt};
-    if (!m_chain_helper->special_tx->UndoSpecialTxsInBlock(block, pindex, mnlist_updates_opt)) {
+    if (!m_chain_helper->special_tx->UndoSpecialTxsInBlock(block, pindex, mnlist_updates_opt, fUndoMNList)) {
         error("DisconnectBlock(): UndoSpecialTxsInBlock failed");
         return DISCONNECT_FAILED;
     }
@@ -2241,6 +2248,16 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
         }
     }
 
+    // Blocks covered by a verified chainlock can't be reorged anymore. Unless told to check them right away,
+    // skip their (input) script checks and leave them to the script audit, which re-verifies them later in
+    // the background. Special transactions are still fully checked as they are needed to build evodb.
+    bool fScriptAudit = false;
+    if (fScriptChecks && g_skip_chainlocked_scripts && !fJustCheck &&
+        m_chain_helper->HasChainLock(pindex->nHeight, block_hash)) {
+        fScriptChecks = false;
+        fScriptAudit = true;
+    }
+
     int64_t nTime1 = GetTimeMicros(); nTimeCheck += nTime1 - nTimeStart;
     LogPrint(BCLog::BENCHMARK, "    - Sanity checks: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime1 - nTimeStart), nTimeCheck * MICRO, nTimeCheck * MILLI / nBlocksTotal);
 
@@ -2320,7 +2337,7 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     // MUST process special txes before updating UTXO to ensure consistency between mempool and block processing
     std::optional<MNListUpdates> mnlist_updates_opt{std::nullopt};
-    if (!m_chain_helper->special_tx->ProcessSpecialTxsInBlock(block, pindex, view, fJustCheck, fScriptChecks, state, mnlist_updates_opt)) {
+    if (!m_chain_helper->special_tx->ProcessSpecialTxsInBlock(block, pindex, view, fJustCheck, fScriptChecks || fScriptAudit, state, mnlist_updates_opt)) {
         return error("ConnectBlock(DASH): ProcessSpecialTxsInBlock for block %s failed with %s",
                      pindex->GetBlockHash().ToString(), state.ToString());
     }
@@ -2499,6 +2516,15 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
         pindex->RaiseValidity(BLOCK_VALID_SCRIPTS);
         m_blockman.m_dirty_blockindex.insert(pindex);
     }
+    if (fScriptAudit) {
+        pindex->nStatus |= BLOCK_SCRIPTS_UNVERIFIED;
+        m_blockman.m_dirty_blockindex.insert(pindex);
+        m_chainman.QueueScriptAudit(pindex);
+    } else if (fScriptChecks && (pindex->nStatus & BLOCK_SCRIPTS_UNVERIFIED)) {
+        // Connected again (e.g. after reconsiderblock) with full checks
+        pindex->nStatus &= ~BLOCK_SCRIPTS_UNVERIFIED;
+        m_blockman.m_dirty_blockindex.insert(pindex);
+    }
 
     int64_t nTime8 = GetTimeMicros(); nTimeIndexWrite += nTime8 - nTime7;
     LogPrint(BCLog::BENCHMARK, "      - Index writing: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime8 - nTime7), nTimeIndexWrite * MICRO, nTimeIndexWrite * MILLI / nBlocksTotal);
@@ -2685,8 +2711,21 @@ bool CChainState::FlushStateToDisk(
                     return AbortNode(state, "Disk space is too low!", _("Disk space is too low!"));
                 }
                 // Flush the chainstate (which may refer to block index entries).
-                if (!CoinsTip().Flush())
+                // Blocks at or below the best chainlock can't be reorged anymore, so unless we are asked to
+                // flush everything, keep the coins of the unlocked blocks at the tip cached. They are the most
+                // likely to be spent next. SyncAndUncache() reallocates the cache, so if the coins kept still
+                // make it LARGE, wipe it as before.
+                const int chainlock_height{m_chain_helper ? m_chain_helper->GetBestChainLockHeight() : -1};
+                if (mode != FlushStateMode::ALWAYS && chainlock_height > 0) {
+                    if (!CoinsTip().SyncAndUncache(chainlock_height))
+                        return AbortNode(state, "Failed to write to coin database");
+                    LogPrint(BCLog::COINDB, "Kept %d coins above chainlock height %d cached (%.2fkB)\n",
+                             CoinsTip().GetCacheSize(), chainlock_height, CoinsTip().DynamicMemoryUsage() / 1000.0);
+                    if (GetCoinsCacheSizeState() >= CoinsCacheSizeState::LARGE && !CoinsTip().Flush())
+                        return AbortNode(state, "Failed to write to coin database");
+                } else if (!CoinsTip().Flush()) {
                     return AbortNode(state, "Failed to write to coin database");
+                }
             }
             {
                 LOG_TIME_SECONDS("write evodb cache to disk");
@@ -2915,6 +2954,99 @@ bool CChainState::DisconnectTip(BlockValidationState& state, DisconnectedBlockTr
     return true;
 }
 
+/**
+ * Disconnect the active chain down to pindexFork in one go. Unlike calling DisconnectTip() for
+ * every block, the UTXO set and evodb changes of all blocks are committed (or rolled back) as a
+ * single batch, and the masternode list is rolled back to pindexFork directly instead of being
+ * rebuilt for every intermediate block. Validation interface callbacks are still sent per block.
+ * All disconnected blocks are kept in memory until the batch is committed, see MAX_DISCONNECT_BATCH_DEPTH.
+ */
+bool CChainState::DisconnectTips(BlockValidationState& state, const CBlockIndex* pindexFork, DisconnectedBlockTransactions* disconnectpool)
+{
+    AssertLockHeld(cs_main);
+    if (m_mempool) AssertLockHeld(m_mempool->cs);
+    assert(m_chain_helper);
+    assert(pindexFork && m_chain.Contains(pindexFork));
+
+    int64_t nTime1 = GetTimeMicros();
+
+    CBlockIndex* pindexOldTip = m_chain.Tip();
+    std::vector<std::pair<CBlockIndex*, std::shared_ptr<CBlock>>> disconnected;
+    disconnected.reserve(pindexOldTip->nHeight - pindexFork->nHeight);
+    // See DisconnectTip(), the scheme may be switched back before the tip moves
+    ScopedBLSLegacyScheme bls_scheme_guard;
+    {
+        auto dbTx = m_evoDb.BeginTransaction();
+
+        CCoinsViewCache view(&CoinsTip());
+        for (CBlockIndex* pindexDelete = pindexOldTip; pindexDelete != pindexFork; pindexDelete = pindexDelete->pprev) {
+            auto pblock = std::make_shared<CBlock>();
+            if (!ReadBlockFromDisk(*pblock, pindexDelete, m_params.GetConsensus())) {
+                return error("DisconnectTips(): Failed to read block");
+            }
+            assert(view.GetBestBlock() == pindexDelete->GetBlockHash());
+            if (DisconnectBlock(*pblock, pindexDelete, view, /*fUndoMNList=*/false) != DISCONNECT_OK) {
+                return error("DisconnectTips(): DisconnectBlock %s failed", pindexDelete->GetBlockHash().ToString());
+            }
+            disconnected.emplace_back(pindexDelete, std::move(pblock));
+        }
+
+        std::optional<MNListUpdates> mnlist_updates_opt{std::nullopt};
+        if (!m_chain_helper->special_tx->UndoMNListInBlocks(pindexOldTip, pindexFork, mnlist_updates_opt)) {
+            return error("DisconnectTips(): UndoMNListInBlocks failed");
+        }
+        if (mnlist_updates_opt.has_value()) {
+            auto& mnlu = mnlist_updates_opt.value();
+            GetMainSignals().NotifyMasternodeListChanged(true, mnlu.old_list, mnlu.diff);
+            uiInterface.NotifyMasternodeListChanged(mnlu.new_list, pindexFork);
+        }
+
+        bool flushed = view.Flush();
+        assert(flushed);
+        dbTx->Commit();
+    }
+    LogPrint(BCLog::BENCHMARK, "- Disconnect %d blocks: %.2fms\n", disconnected.size(), (GetTimeMicros() - nTime1) * MILLI);
+
+    // Prune locks that began above the fork should be moved backward so they get a chance to reorg
+    for (auto& prune_lock : m_blockman.m_prune_locks) {
+        if (prune_lock.second.height_first <= pindexFork->nHeight) continue;
+
+        prune_lock.second.height_first = pindexFork->nHeight;
+        LogPrint(BCLog::PRUNE, "%s prune lock moved back to %d\n", prune_lock.first, pindexFork->nHeight);
+    }
+
+    for (const auto& [pindexDelete, pblock] : disconnected) {
+        if (disconnectpool && m_mempool) {
+            // Save transactions to re-add to mempool at end of reorg
+            for (auto it = pblock->vtx.rbegin(); it != pblock->vtx.rend(); ++it) {
+                disconnectpool->addTransaction(*it);
+            }
+            while (disconnectpool->DynamicMemoryUsage() > MAX_DISCONNECTED_TX_POOL_SIZE * 1000) {
+                // Drop the earliest entry, and remove its children from the mempool.
+                auto it = disconnectpool->queuedTx.get<insertion_order>().begin();
+                m_mempool->removeRecursive(**it, MemPoolRemovalReason::REORG);
+                disconnectpool->removeEntry(it);
+            }
+        }
+
+        m_chain.SetTip(*pindexDelete->pprev);
+        UpdateTip(pindexDelete->pprev);
+        // Let wallets know transactions went from 1-confirmed to
+        // 0-confirmed or conflicted:
+        GetMainSignals().BlockDisconnected(pblock, pindexDelete);
+    }
+    bls_scheme_guard.Commit();
+
+    // Write the chain state to disk, if necessary.
+    if (!FlushStateToDisk(state, FlushStateMode::IF_NEEDED)) {
+        return false;
+    }
+
+    ::g_stats_client->timing("DisconnectTip_ms", (GetTimeMicros() - nTime1) / 1000, 1.0f);
+    ::g_stats_client->gauge("blocks.tip.Height", m_chain.Height(), 1.0f);
+    return true;
+}
+
 static int64_t nTimeConnectTotal = 0;
 static int64_t nTimeFlush = 0;
 static int64_t nTimeChainState = 0;
@@ -3149,7 +3281,10 @@ bool CChainState::ActivateBestChainStep(BlockValidationState& state, CBlockIndex
     bool fBlocksDisconnected = false;
     DisconnectedBlockTransactions disconnectpool;
     while (m_chain.Tip() && m_chain.Tip() != pindexFork) {
-        if (!DisconnectTip(state, &disconnectpool)) {
+        // Roll back reorgs deeper than a single block in batches of at most MAX_DISCONNECT_BATCH_DEPTH blocks
+        const CBlockIndex* pindexBatchFork{pindexFork == nullptr ? nullptr : m_chain[std::max(pindexFork->nHeight, m_chain.Height() - MAX_DISCONNECT_BATCH_DEPTH)]};
+        const bool fBatch{pindexBatchFork != nullptr && m_chain.Tip()->pprev != pindexBatchFork};
+        if (!(fBatch ? DisconnectTips(state, pindexBatchFork, &disconnectpool) : DisconnectTip(state, &disconnectpool))) {
             // This is likely a fatal error, but keep the mempool consistent,
             // just in case. Only remove from the mempool in this case.
             MaybeUpdateMempoolForReorg(disconnectpool, false);
@@ -3788,6 +3923,38 @@ static bool CheckBlockHeader(const CBlockHeader& block, const uint256& hash, Blo
     return true;
 }
 
+std::vector<uint256> HashHeaders(const std::vector<CBlockHeader>& headers, ctpl::thread_pool* pool)
+{
+    static constexpr size_t MIN_HEADERS_PER_THREAD{250};
+
+    std::vector<uint256> hashes(headers.size());
+    const size_t pool_size{pool ? static_cast<size_t>(pool->size()) : 0};
+    const size_t num_chunks{std::clamp<size_t>(headers.size() / MIN_HEADERS_PER_THREAD, 1, pool_size + 1)};
+    auto hash_range = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hashes[i] = headers[i].GetHash();
+        }
+    };
+    if (num_chunks == 1) {
+        hash_range(0, headers.size());
+        return hashes;
+    }
+
+    const size_t chunk{(headers.size() + num_chunks - 1) / num_chunks};
+    std::vector<std::future<void>> workers;
+    workers.reserve(num_chunks - 1);
+    for (size_t begin = chunk; begin < headers.size(); begin += chunk) {
+        workers.emplace_back(pool->push([&hash_range, begin, end = std::min(begin + chunk, headers.size())](int) {
+            hash_range(begin, end);
+        }));
+    }
+    hash_range(0, chunk);
+    for (auto& worker : workers) {
+        worker.wait();
+    }
+    return hashes;
+}
+
 bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, bool fCheckMerkleRoot, const uint256* known_hash)
 {
     // These are checks that are independent of context.
@@ -4133,14 +4300,17 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
 }
 
 // Exposed wrapper for AcceptBlockHeader
-bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, BlockValidationState& state, const CBlockIndex** ppindex)
+bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, BlockValidationState& state, const CBlockIndex** ppindex,
+                                               Span<const uint256> hashes)
 {
     AssertLockNotHeld(cs_main);
+    assert(hashes.empty() || hashes.size() == headers.size());
     {
         LOCK(cs_main);
-        for (const CBlockHeader& header : headers) {
+        for (size_t i = 0; i < headers.size(); ++i) {
+            const CBlockHeader& header = headers[i];
             CBlockIndex *pindex = nullptr; // Use a temp pindex instead of ppindex to avoid a const_cast
-            bool accepted{AcceptBlockHeader(header, state, &pindex, header.GetHash())};
+            bool accepted{AcceptBlockHeader(header, state, &pindex, hashes.empty() ? header.GetHash() : hashes[i])};
             ActiveChainstate().CheckBlockIndex();
 
             if (!accepted) {
@@ -5682,6 +5852,15 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
     // method.
     coins_cache.SetBestBlock(base_blockhash);
 
+    // The evo state at the base block follows the coins
+    CEvoSnapshot evo_snapshot;
+    try {
+        OverrideStream<AutoFile>{&coins_file, SER_DISK, CLIENT_VERSION} >> evo_snapshot;
+    } catch (const std::ios_base::failure&) {
+        LogPrintf("[snapshot] bad snapshot format or truncated snapshot after deserializing evo state\n");
+        return false;
+    }
+
     bool out_of_coins{false};
     try {
         coins_file >> outpoint;
@@ -5729,6 +5908,16 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
     // The remainder of this function requires modifying data protected by cs_main.
     LOCK(::cs_main);
 
+    {
+        // Uncommitted evodb writes would be dropped by the next rolled back block scope, e.g. in TestBlockValidity
+        auto dbTx = snapshot_chainstate.m_evoDb.BeginTransaction();
+        if (std::string evo_error; !snapshot_chainstate.ChainHelper().special_tx->LoadEvoSnapshot(evo_snapshot, snapshot_start_block, evo_error)) {
+            LogPrintf("[snapshot] bad snapshot evo state: %s\n", evo_error);
+            return false;
+        }
+        dbTx->Commit();
+    }
+
     // Fake various pieces of CBlockIndex state:
     CBlockIndex* index = nullptr;
 
@@ -5867,8 +6056,152 @@ void ChainstateManager::MaybeRebalanceCaches()
     }
 }
 
+void ChainstateManager::QueueScriptAudit(CBlockIndex* pindex)
+{
+    AssertLockHeld(::cs_main);
+    m_script_audit_queue.insert(pindex);
+}
+
+ChainstateManager::ScriptAuditResult ChainstateManager::AuditBlockScripts(const CBlockIndex& block_index) const
+{
+    CBlock block;
+    if (!ReadBlockFromDisk(block, &block_index, GetConsensus())) {
+        LogPrintf("%s: failed to read block %s\n", __func__, block_index.GetBlockHash().ToString());
+        return ScriptAuditResult::READ_FAILED;
+    }
+    CBlockUndo blockundo;
+    if (!UndoReadFromDisk(blockundo, &block_index)) {
+        LogPrintf("%s: failed to read undo data of block %s\n", __func__, block_index.GetBlockHash().ToString());
+        return ScriptAuditResult::READ_FAILED;
+    }
+    if (blockundo.vtxundo.size() + 1 != block.vtx.size()) {
+        LogPrintf("%s: undo data of block %s doesn't match\n", __func__, block_index.GetBlockHash().ToString());
+        return ScriptAuditResult::READ_FAILED;
+    }
+
+    const unsigned int flags{GetBlockScriptFlags(&block_index, *this)};
+    for (size_t i = 1; i < block.vtx.size(); ++i) {
+        const CTransaction& tx{*block.vtx[i]};
+        const CTxUndo& txundo{blockundo.vtxundo[i - 1]};
+        if (txundo.vprevout.size() != tx.vin.size()) {
+            LogPrintf("%s: undo data of tx %s doesn't match\n", __func__, tx.GetHash().ToString());
+            return ScriptAuditResult::READ_FAILED;
+        }
+        std::vector<CTxOut> spent_outputs;
+        spent_outputs.reserve(tx.vin.size());
+        for (const Coin& coin : txundo.vprevout) {
+            spent_outputs.emplace_back(coin.out);
+        }
+        PrecomputedTransactionData txdata;
+        txdata.Init(tx, std::move(spent_outputs));
+        for (unsigned int j = 0; j < tx.vin.size(); ++j) {
+            CScriptCheck check(txdata.m_spent_outputs[j], tx, j, flags, /*cacheIn=*/false, &txdata);
+            if (!check()) {
+                LogPrintf("%s: input %d of tx %s in block %s failed script verification: %s\n", __func__, j,
+                          tx.GetHash().ToString(), block_index.GetBlockHash().ToString(), ScriptErrorString(check.GetScriptError()));
+                return ScriptAuditResult::INVALID;
+            }
+        }
+    }
+    return ScriptAuditResult::VALID;
+}
+
+void ChainstateManager::ThreadScriptAudit()
+{
+    while (!m_script_audit_interrupt) {
+        // Audit as many blocks at once as there are threads
+        std::vector<CBlockIndex*> blocks;
+        {
+            LOCK(::cs_main);
+            for (auto it = m_script_audit_queue.begin(); it != m_script_audit_queue.end() &&
+                 blocks.size() < static_cast<size_t>(m_script_audit_pool->size());) {
+                // Blocks which got disconnected are queued again if they are connected without script checks
+                if (!ActiveChain().Contains(*it)) {
+                    it = m_script_audit_queue.erase(it);
+                    continue;
+                }
+                blocks.push_back(*it);
+                ++it;
+            }
+        }
+        if (blocks.empty()) {
+            if (!m_script_audit_interrupt.sleep_for(std::chrono::seconds{10})) return;
+            continue;
+        }
+
+        std::vector<std::future<ScriptAuditResult>> results;
+        results.reserve(blocks.size());
+        for (const CBlockIndex* pindex : blocks) {
+            results.emplace_back(m_script_audit_pool->push([this, pindex](int) {
+                ScheduleBatchPriority();
+                return AuditBlockScripts(*pindex);
+            }));
+        }
+
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            CBlockIndex* pindex{blocks[i]};
+            const ScriptAuditResult result{results[i].get()};
+            if (result == ScriptAuditResult::READ_FAILED) {
+                // Missing or corrupt block data says nothing about the validity of the chain
+                AbortNode(strprintf("Failed to read block %s (height %d) for the script audit",
+                                    pindex->GetBlockHash().ToString(), pindex->nHeight),
+                          _("Failed to read block data for the script audit, see debug.log for details. The block files may be corrupt, restart with -reindex to rebuild them."));
+                return;
+            }
+            if (result == ScriptAuditResult::INVALID) {
+                // A chainlocked block with invalid scripts means the chainlock quorum signed an invalid chain,
+                // nothing we can recover from automatically
+                AbortNode(strprintf("Script audit of chainlocked block %s (height %d) failed",
+                                    pindex->GetBlockHash().ToString(), pindex->nHeight),
+                          _("A chainlocked block failed the script audit, see debug.log for details. Restart with -reindex-chainstate and -skipchainlockedscripts=0 to fully validate the chain."));
+                return;
+            }
+            LOCK(::cs_main);
+            pindex->nStatus &= ~BLOCK_SCRIPTS_UNVERIFIED;
+            m_blockman.m_dirty_blockindex.insert(pindex);
+            m_script_audit_queue.erase(pindex);
+            LogPrint(BCLog::VALIDATION, "%s: Audited scripts of block %s (height %d), %d blocks left\n", __func__,
+                     pindex->GetBlockHash().ToString(), pindex->nHeight, m_script_audit_queue.size());
+        }
+    }
+}
+
+void ChainstateManager::StartScriptAudit(int threads_num)
+{
+    assert(!m_script_audit_thread.joinable());
+    {
+        // Pick up the blocks which weren't audited before the last shutdown
+        LOCK(::cs_main);
+        for (auto& [_, block_index] : m_blockman.m_block_index) {
+            if (block_index.nStatus & BLOCK_SCRIPTS_UNVERIFIED) {
+                m_script_audit_queue.insert(&block_index);
+            }
+        }
+        if (!m_script_audit_queue.empty()) {
+            LogPrintf("Script audit: %d chainlocked blocks with skipped script checks left to verify\n", m_script_audit_queue.size());
+        }
+    }
+    m_script_audit_interrupt.reset();
+    m_script_audit_pool = std::make_unique<ctpl::thread_pool>(std::max(threads_num, 1));
+    RenameThreadPool(*m_script_audit_pool, "scriptaudit");
+    m_script_audit_thread = std::thread(&util::TraceThread, "scriptaudit", [this] { ThreadScriptAudit(); });
+}
+
+void ChainstateManager::StopScriptAudit()
+{
+    if (!m_script_audit_thread.joinable()) return;
+    m_script_audit_interrupt();
+    m_script_audit_thread.join();
+    m_script_audit_pool->stop(/*isWait=*/true);
+    m_script_audit_pool.reset();
+}
+
+ChainstateManager::ChainstateManager(const CChainParams& chainparams) : m_chainparams{chainparams}, m_blockman{{chainparams}} {}
+
 ChainstateManager::~ChainstateManager()
 {
+    StopScriptAudit();
+
     LOCK(::cs_main);
 
     m_versionbitscache.Clear();
@@ -24,12 +24,14 @@
 #include <policy/policy.h>
 #include <script/script_error.h>
 #include <serialize.h>
+#include <span.h>
 #include <sync.h>
 #include <txdb.h>
 #include <txmempool.h> // For CTxMemPool::cs
 #include <uint256.h>
 #include <util/check.h>
 #include <util/hasher.h>
+#include <util/threadinterrupt.h>
 #include <util/translation.h>
 #include <versionbits.h>
 
@@ -67,6 +69,7 @@ namespace node {
 class SnapshotMetadata;
 } // namespace node
 namespace chainlock { class Chainlocks; }
+namespace ctpl { class thread_pool; }
 
 enum class MnRewardEra; // defined in masternode/payments.h
 
@@ -76,6 +79,10 @@ static const unsigned int DEFAULT_MEMPOOL_EXPIRY = 336;
 static const int MAX_SCRIPTCHECK_THREADS = 15;
 /** -par default (number of script-checking threads, 0 = auto) */
 static const int DEFAULT_SCRIPTCHECK_THREADS = 0;
+/** Default for -skipchainlockedscripts */
+static constexpr bool DEFAULT_SKIP_CHAINLOCKED_SCRIPTS{false};
+/** -scriptauditthreads default (number of threads re-verifying skipped scripts in the background) */
+static constexpr int DEFAULT_SCRIPT_AUDIT_THREADS{1};
 /** Number of headers sent in one getheaders result. We rely on the assumption that if a peer sends
  *  less than this number, we reached its tip. Changing this value is a protocol upgrade. */
 static const unsigned int MAX_HEADERS_UNCOMPRESSED_RESULT = 2000;
@@ -92,6 +99,9 @@ static const bool DEFAULT_PERSIST_MEMPOOL = true;
 static const int DEFAULT_STOPATHEIGHT = 0;
 /** Block files containing a block-height within MIN_BLOCKS_TO_KEEP of ActiveChain().Tip() will not be pruned. */
 static const unsigned int MIN_BLOCKS_TO_KEEP = 288;
+/** Maximum number of blocks disconnected as one batch, all of them and their UTXO set changes are kept in memory
+ *  until the batch is committed. Deeper reorgs are split into several batches. */
+static constexpr int MAX_DISCONNECT_BATCH_DEPTH{50};
 static const signed int DEFAULT_CHECKBLOCKS = 6;
 static constexpr int DEFAULT_CHECKLEVEL{3};
 
@@ -133,6 +143,9 @@ extern bool fLargeWorkInvalidChainFound;
 /** Block hash whose ancestors we will assume to have valid scripts without checking them. */
 extern uint256 hashAssumeValid;
 
+/** Skip script checks of blocks covered by a verified chainlock, leaving them to the script audit */
+extern bool g_skip_chainlocked_scripts;
+
 /** Minimum work we will assume exists on some valid chain. */
 extern arith_uint256 nMinimumChainWork;
 
@@ -374,6 +387,12 @@ void InitScriptExecutionCache();
 /** Context-independent validity checks */
 bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true, const uint256* known_hash = nullptr);
 
+/**
+ * Hash a batch of headers. Large batches are split between the calling thread and the
+ * threads of pool, small ones (or all of them if pool is null) are hashed inline.
+ */
+std::vector<uint256> HashHeaders(const std::vector<CBlockHeader>& headers, ctpl::thread_pool* pool);
+
 /** Check a block is completely valid from start to finish (only works on top of our current best block) */
 bool TestBlockValidity(BlockValidationState& state,
                        const chainlock::Chainlocks& chainlocks,
@@ -709,11 +728,15 @@ public:
     bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockValidationState& state, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock, const uint256* known_hash = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Block (dis)connection on a given view:
-    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    //! fUndoMNList=false leaves rolling back the masternode list to the caller, see DisconnectTips()
+    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, bool fUndoMNList = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     bool ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Apply the effects of a block disconnection on the UTXO set.
     bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    // Disconnect all blocks above pindexFork, committing their UTXO set and evodb changes as one batch.
+    // Callers keep the depth within MAX_DISCONNECT_BATCH_DEPTH.
+    bool DisconnectTips(BlockValidationState& state, const CBlockIndex* pindexFork, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
     // Manual block validity manipulation:
     /** Mark a block as precious and reorganize.
@@ -922,8 +945,28 @@ private:
 
     std::array<ThresholdConditionCache, VERSIONBITS_NUM_BITS> m_warningcache GUARDED_BY(::cs_main);
 
+    //! Blocks with BLOCK_SCRIPTS_UNVERIFIED in the active chain, waiting for the script audit
+    std::set<CBlockIndex*> m_script_audit_queue GUARDED_BY(::cs_main);
+    std::thread m_script_audit_thread;
+    std::unique_ptr<ctpl::thread_pool> m_script_audit_pool;
+    CThreadInterrupt m_script_audit_interrupt;
+
+    //! Re-verify the scripts of queued blocks until interrupted
+    void ThreadScriptAudit() LOCKS_EXCLUDED(::cs_main);
+
+    enum class ScriptAuditResult {
+        VALID,
+        //! An input script failed verification
+        INVALID,
+        //! The block or its undo data couldn't be read or doesn't match
+        READ_FAILED,
+    };
+
+    //! Verify all input scripts of a connected block, using its undo data for the spent outputs
+    ScriptAuditResult AuditBlockScripts(const CBlockIndex& block_index) const;
+
 public:
-    explicit ChainstateManager(const CChainParams& chainparams) : m_chainparams{chainparams}, m_blockman{{chainparams}} { }
+    explicit ChainstateManager(const CChainParams& chainparams);
 
     const CChainParams& GetParams() const { return m_chainparams; }
     const Consensus::Params& GetConsensus() const { return m_chainparams.GetConsensus(); }
@@ -1058,8 +1101,10 @@ public:
      * @param[in]  block The block headers themselves
      * @param[out] state This may be set to an Error state if any error occurred processing them
      * @param[out] ppindex If set, the pointer will be set to point to the last new block index object for the given headers
+     * @param[in]  hashes If not empty, the precomputed hashes of the headers, saving the X11 hashing while holding cs_main
      */
-    bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& block, BlockValidationState& state, const CBlockIndex** ppindex = nullptr) LOCKS_EXCLUDED(cs_main);
+    bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& block, BlockValidationState& state, const CBlockIndex** ppindex = nullptr,
+                                Span<const uint256> hashes = {}) LOCKS_EXCLUDED(cs_main);
 
     /**
      * Try to add a transaction to the memory pool.
@@ -1078,6 +1123,13 @@ public:
     //! ResizeCoinsCaches() as needed.
     void MaybeRebalanceCaches() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
+    //! Queue a block whose script checks were skipped for the script audit
+    void QueueScriptAudit(CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
+    //! Start re-verifying skipped scripts at low priority, picking up the blocks left unaudited by a previous run
+    void StartScriptAudit(int threads_num) LOCKS_EXCLUDED(::cs_main);
+    void StopScriptAudit();
+
     bool IsQuorumTypeEnabled(const Consensus::LLMQType llmqType, gsl::not_null<const CBlockIndex*> pindexPrev,
                              std::optional<bool> optDIP0024IsActive = std::nullopt,
                              std::optional<bool> optHaveDIP0024Quorums = std::nullopt) const;
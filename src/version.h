@@ -11,7 +11,7 @@
  */
 
 
-static const int PROTOCOL_VERSION = 70240;
+static const int PROTOCOL_VERSION = 70241;
 
 //! initial proto version, to be increased after version/verack negotiation
 static const int INIT_PROTO_VERSION = 209;
@@ -67,6 +67,9 @@ static const int QFCOMMIT_STALE_REPROP_BAN_VERSION = 70239;
 //! PLATFORMBAN added to v2 short IDs (short ID 168)
 static const int PLATFORMBAN_V2_SHORT_ID_VERSION = 70240;
 
+//! ISDLOCKs may be sent as ISDLOCKCMPCT to peers which know the locked transaction
+static const int COMPACT_ISDLOCK_VERSION = 70241;
+
 // Make sure that none of the values above collide with `ADDRV2_FORMAT`.
 
 #endif // BITCOIN_VERSION_H
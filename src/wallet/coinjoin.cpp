@@ -58,7 +58,8 @@ bool CWallet::SelectTxDSInsByDenomination(int nDenom, CAmount nValueMax, std::ve
     CAmount nValueTotal{0};
     CCoinControl coin_control(CoinType::ONLY_READY_TO_MIX);
     std::set<uint256> setRecentTxIds;
-    std::vector<COutput> vCoins{AvailableCoinsListUnspent(*this, &coin_control).all()};
+    std::vector<COutput> vCoins{AvailableCoinsListUnspent(*this, &coin_control, /*nMinimumAmount=*/nDenomAmount,
+                                                          /*nMaximumAmount=*/nDenomAmount).all()};
 
     WalletCJLogPrint(this, "CWallet::%s -- vCoins.size(): %d\n", __func__, vCoins.size());
 
@@ -244,13 +245,24 @@ int CWallet::CountInputsWithAmount(CAmount nInputAmount) const
 
     LOCK(cs_wallet);
 
-    for (const auto& outpoint : setWalletUTXO) {
+    const auto count_outpoint = [&](const COutPoint& outpoint) {
         const auto it{mapWallet.find(outpoint.hash)};
-        if (it == mapWallet.end()) continue;
-        if (it->second.tx->vout[outpoint.n].nValue != nInputAmount) continue;
-        if (GetTxDepthInMainChain(it->second) < 0) continue;
+        if (it == mapWallet.end()) return;
+        if (it->second.tx->vout[outpoint.n].nValue != nInputAmount) return;
+        if (GetTxDepthInMainChain(it->second) < 0) return;
 
         nTotal++;
+    };
+
+    if (CoinJoin::IsDenominatedAmount(nInputAmount) || CoinJoin::IsCollateralAmount(nInputAmount)) {
+        for (auto it = m_coinjoin_utxos.lower_bound({nInputAmount, COutPoint{uint256{}, 0}});
+             it != m_coinjoin_utxos.end() && it->first == nInputAmount; ++it) {
+            count_outpoint(it->second);
+        }
+    } else {
+        for (const auto& outpoint : setWalletUTXO) {
+            count_outpoint(outpoint);
+        }
     }
 
     return nTotal;
@@ -423,7 +435,8 @@ CAmount GetBalanceAnonymized(const CWallet& wallet, const CCoinControl& coinCont
 
     CAmount anonymized_amount{0};
     LOCK(wallet.cs_wallet);
-    for (auto pcoin : wallet.GetSpendableTXs()) {
+    const auto denoms{CoinJoin::GetStandardDenominations()};
+    for (auto pcoin : wallet.GetCoinJoinSpendableTXs(denoms.back(), denoms.front())) {
         anonymized_amount += CachedTxGetAnonymizedCredit(wallet, *pcoin, coinControl);
     }
     return anonymized_amount;
@@ -119,8 +119,15 @@ CoinsResult AvailableCoins(const CWallet& wallet,
     const int max_depth = {coinControl ? coinControl->m_max_depth : DEFAULT_MAX_DEPTH};
     const bool only_safe = {coinControl ? !coinControl->m_include_unsafe_inputs : true};
 
+    // CoinJoin coin types can only ever match denominated or collateral outputs, use the wallet's index of
+    // those instead of walking every wallet transaction with unspent outputs
+    const bool coinjoin_only{nCoinType == CoinType::ONLY_FULLY_MIXED || nCoinType == CoinType::ONLY_READY_TO_MIX ||
+                             nCoinType == CoinType::ONLY_COINJOIN_COLLATERAL};
+    const auto spendable_txs{coinjoin_only ? wallet.GetCoinJoinSpendableTXs(nMinimumAmount, nMaximumAmount)
+                                           : wallet.GetSpendableTXs()};
+
     std::set<uint256> trusted_parents;
-    for (const auto* pwtx : wallet.GetSpendableTXs()) {
+    for (const auto* pwtx : spendable_txs) {
         const uint256& wtxid = pwtx->GetHash();
         const CWalletTx& wtx = *pwtx;
 
@@ -230,6 +230,40 @@ BOOST_FIXTURE_TEST_CASE(coinjoin_manager_start_stop_tests, CTransactionBuilderTe
     BOOST_CHECK_EQUAL(cj_man.IsMixing(), false);
 }
 
+BOOST_FIXTURE_TEST_CASE(coinjoin_utxo_index_tests, CTransactionBuilderTestSetup)
+{
+    const CAmount denom{CoinJoin::GetSmallestDenomination()};
+    const int denom_bits{CoinJoin::AmountToDenomination(denom)};
+    std::vector<CTxDSIn> vecTxDSIn;
+
+    BOOST_CHECK_EQUAL(wallet->CountInputsWithAmount(denom), 0);
+    BOOST_CHECK(!wallet->HasCollateralInputs());
+    BOOST_CHECK(!wallet->SelectTxDSInsByDenomination(denom_bits, MAX_MONEY, vecTxDSIn));
+
+    GetTallyItem({denom, denom, CoinJoin::GetCollateralAmount()});
+
+    BOOST_CHECK_EQUAL(wallet->CountInputsWithAmount(denom), 2);
+    BOOST_CHECK_EQUAL(wallet->CountInputsWithAmount(CoinJoin::GetCollateralAmount()), 1);
+    BOOST_CHECK(wallet->HasCollateralInputs());
+    BOOST_CHECK(wallet->SelectTxDSInsByDenomination(denom_bits, MAX_MONEY, vecTxDSIn));
+    BOOST_CHECK_EQUAL(vecTxDSIn.size(), 2U);
+    // Outputs of other denominations are not picked up
+    BOOST_CHECK(!wallet->SelectTxDSInsByDenomination(CoinJoin::AmountToDenomination(CoinJoin::GetStandardDenominations()[3]), MAX_MONEY, vecTxDSIn));
+
+    // Spending one of the denominated outputs removes it from the index
+    {
+        LOCK(wallet->cs_wallet);
+        CCoinControl coin_control;
+        coin_control.m_feerate = CFeeRate(1000);
+        coin_control.m_allow_other_inputs = false;
+        coin_control.Select(vecTxDSIn.front().prevout);
+        auto res = CreateTransaction(*wallet, {{GetScriptForRawPubKey(coinbaseKey.GetPubKey()), denom / 2, false}}, RANDOM_CHANGE_POSITION, coin_control);
+        BOOST_REQUIRE(res);
+        wallet->CommitTransaction(res->tx, {}, {});
+    }
+    BOOST_CHECK_EQUAL(wallet->CountInputsWithAmount(denom), 1);
+}
+
 BOOST_FIXTURE_TEST_CASE(CTransactionBuilderTest, CTransactionBuilderTestSetup)
 {
     // NOTE: Mock wallet version is FEATURE_BASE which means that it uses uncompressed pubkeys
@@ -44,6 +44,7 @@
 #include <wallet/external_signer_scriptpubkeyman.h>
 #include <warnings.h>
 
+#include <coinjoin/common.h>
 #include <coinjoin/options.h>
 #include <evo/providertx.h>
 #include <governance/vote.h>
@@ -762,7 +763,11 @@ bool CWallet::IsSpent(const COutPoint& outpoint) const
 void CWallet::AddToSpends(const COutPoint& outpoint, const uint256& wtxid, WalletBatch* batch)
 {
     mapTxSpends.insert(std::make_pair(outpoint, wtxid));
-    setWalletUTXO.erase(outpoint);
+    if (setWalletUTXO.erase(outpoint)) {
+        if (const auto it{mapWallet.find(outpoint.hash)}; it != mapWallet.end() && outpoint.n < it->second.tx->vout.size()) {
+            m_coinjoin_utxos.erase({it->second.tx->vout[outpoint.n].nValue, outpoint});
+        }
+    }
 
     if (batch) {
         UnlockCoin(outpoint, batch);
@@ -1175,6 +1180,15 @@ bool CWallet::LoadToWallet(const uint256& hash, const UpdateWalletTxFn& fill_wtx
     return true;
 }
 
+void CWallet::AddWalletUTXO(const COutPoint& outpoint, const CAmount& amount)
+{
+    AssertLockHeld(cs_wallet);
+    setWalletUTXO.insert(outpoint);
+    if (CoinJoin::IsDenominatedAmount(amount) || CoinJoin::IsCollateralAmount(amount)) {
+        m_coinjoin_utxos.emplace(amount, outpoint);
+    }
+}
+
 std::set<COutPoint> CWallet::AddWalletUTXOs(CTransactionRef tx, bool ret_dups)
 {
     AssertLockHeld(cs_wallet);
@@ -1183,7 +1197,11 @@ std::set<COutPoint> CWallet::AddWalletUTXOs(CTransactionRef tx, bool ret_dups)
     for (size_t idx = 0; idx < tx->vout.size(); ++idx) {
         COutPoint outpoint(hash, idx);
         if (IsMine(tx->vout[idx]) && !IsSpent(outpoint)) {
-            if (auto [_, inserted] = setWalletUTXO.emplace(outpoint); inserted || ret_dups) {
+            const bool inserted{setWalletUTXO.count(outpoint) == 0};
+            if (inserted) {
+                AddWalletUTXO(outpoint, tx->vout[idx].nValue);
+            }
+            if (inserted || ret_dups) {
                 ret.emplace(outpoint);
             }
         }
@@ -2217,6 +2235,21 @@ std::unordered_set<const CWalletTx*, WalletTxHasher> CWallet::GetSpendableTXs()
     return ret;
 }
 
+std::unordered_set<const CWalletTx*, WalletTxHasher> CWallet::GetCoinJoinSpendableTXs(CAmount nMinimumAmount, CAmount nMaximumAmount) const
+{
+    AssertLockHeld(cs_wallet);
+
+    std::unordered_set<const CWalletTx*, WalletTxHasher> ret;
+    for (auto it = m_coinjoin_utxos.lower_bound({nMinimumAmount, COutPoint{uint256{}, 0}});
+         it != m_coinjoin_utxos.end() && it->first <= nMaximumAmount; ++it) {
+        const auto jt = mapWallet.find(it->second.hash);
+        if (jt != mapWallet.end()) {
+            ret.emplace(&jt->second);
+        }
+    }
+    return ret;
+}
+
 bool CWallet::SignTransaction(CMutableTransaction& tx) const
 {
     AssertLockHeld(cs_wallet);
@@ -2432,7 +2465,7 @@ DBErrors CWallet::LoadWallet()
                 for(unsigned int i = 0; i < pair.second.tx->vout.size(); ++i) {
                     COutPoint outpoint(pair.first, i);
                     if (IsMine(pair.second.tx->vout[i]) && !IsSpent(outpoint)) {
-                        setWalletUTXO.insert(outpoint);
+                        AddWalletUTXO(outpoint, pair.second.tx->vout[i].nValue);
                     }
                 }
             }
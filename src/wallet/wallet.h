@@ -327,6 +327,10 @@ private:
     void AddToSpends(const CWalletTx& wtx, WalletBatch* batch = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     std::set<COutPoint> setWalletUTXO;
+    /** Subset of setWalletUTXO with CoinJoin denominated or collateral amounts, ordered by amount. Lets the CoinJoin
+     *  code look at the outputs it can use without scanning every wallet transaction. */
+    std::set<std::pair<CAmount, COutPoint>> m_coinjoin_utxos GUARDED_BY(cs_wallet);
+    void AddWalletUTXO(const COutPoint& outpoint, const CAmount& amount) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
     /** Add new UTXOs to the wallet UTXO set
      *
      *  @param[in] tx         Transaction to scan eligible UTXOs from
@@ -506,6 +510,8 @@ public:
 
     /* A helper function which loops through wallet UTXOs */
     std::unordered_set<const CWalletTx*, WalletTxHasher> GetSpendableTXs() const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /* Same as GetSpendableTXs() but limited to transactions with CoinJoin denominated or collateral UTXOs in the given amount range */
+    std::unordered_set<const CWalletTx*, WalletTxHasher> GetCoinJoinSpendableTXs(CAmount nMinimumAmount, CAmount nMaximumAmount) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     /** Map from txid to CWalletTx for all transactions this wallet is
      * interested in, including received and sent transactions. */
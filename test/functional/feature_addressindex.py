@@ -19,7 +19,10 @@ from test_framework.script_util import (
     keyhash_to_p2pkh_script,
     scripthash_to_p2sh_script,
 )
-from test_framework.util import assert_equal
+from test_framework.util import (
+    assert_equal,
+    assert_raises_rpc_error,
+)
 
 class AddressIndexTest(BitcoinTestFramework):
     def add_options(self, parser):
@@ -155,6 +158,8 @@ class AddressIndexTest(BitcoinTestFramework):
         self.log.info("Testing balances...")
         balance0 = self.nodes[1].getaddressbalance("93bVhahvUKmQu8gu9g3QnPPa2cxFK98pMB")
         assert_equal(balance0["balance"], (45 + 21) * 100000000)
+        assert_equal(balance0["tx_count"], 4)
+        assert_equal(balance0["last_seen_height"], self.nodes[1].getblockcount())
 
         # Check that balances are correct after spending
         self.log.info("Testing balances after spending...")
@@ -190,6 +195,9 @@ class AddressIndexTest(BitcoinTestFramework):
 
         balance2 = self.nodes[1].getaddressbalance(address2)
         assert_equal(balance2["balance"], change_amount)
+        assert_equal(balance2["received"], amount + change_amount)
+        assert_equal(balance2["tx_count"], 2)
+        assert_equal(balance2["first_seen_height"], balance1["first_seen_height"])
 
         # Check that deltas are returned correctly
         deltas = self.nodes[1].getaddressdeltas({"addresses": [address2], "start": 0, "end": 200})
@@ -247,6 +255,59 @@ class AddressIndexTest(BitcoinTestFramework):
         assert_equal(utxos3[1]["height"], 264)
         assert_equal(utxos3[2]["height"], 265)
 
+        # Check paging through utxos and deltas
+        self.log.info("Testing pagination...")
+        page = self.nodes[1].getaddressutxos({"addresses": [address2], "limit": 2})
+        assert_equal(len(page["utxos"]), 2)
+        page2 = self.nodes[1].getaddressutxos({"addresses": [address2], "limit": 2, "cursor": page["cursor"]})
+        assert_equal(len(page2["utxos"]), 1)
+        assert "cursor" not in page2
+        assert_equal(sorted(u["height"] for u in page["utxos"] + page2["utxos"]), [114, 264, 265])
+
+        deltas_all = self.nodes[1].getaddressdeltas({"addresses": [address2]})
+        paged_deltas = []
+        cursor = None
+        while True:
+            params = {"addresses": [address2], "limit": 1}
+            if cursor is not None:
+                params["cursor"] = cursor
+            page = self.nodes[1].getaddressdeltas(params)
+            paged_deltas += page["deltas"]
+            if "cursor" not in page:
+                break
+            cursor = page["cursor"]
+        assert_equal(paged_deltas, deltas_all)
+        assert_raises_rpc_error(-8, "Cursor requires a limit", self.nodes[1].getaddressdeltas, {"addresses": [address2], "cursor": cursor})
+
+        # Output indexes above 255 sort between lower ones in the database, paging must not skip any of them
+        many_address = self.nodes[0].getnewaddress()
+        many_script = bytes.fromhex(self.nodes[0].getaddressinfo(many_address)["scriptPubKey"])
+        unspent = self.nodes[0].listunspent()
+        tx = CTransaction()
+        tx.vin = [CTxIn(COutPoint(int(unspent[0]["txid"], 16), unspent[0]["vout"]))]
+        tx.vout = [CTxOut(100000, many_script) for _ in range(300)]
+        tx.vout.append(CTxOut(int(unspent[0]["amount"] * COIN) - 300 * 100000 - 100000, scriptPubKey))
+        tx.rehash()
+        signed_tx = self.nodes[0].signrawtransactionwithwallet(tx.serialize().hex())
+        many_txid = self.nodes[0].sendrawtransaction(signed_tx["hex"], 0)
+        self.generate(self.nodes[0], 1)
+
+        all_utxos = self.nodes[1].getaddressutxos({"addresses": [many_address]})
+        assert_equal(len(all_utxos), 300)
+        paged_utxos = []
+        cursor = None
+        while True:
+            params = {"addresses": [many_address], "limit": 50}
+            if cursor is not None:
+                params["cursor"] = cursor
+            page = self.nodes[1].getaddressutxos(params)
+            paged_utxos += page["utxos"]
+            if "cursor" not in page:
+                break
+            cursor = page["cursor"]
+        assert all(u["txid"] == many_txid for u in paged_utxos)
+        assert_equal(sorted(u["outputIndex"] for u in paged_utxos), list(range(300)))
+
         # Check mempool indexing
         self.log.info("Testing mempool indexing...")
 